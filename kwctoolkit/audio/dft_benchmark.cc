@@ -0,0 +1,43 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "kwctoolkit/audio/dft.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// Sum of two sines, |size| samples
+std::vector<float> MakeSignal(kwc::int64 size) {
+    std::vector<float> signal(static_cast<std::size_t>(size));
+    for (std::size_t idx = 0; idx < signal.size(); ++idx) {
+        signal[idx] = std::sin(0.05f * idx) + 0.5f * std::sin(0.31f * idx);
+    }
+    return signal;
+}
+}  // namespace
+
+// Items are the transformed samples
+BENCHMARK(DFTReal) {
+    const auto signal = MakeSignal(context.arg());
+    while (context.running()) {
+        auto spectrum = kwc::audio::DFT(signal);
+        kwc::utils::DoNotOptimize(spectrum);
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(DFTReal)->rangeMultiplier(4)->range(16, 1024);
+
+BENCHMARK(DFTComplex) {
+    const auto signal = MakeSignal(context.arg());
+    const std::vector<std::complex<float>> input(signal.begin(), signal.end());
+    while (context.running()) {
+        auto spectrum = kwc::audio::DFT(input);
+        kwc::utils::DoNotOptimize(spectrum);
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(DFTComplex)->rangeMultiplier(4)->range(16, 1024);
@@ -0,0 +1,800 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_AUDIO_FFT_H_
+#define KWCTOOLKIT_AUDIO_FFT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "kwctoolkit/audio/dft.h"
+#include "kwctoolkit/base/assert.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/macros.h"
+#include "kwctoolkit/system/aligned_alloc.h"
+#include "kwctoolkit/system/executor.h"
+#include "kwctoolkit/system/system_info.h"
+
+namespace kwc {
+namespace audio {
+namespace internal {
+
+// Largest prime factor handled by the generic butterfly. Sizes with larger
+// prime factors fall back to the O(n²) DFT
+constexpr int kMaxFftRadix = 64;
+
+// Upper bound for the number of stages, as every stage has a radix >= 2
+constexpr int kMaxFftFactors = 32;
+
+// Splits |size| into the radices of the transform stages, innermost stage
+// first. Factors of four become radix 4 stages, which leaves at most one
+// radix 2 stage for powers of two. The remainder is split into radix 2, 3, 5
+// and if need be larger prime radices. Returns false if a prime factor
+// exceeds kMaxFftRadix
+inline bool FactorizeFftSize(int size, std::vector<int>* factors) {
+    KWC_ASSERT(size >= 1);
+    factors->clear();
+    while (size % 4 == 0) {
+        factors->push_back(4);
+        size /= 4;
+    }
+    for (int radix = 2; size > 1; ++radix) {
+        if (radix * radix > size) {
+            // The remainder is prime
+            radix = size;
+        }
+        while (size % radix == 0) {
+            if (radix > kMaxFftRadix) {
+                return false;
+            }
+            factors->push_back(radix);
+            size /= radix;
+        }
+    }
+    return true;
+}
+
+// Position of input sample |index| after reordering for an in-place
+// decimation-in-time transform with the given |factors|. This is the bit
+// reversal of the radix 2 FFT generalized to mixed radices
+inline int FftDigitReversal(int index, int size, const std::vector<int>& factors) {
+    int position = 0;
+    for (auto it = factors.rbegin(); it != factors.rend(); ++it) {
+        size /= *it;
+        position += (index % *it) * size;
+        index /= *it;
+    }
+    return position;
+}
+
+// Multiplication without the NaN and infinity handling of std::complex,
+// which keeps the compiler from emitting a library call per product
+template <typename T>
+inline std::complex<T> FftMul(const std::complex<T>& lhs, const std::complex<T>& rhs) {
+    return {lhs.real() * rhs.real() - lhs.imag() * rhs.imag(),
+            lhs.real() * rhs.imag() + lhs.imag() * rhs.real()};
+}
+
+// Multiplication by -i for the forward and by i for the inverse transform
+template <bool kInverse, typename T>
+inline std::complex<T> FftRotate(const std::complex<T>& value) {
+    return kInverse ? std::complex<T>(-value.imag(), value.real())
+                    : std::complex<T>(value.imag(), -value.real());
+}
+
+// Uninitialized array of trivially destructible values allocated through
+// AlignedAlloc(), such that every table starts on its own cache line
+template <typename U>
+class FftBuffer {
+  public:
+    FftBuffer() = default;
+
+    ~FftBuffer() { system::AlignedFree(data_); }
+
+    void allocate(std::size_t count) {
+        KWC_ASSERT(data_ == nullptr);
+        data_ = static_cast<U*>(
+            system::AlignedAlloc(static_cast<std::ptrdiff_t>(std::max<std::size_t>(count, 1) *
+                                                             sizeof(U))));
+        if (data_ == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+
+    U* get() const { return data_; }
+
+  private:
+    U* data_ = nullptr;
+
+    DISALLOW_COPY_AND_ASSIGN(FftBuffer);
+};
+
+// Applies |butterfly| to every index k in [0, m) of every block of
+// |radix| * m values. Keeping the radix dispatch out of this loop lets the
+// compiler inline and schedule every butterfly on its own
+template <typename T, typename Butterfly>
+inline void FftStage(int size, int m, int radix, std::complex<T>* data, Butterfly butterfly) {
+    const int length = m * radix;
+    for (int block = 0; block < size; block += length) {
+        std::complex<T>* x = data + block;
+        for (int k = 0; k < m; ++k) {
+            butterfly(x, k);
+        }
+    }
+}
+
+// Runs all butterfly stages on digit-reversed |data|. A stage of radix p
+// combines p interleaved transforms of length m into one of length p * m:
+//
+//     X[k + q * m] = sum_j (W_pm^(j * k) * Y_j[k]) * W_p^(j * q)
+template <bool kInverse, typename T>
+void FftStages(const int size,
+               const int* factors,
+               const int num_factors,
+               const std::complex<T>* twiddles,
+               std::complex<T>* data) {
+    const auto twiddle = [twiddles](int index) {
+        return kInverse ? std::conj(twiddles[index]) : twiddles[index];
+    };
+
+    int m = 1;
+    for (int stage = 0; stage < num_factors; ++stage) {
+        const int radix = factors[stage];
+        // W_(radix * m)^x = W_size^(x * stride)
+        const int stride = size / (m * radix);
+
+        switch (radix) {
+            case 2:
+                FftStage(size, m, radix, data, [&](std::complex<T>* x, int k) {
+                    const auto a = x[k];
+                    const auto b = FftMul(x[k + m], twiddle(k * stride));
+                    x[k] = a + b;
+                    x[k + m] = a - b;
+                });
+                break;
+            case 3:
+                FftStage(size, m, radix, data, [&](std::complex<T>* x, int k) {
+                    constexpr T kSin60 = static_cast<T>(0.86602540378443864676);
+                    const auto a = x[k];
+                    const auto b = FftMul(x[k + m], twiddle(k * stride));
+                    const auto c = FftMul(x[k + 2 * m], twiddle(2 * k * stride));
+                    const auto sum = b + c;
+                    const auto mid = a - sum * static_cast<T>(0.5);
+                    const auto rot = FftRotate<kInverse>(b - c) * kSin60;
+                    x[k] = a + sum;
+                    x[k + m] = mid + rot;
+                    x[k + 2 * m] = mid - rot;
+                });
+                break;
+            case 4:
+                FftStage(size, m, radix, data, [&](std::complex<T>* x, int k) {
+                    const auto a = x[k];
+                    const auto b = FftMul(x[k + m], twiddle(k * stride));
+                    const auto c = FftMul(x[k + 2 * m], twiddle(2 * k * stride));
+                    const auto d = FftMul(x[k + 3 * m], twiddle(3 * k * stride));
+                    const auto s0 = a + c;
+                    const auto s1 = a - c;
+                    const auto s2 = b + d;
+                    const auto s3 = FftRotate<kInverse>(b - d);
+                    x[k] = s0 + s2;
+                    x[k + m] = s1 + s3;
+                    x[k + 2 * m] = s0 - s2;
+                    x[k + 3 * m] = s1 - s3;
+                });
+                break;
+            case 5:
+                FftStage(size, m, radix, data, [&](std::complex<T>* x, int k) {
+                    constexpr T kCos72 = static_cast<T>(0.30901699437494742410);
+                    constexpr T kCos144 = static_cast<T>(-0.80901699437494742410);
+                    constexpr T kSin72 = static_cast<T>(0.95105651629515357212);
+                    constexpr T kSin144 = static_cast<T>(0.58778525229247312917);
+                    const auto a = x[k];
+                    const auto b = FftMul(x[k + m], twiddle(k * stride));
+                    const auto c = FftMul(x[k + 2 * m], twiddle(2 * k * stride));
+                    const auto d = FftMul(x[k + 3 * m], twiddle(3 * k * stride));
+                    const auto e = FftMul(x[k + 4 * m], twiddle(4 * k * stride));
+                    const auto t1 = b + e;
+                    const auto t2 = c + d;
+                    const auto t3 = b - e;
+                    const auto t4 = c - d;
+                    const auto b1 = a + t1 * kCos72 + t2 * kCos144;
+                    const auto b2 = a + t1 * kCos144 + t2 * kCos72;
+                    const auto d1 = FftRotate<kInverse>(t3 * kSin72 + t4 * kSin144);
+                    const auto d2 = FftRotate<kInverse>(t3 * kSin144 - t4 * kSin72);
+                    x[k] = a + t1 + t2;
+                    x[k + m] = b1 + d1;
+                    x[k + 2 * m] = b2 + d2;
+                    x[k + 3 * m] = b2 - d2;
+                    x[k + 4 * m] = b1 - d1;
+                });
+                break;
+            default:
+                FftStage(size, m, radix, data, [&](std::complex<T>* x, int k) {
+                    // Generic O(radix²) butterfly for larger primes,
+                    // W_radix^r = W_size^(r * size / radix)
+                    std::complex<T> t[kMaxFftRadix];
+                    for (int j = 0; j < radix; ++j) {
+                        t[j] = FftMul(x[k + j * m], twiddle(j * k * stride));
+                    }
+                    const int root_stride = size / radix;
+                    for (int q = 0; q < radix; ++q) {
+                        std::complex<T> sum = t[0];
+                        for (int j = 1; j < radix; ++j) {
+                            sum += FftMul(t[j], twiddle((j * q % radix) * root_stride));
+                        }
+                        x[k + q * m] = sum;
+                    }
+                });
+                break;
+        }
+        m *= radix;
+    }
+}
+
+// Process-wide cache behind FftPlan<T>::get() and RealFftPlan<T>::get(),
+// holding one |Plan| per size
+template <typename Plan>
+const Plan& GetCachedFftPlan(int size) {
+    // Leaked on purpose, such that plans stay valid during static destruction
+    static auto* mutex = new std::mutex();
+    static auto* plans = new std::unordered_map<int, std::unique_ptr<Plan>>();
+
+    std::lock_guard<std::mutex> guard(*mutex);
+    auto& plan = (*plans)[size];
+    if (plan == nullptr) {
+        plan.reset(new Plan(size));
+    }
+    return *plan;
+}
+
+// Number of values a task of a batch transforms at least, such that
+// scheduling a task costs little compared to its transforms
+constexpr int kFftBatchTaskSize = 1 << 14;
+
+// Calls |transform(first, last)| for consecutive ranges of frames covering
+// [0, num_frames). Tasks on |executor| and the calling thread take the ranges
+// from a shared counter and the call returns once all tasks have finished.
+// Which thread transforms which frame doesn't change any result. Like
+// ThreadPoolExecutor::drain(), this must not be called from a task running
+// on |executor|
+template <typename Function>
+void RunFftBatch(int num_frames, int frame_size, system::Executor* executor,
+                 const Function& transform) {
+    const int frames_per_range = std::max(1, kFftBatchTaskSize / std::max(1, frame_size));
+    const int num_ranges = (num_frames + frames_per_range - 1) / frames_per_range;
+    if (executor == nullptr || num_ranges < 2) {
+        transform(0, num_frames);
+        return;
+    }
+
+    struct BatchState {
+        std::atomic<int> next_range{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+        int num_running = 0;
+    } state;
+    const auto run_ranges = [&state, &transform, num_frames, num_ranges, frames_per_range] {
+        for (int range = state.next_range.fetch_add(1); range < num_ranges;
+             range = state.next_range.fetch_add(1)) {
+            const int first = range * frames_per_range;
+            transform(first, std::min(num_frames, first + frames_per_range));
+        }
+    };
+
+    static const int num_cpus = system::SystemInfo::getNumberOfCPUs();
+    const int num_tasks = std::min(num_ranges - 1, num_cpus);
+    state.num_running = num_tasks;
+    for (int task = 0; task < num_tasks; ++task) {
+        executor->add([&state, &run_ranges] {
+            run_ranges();
+            std::lock_guard<std::mutex> guard(state.mutex);
+            if (--state.num_running == 0) {
+                state.finished.notify_one();
+            }
+        });
+    }
+    run_ranges();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.finished.wait(lock, [&state] { return state.num_running == 0; });
+}
+
+}  // namespace internal
+
+enum class FftDirection { Forward, Inverse };
+
+// Precomputed transform of a fixed size
+//
+// A plan owns the twiddle factors and the digit reversal permutation for
+// its size, each in a cache line aligned table from AlignedAlloc(). Building
+// a plan costs O(n) trigonometric calls, executing it neither computes any
+// twiddles nor allocates memory. A plan is immutable after construction,
+// hence several threads may execute the same plan concurrently.
+//
+// Sizes which are powers of two are handled by radix 4 and radix 2 stages,
+// other sizes are factored into radix 2, 3, 4 and 5 stages (mixed radix).
+// Sizes with prime factors up to internal::kMaxFftRadix use a generic
+// butterfly. Anything else falls back to DFT(), which is neither fast nor
+// free of allocations, see isFast().
+//
+// Example:
+//
+//     const auto& plan = FftPlan<float>::get(frame_size);
+//     for (auto* frame : frames) {
+//         plan.executeInPlace(frame);
+//     }
+//
+// Like DFTInverse(), the inverse transform is not normalized, i.e. the
+// inverse of the forward transform yields the input scaled by n.
+template <typename T>
+class FftPlan {
+  public:
+    explicit FftPlan(int size);
+
+    int size() const { return size_; }
+
+    bool isFast() const { return fast_; }
+
+    // Transforms size() values from |input| to |output|
+    void execute(const std::complex<T>* input,
+                 std::complex<T>* output,
+                 FftDirection direction = FftDirection::Forward) const;
+
+    // Overwrites size() values at |data| with their transform
+    void executeInPlace(std::complex<T>* data,
+                        FftDirection direction = FftDirection::Forward) const;
+
+    // Transforms |num_frames| frames of size() values, stored one after
+    // another at |input|, to the frames at |output|, which may be the same
+    // buffer. The frames are distributed across |executor| and the calling
+    // thread, and the results are bitwise identical to calling execute() for
+    // every frame. A null |executor| transforms all frames on the calling
+    // thread
+    void executeBatch(const std::complex<T>* input,
+                      std::complex<T>* output,
+                      int num_frames,
+                      system::Executor* executor,
+                      FftDirection direction = FftDirection::Forward) const;
+
+    // Process-wide cache of plans, one per size and type. Plans are created
+    // on first use and live until the process exits. Looking up a plan takes
+    // a lock, so hot loops should hold on to the returned reference
+    static const FftPlan<T>& get(int size);
+
+  private:
+    void executeDFT(const std::complex<T>* input,
+                    std::complex<T>* output,
+                    FftDirection direction) const;
+
+    void runStages(std::complex<T>* data, FftDirection direction) const {
+        if (direction == FftDirection::Forward) {
+            internal::FftStages<false>(size_, factors_, num_factors_, twiddles_.get(), data);
+        } else {
+            internal::FftStages<true>(size_, factors_, num_factors_, twiddles_.get(), data);
+        }
+    }
+
+    const int size_;
+    bool fast_ = false;
+    int num_factors_ = 0;
+    int factors_[internal::kMaxFftFactors];
+    // W_n^k = exp(-2 pi i k / n) for k in [0, n)
+    internal::FftBuffer<std::complex<T>> twiddles_;
+    // Digit reversed position of every input index
+    internal::FftBuffer<int> permutation_;
+    // Pairs of indices whose swapping applies |permutation_| in place
+    internal::FftBuffer<int> swaps_;
+    int num_swaps_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(FftPlan);
+};
+
+template <typename T>
+FftPlan<T>::FftPlan(int size) : size_(size) {
+    KWC_ASSERT(size >= 0);
+    std::vector<int> factors;
+    fast_ = size < 2 || internal::FactorizeFftSize(size, &factors);
+    if (size < 2 || !fast_) {
+        return;
+    }
+    num_factors_ = static_cast<int>(factors.size());
+    std::copy(factors.begin(), factors.end(), factors_);
+
+    // Twiddles are computed in double precision regardless of T
+    twiddles_.allocate(size);
+    for (int k = 0; k < size; ++k) {
+        const double angle = -2.0 * M_PI * k / size;
+        new (twiddles_.get() + k) std::complex<T>(static_cast<T>(std::cos(angle)),
+                                                  static_cast<T>(std::sin(angle)));
+    }
+
+    permutation_.allocate(size);
+    for (int idx = 0; idx < size; ++idx) {
+        permutation_.get()[idx] = internal::FftDigitReversal(idx, size, factors);
+    }
+
+    // Every cycle (c0 c1 ... cL) of the permutation results in the swaps
+    // (c0, c1), (c0, c2) up to (c0, cL)
+    std::vector<int> swaps;
+    std::vector<bool> visited(size, false);
+    for (int start = 0; start < size; ++start) {
+        if (visited[start]) {
+            continue;
+        }
+        visited[start] = true;
+        for (int next = permutation_.get()[start]; next != start;
+             next = permutation_.get()[next]) {
+            visited[next] = true;
+            swaps.push_back(start);
+            swaps.push_back(next);
+        }
+    }
+    num_swaps_ = static_cast<int>(swaps.size() / 2);
+    swaps_.allocate(swaps.size());
+    std::copy(swaps.begin(), swaps.end(), swaps_.get());
+}
+
+template <typename T>
+void FftPlan<T>::execute(const std::complex<T>* input,
+                         std::complex<T>* output,
+                         FftDirection direction) const {
+    if (input == output) {
+        executeInPlace(output, direction);
+        return;
+    }
+    if (size_ < 2) {
+        std::copy(input, input + size_, output);
+        return;
+    }
+    if (!fast_) {
+        executeDFT(input, output, direction);
+        return;
+    }
+
+    const int* permutation = permutation_.get();
+    for (int idx = 0; idx < size_; ++idx) {
+        output[permutation[idx]] = input[idx];
+    }
+    runStages(output, direction);
+}
+
+template <typename T>
+void FftPlan<T>::executeInPlace(std::complex<T>* data, FftDirection direction) const {
+    if (size_ < 2) {
+        return;
+    }
+    if (!fast_) {
+        executeDFT(data, data, direction);
+        return;
+    }
+
+    const int* swaps = swaps_.get();
+    for (int idx = 0; idx < num_swaps_; ++idx) {
+        std::swap(data[swaps[2 * idx]], data[swaps[2 * idx + 1]]);
+    }
+    runStages(data, direction);
+}
+
+template <typename T>
+void FftPlan<T>::executeBatch(const std::complex<T>* input,
+                              std::complex<T>* output,
+                              int num_frames,
+                              system::Executor* executor,
+                              FftDirection direction) const {
+    KWC_ASSERT(num_frames >= 0);
+    internal::RunFftBatch(num_frames, size_, executor, [=](int first, int last) {
+        for (int frame = first; frame < last; ++frame) {
+            const int64 offset = int64{frame} * size_;
+            execute(input + offset, output + offset, direction);
+        }
+    });
+}
+
+template <typename T>
+void FftPlan<T>::executeDFT(const std::complex<T>* input,
+                            std::complex<T>* output,
+                            FftDirection direction) const {
+    const std::vector<std::complex<T>> values(input, input + size_);
+    const auto result = direction == FftDirection::Forward ? DFT(values) : DFTInverse(values);
+    std::copy(result.begin(), result.end(), output);
+}
+
+template <typename T>
+const FftPlan<T>& FftPlan<T>::get(int size) {
+    return internal::GetCachedFftPlan<FftPlan<T>>(size);
+}
+
+// Transform of real valued input of a fixed size
+//
+// The spectrum of real input is Hermitian, X[n - k] = conj(X[k]), hence only
+// the numBins() = n / 2 + 1 bins from DC up to Nyquist are computed. For an
+// even size n the input is read as n / 2 complex values, even samples being
+// the real and odd samples the imaginary part, and transformed by the
+// FftPlan of size n / 2. One O(n) pass over the bins then separates the
+// spectra of the even and odd samples and combines them into the spectrum
+// of the whole input. This takes about half the work and half the memory of
+// a complex transform of size n.
+//
+// The inverse takes numBins() bins and writes n real samples, again via the
+// FftPlan of size n / 2. Like FFTInverse() it is not normalized, i.e. it
+// yields the input of the forward transform scaled by n. The imaginary parts
+// of the DC and Nyquist bins are ignored.
+//
+// Odd sizes are supported by a complex transform of size n into a temporary
+// buffer, which is neither fast nor free of allocations, see isFast(). Like
+// FftPlan, a plan is immutable and may be executed by several threads.
+//
+// Example:
+//
+//     const auto& plan = RealFftPlan<float>::get(frame_size);
+//     std::vector<std::complex<float>> bins(plan.numBins());
+//     plan.forward(frame, bins.data());
+template <typename T>
+class RealFftPlan {
+  public:
+    explicit RealFftPlan(int size);
+
+    int size() const { return size_; }
+
+    int numBins() const { return size_ / 2 + 1; }
+
+    bool isFast() const { return half_plan_ != nullptr && half_plan_->isFast(); }
+
+    // Transforms size() samples from |input| into numBins() bins at |output|.
+    // For even sizes |output| may also point to |input|, provided the buffer
+    // has room for size() + 2 samples
+    void forward(const T* input, std::complex<T>* output) const;
+
+    // Transforms numBins() bins from |input| into size() samples at |output|
+    void inverse(const std::complex<T>* input, T* output) const;
+
+    // Batch versions of forward() and inverse() for |num_frames| frames
+    // stored one after another, i.e. size() samples and numBins() bins apart.
+    // See FftPlan::executeBatch(), except that |input| and |output| must not
+    // overlap
+    void forwardBatch(const T* input,
+                      std::complex<T>* output,
+                      int num_frames,
+                      system::Executor* executor) const;
+    void inverseBatch(const std::complex<T>* input,
+                      T* output,
+                      int num_frames,
+                      system::Executor* executor) const;
+
+    // Process-wide cache of plans, see FftPlan<T>::get()
+    static const RealFftPlan<T>& get(int size);
+
+  private:
+    void forwardComplex(const T* input, std::complex<T>* output) const;
+    void inverseComplex(const std::complex<T>* input, T* output) const;
+
+    const int size_;
+    // Plan of size n / 2 for even sizes, otherwise null
+    const FftPlan<T>* half_plan_ = nullptr;
+    // W_n^k for k in [0, n / 4]
+    internal::FftBuffer<std::complex<T>> twiddles_;
+
+    DISALLOW_COPY_AND_ASSIGN(RealFftPlan);
+};
+
+template <typename T>
+RealFftPlan<T>::RealFftPlan(int size) : size_(size) {
+    KWC_ASSERT(size >= 1);
+    if (size % 2 != 0) {
+        return;
+    }
+    const int half = size / 2;
+    half_plan_ = &FftPlan<T>::get(half);
+
+    const int num_twiddles = half / 2 + 1;
+    twiddles_.allocate(num_twiddles);
+    for (int k = 0; k < num_twiddles; ++k) {
+        const double angle = -2.0 * M_PI * k / size;
+        new (twiddles_.get() + k) std::complex<T>(static_cast<T>(std::cos(angle)),
+                                                  static_cast<T>(std::sin(angle)));
+    }
+}
+
+template <typename T>
+void RealFftPlan<T>::forward(const T* input, std::complex<T>* output) const {
+    if (half_plan_ == nullptr) {
+        forwardComplex(input, output);
+        return;
+    }
+
+    // z[t] = x[2t] + i x[2t + 1], Z = FFT(z)
+    const int half = size_ / 2;
+    auto* packed = reinterpret_cast<T*>(output);
+    if (packed != input) {
+        std::copy(input, input + size_, packed);
+    }
+    half_plan_->executeInPlace(output);
+
+    // With E and O the spectra of the even and odd samples, both periodic in
+    // n / 2 and Hermitian:
+    //
+    //     E[k] = (Z[k] + conj(Z[n/2 - k])) / 2
+    //     O[k] = (Z[k] - conj(Z[n/2 - k])) / 2i
+    //     X[k] = E[k] + W_n^k O[k]
+    //
+    // Bins k and n/2 - k depend on the same two values and are updated as a
+    // pair, using W_n^(n/2 - k) = -conj(W_n^k)
+    const std::complex<T> z0 = output[0];
+    output[0] = std::complex<T>(z0.real() + z0.imag(), 0);
+    output[half] = std::complex<T>(z0.real() - z0.imag(), 0);
+
+    const std::complex<T>* twiddles = twiddles_.get();
+    const T kHalf = static_cast<T>(0.5);
+    for (int k = 1; k <= half / 2; ++k) {
+        const std::complex<T> a = output[k];
+        const std::complex<T> b = output[half - k];
+        const std::complex<T> even = (a + std::conj(b)) * kHalf;
+        const std::complex<T> odd = (a - std::conj(b)) * kHalf;
+        // W_n^k * odd / i, computed as a rotation by -90 degrees
+        const std::complex<T> rotated = internal::FftMul(odd, twiddles[k]);
+        output[k] = even + std::complex<T>(rotated.imag(), -rotated.real());
+        output[half - k] = std::conj(even - std::complex<T>(rotated.imag(), -rotated.real()));
+    }
+}
+
+template <typename T>
+void RealFftPlan<T>::inverse(const std::complex<T>* input, T* output) const {
+    if (half_plan_ == nullptr) {
+        inverseComplex(input, output);
+        return;
+    }
+
+    // Reverts the pass of forward() into Z[k] = 2 (E[k] + i O[k]), leaving
+    // the scaling by n to the unnormalized inverse of size n / 2
+    const int half = size_ / 2;
+    auto* packed = reinterpret_cast<std::complex<T>*>(output);
+    const T x0 = input[0].real();
+    const T xh = input[half].real();
+    packed[0] = std::complex<T>(x0 + xh, x0 - xh);
+
+    const std::complex<T>* twiddles = twiddles_.get();
+    for (int k = 1; k <= half / 2; ++k) {
+        const std::complex<T> a = input[k];
+        const std::complex<T> b = input[half - k];
+        const std::complex<T> even = a + std::conj(b);
+        // i * conj(W_n^k) * (X[k] - conj(X[n/2 - k]))
+        const std::complex<T> rotated = internal::FftMul(a - std::conj(b), std::conj(twiddles[k]));
+        const std::complex<T> odd(-rotated.imag(), rotated.real());
+        packed[k] = even + odd;
+        packed[half - k] = std::conj(even - odd);
+    }
+    half_plan_->executeInPlace(packed, FftDirection::Inverse);
+}
+
+template <typename T>
+void RealFftPlan<T>::forwardBatch(const T* input,
+                                  std::complex<T>* output,
+                                  int num_frames,
+                                  system::Executor* executor) const {
+    KWC_ASSERT(num_frames >= 0);
+    internal::RunFftBatch(num_frames, size_, executor, [=](int first, int last) {
+        for (int frame = first; frame < last; ++frame) {
+            forward(input + int64{frame} * size_, output + int64{frame} * numBins());
+        }
+    });
+}
+
+template <typename T>
+void RealFftPlan<T>::inverseBatch(const std::complex<T>* input,
+                                  T* output,
+                                  int num_frames,
+                                  system::Executor* executor) const {
+    KWC_ASSERT(num_frames >= 0);
+    internal::RunFftBatch(num_frames, size_, executor, [=](int first, int last) {
+        for (int frame = first; frame < last; ++frame) {
+            inverse(input + int64{frame} * numBins(), output + int64{frame} * size_);
+        }
+    });
+}
+
+template <typename T>
+void RealFftPlan<T>::forwardComplex(const T* input, std::complex<T>* output) const {
+    std::vector<std::complex<T>> data(input, input + size_);
+    FftPlan<T>::get(size_).executeInPlace(data.data());
+    std::copy(data.begin(), data.begin() + numBins(), output);
+}
+
+template <typename T>
+void RealFftPlan<T>::inverseComplex(const std::complex<T>* input, T* output) const {
+    std::vector<std::complex<T>> data(size_);
+    for (int k = 0; k < numBins(); ++k) {
+        data[k] = input[k];
+        if (k > 0) {
+            data[size_ - k] = std::conj(input[k]);
+        }
+    }
+    data[0].imag(0);
+    FftPlan<T>::get(size_).executeInPlace(data.data(), FftDirection::Inverse);
+    for (int idx = 0; idx < size_; ++idx) {
+        output[idx] = data[idx].real();
+    }
+}
+
+template <typename T>
+const RealFftPlan<T>& RealFftPlan<T>::get(int size) {
+    return internal::GetCachedFftPlan<RealFftPlan<T>>(size);
+}
+
+// Fast Fourier transform with the same results as DFT() in O(n log n),
+// using the cached FftPlan of the input size
+template <typename T>
+std::vector<std::complex<T>> FFT(const std::vector<std::complex<T>>& input) {
+    std::vector<std::complex<T>> output(input.size());
+    FftPlan<T>::get(static_cast<int>(input.size())).execute(input.data(), output.data());
+    return output;
+}
+
+template <typename T>
+std::vector<std::complex<T>> FFT(const std::vector<T>& input) {
+    std::vector<std::complex<T>> data(input.begin(), input.end());
+    FftPlan<T>::get(static_cast<int>(data.size())).executeInPlace(data.data());
+    return data;
+}
+
+template <typename T>
+std::vector<std::complex<T>> FFTInverse(const std::vector<std::complex<T>>& input) {
+    std::vector<std::complex<T>> output(input.size());
+    FftPlan<T>::get(static_cast<int>(input.size()))
+        .execute(input.data(), output.data(), FftDirection::Inverse);
+    return output;
+}
+
+template <typename T>
+std::vector<std::complex<T>> FFTInverse(const std::vector<T>& input) {
+    std::vector<std::complex<T>> data(input.begin(), input.end());
+    FftPlan<T>::get(static_cast<int>(data.size()))
+        .executeInPlace(data.data(), FftDirection::Inverse);
+    return data;
+}
+
+// In-place variants overwriting |size| values at |data| with the transform
+template <typename T>
+void FFTInPlace(std::complex<T>* data, int size) {
+    FftPlan<T>::get(size).executeInPlace(data);
+}
+
+template <typename T>
+void FFTInverseInPlace(std::complex<T>* data, int size) {
+    FftPlan<T>::get(size).executeInPlace(data, FftDirection::Inverse);
+}
+
+// Real-to-complex transform returning the size / 2 + 1 bins from DC up to
+// Nyquist, the remaining bins follow as X[n - k] = conj(X[k])
+template <typename T>
+std::vector<std::complex<T>> RealFFT(const std::vector<T>& input) {
+    const auto& plan = RealFftPlan<T>::get(static_cast<int>(input.size()));
+    std::vector<std::complex<T>> output(plan.numBins());
+    plan.forward(input.data(), output.data());
+    return output;
+}
+
+// Complex-to-real inverse of RealFFT(), yielding |size| samples scaled by
+// |size|. As |size| / 2 + 1 bins are the same for an even size and the next
+// odd one, the size has to be given
+template <typename T>
+std::vector<T> RealFFTInverse(const std::vector<std::complex<T>>& input, int size) {
+    const auto& plan = RealFftPlan<T>::get(size);
+    KWC_ASSERT(static_cast<int>(input.size()) == plan.numBins());
+    std::vector<T> output(size);
+    plan.inverse(input.data(), output.data());
+    return output;
+}
+
+}  // namespace audio
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_AUDIO_FFT_H_
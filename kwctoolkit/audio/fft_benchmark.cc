@@ -0,0 +1,117 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include "kwctoolkit/audio/fft.h"
+#include "kwctoolkit/system/thread_pool_executor.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+std::vector<std::complex<float>> MakeSignal(kwc::int64 size) {
+    std::vector<std::complex<float>> signal(static_cast<std::size_t>(size));
+    for (std::size_t idx = 0; idx < signal.size(); ++idx) {
+        signal[idx] = std::sin(0.05f * idx) + 0.5f * std::sin(0.31f * idx);
+    }
+    return signal;
+}
+}  // namespace
+
+// Items are the transformed samples, compare with DFTComplex
+BENCHMARK(FFTComplex) {
+    const auto signal = MakeSignal(context.arg());
+    while (context.running()) {
+        auto spectrum = kwc::audio::FFT(signal);
+        kwc::utils::DoNotOptimize(spectrum);
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(FFTComplex)->rangeMultiplier(4)->range(16, 1 << 16);
+
+BENCHMARK(FFTInPlace) {
+    auto data = MakeSignal(context.arg());
+    while (context.running()) {
+        kwc::audio::FFTInPlace(data.data(), static_cast<int>(data.size()));
+        kwc::utils::DoNotOptimize(data.data());
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(FFTInPlace)->rangeMultiplier(4)->range(16, 1 << 16);
+
+// Common frame sizes which are not powers of two
+BENCHMARK(FFTMixedRadix) {
+    const auto signal = MakeSignal(context.arg());
+    while (context.running()) {
+        auto spectrum = kwc::audio::FFT(signal);
+        kwc::utils::DoNotOptimize(spectrum);
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(FFTMixedRadix)->arg(240)->arg(480)->arg(960)->arg(1000)->arg(4800)->arg(44100);
+
+// Executing a plan held by the caller, without the cache lookup and the
+// allocation of the output of FFT()
+BENCHMARK(FftPlanExecute) {
+    const kwc::audio::FftPlan<float> plan(static_cast<int>(context.arg()));
+    const auto signal = MakeSignal(context.arg());
+    std::vector<std::complex<float>> output(signal.size());
+    while (context.running()) {
+        plan.execute(signal.data(), output.data());
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(FftPlanExecute)->rangeMultiplier(4)->range(16, 1 << 16);
+
+// Real input of the same sizes as FFTComplex, which yields only the bins up
+// to Nyquist
+BENCHMARK(RealFftPlanForward) {
+    const auto& plan = kwc::audio::RealFftPlan<float>::get(static_cast<int>(context.arg()));
+    std::vector<float> signal;
+    for (const auto& value : MakeSignal(context.arg())) {
+        signal.push_back(value.real());
+    }
+    std::vector<std::complex<float>> bins(static_cast<std::size_t>(plan.numBins()));
+    while (context.running()) {
+        plan.forward(signal.data(), bins.data());
+        kwc::utils::DoNotOptimize(bins.data());
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(RealFftPlanForward)->rangeMultiplier(4)->range(16, 1 << 16);
+
+BENCHMARK(RealFftPlanInverse) {
+    const auto& plan = kwc::audio::RealFftPlan<float>::get(static_cast<int>(context.arg()));
+    const std::vector<std::complex<float>> bins(static_cast<std::size_t>(plan.numBins()), 1.0f);
+    std::vector<float> output(static_cast<std::size_t>(context.arg()));
+    while (context.running()) {
+        plan.inverse(bins.data(), output.data());
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(RealFftPlanInverse)->rangeMultiplier(4)->range(16, 1 << 16);
+
+// 256 frames of 1024 values, transformed on the calling thread only or
+// distributed across a pool of the argument's number of threads
+BENCHMARK(FftPlanExecuteBatch) {
+    const int size = 1024;
+    const int num_frames = 256;
+    const auto& plan = kwc::audio::FftPlan<float>::get(size);
+    const auto signal = MakeSignal(size * num_frames);
+    std::vector<std::complex<float>> output(signal.size());
+    std::unique_ptr<kwc::system::ThreadPoolExecutor> executor;
+    if (context.arg() > 0) {
+        executor.reset(new kwc::system::ThreadPoolExecutor(static_cast<int>(context.arg())));
+    }
+    while (context.running()) {
+        plan.executeBatch(signal.data(), output.data(), num_frames, executor.get());
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setItemsProcessed(context.iterations() * size * num_frames);
+}
+BENCHMARK_CONFIGURE(FftPlanExecuteBatch)->arg(0)->arg(1)->arg(2)->arg(4)->arg(8);
@@ -0,0 +1,337 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/audio/fft.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "kwctoolkit/audio/dft.h"
+#include "kwctoolkit/system/thread_pool_executor.h"
+
+using namespace kwc::audio;
+
+namespace {
+template <typename T>
+std::vector<std::complex<T>> MakeSignal(int size) {
+    std::vector<std::complex<T>> signal(size);
+    for (int idx = 0; idx < size; ++idx) {
+        signal[idx] = {static_cast<T>(std::sin(0.3 * idx) + 0.25 * std::cos(1.7 * idx)),
+                       static_cast<T>(std::cos(0.11 * idx * idx))};
+    }
+    return signal;
+}
+
+template <typename T>
+void ExpectNear(const std::vector<std::complex<T>>& expected,
+                const std::vector<std::complex<T>>& actual,
+                double tolerance) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t idx = 0; idx < expected.size(); ++idx) {
+        EXPECT_NEAR(expected[idx].real(), actual[idx].real(), tolerance) << "at " << idx;
+        EXPECT_NEAR(expected[idx].imag(), actual[idx].imag(), tolerance) << "at " << idx;
+    }
+}
+
+// Powers of two, mixed radix sizes, sizes with a prime factor handled by the
+// generic butterfly and one falling back to the DFT
+const int kSizes[] = {1, 2, 3, 4, 5, 6, 7, 8, 12, 15, 16, 30, 49, 60, 64, 100, 128, 243, 256, 480,
+                      1000, 1024, 2 * 67};
+}  // namespace
+
+TEST(FFTTest, FactorizesIntoSupportedRadices) {
+    std::vector<int> factors;
+    EXPECT_TRUE(internal::FactorizeFftSize(1024, &factors));
+    EXPECT_EQ(factors, std::vector<int>({4, 4, 4, 4, 4}));
+    EXPECT_TRUE(internal::FactorizeFftSize(512, &factors));
+    EXPECT_EQ(factors, std::vector<int>({4, 4, 4, 4, 2}));
+    EXPECT_TRUE(internal::FactorizeFftSize(480, &factors));
+    EXPECT_EQ(factors, std::vector<int>({4, 4, 2, 3, 5}));
+    EXPECT_TRUE(internal::FactorizeFftSize(7 * 7 * 3, &factors));
+    EXPECT_EQ(factors, std::vector<int>({3, 7, 7}));
+    EXPECT_FALSE(internal::FactorizeFftSize(2 * 67, &factors));
+}
+
+TEST(FFTTest, DigitReversalOfPowersOfTwoIsBitReversal) {
+    const std::vector<int> factors = {2, 2, 2};
+    const int expected[] = {0, 4, 2, 6, 1, 5, 3, 7};
+    for (int idx = 0; idx < 8; ++idx) {
+        EXPECT_EQ(internal::FftDigitReversal(idx, 8, factors), expected[idx]);
+    }
+}
+
+TEST(FFTTest, MatchesDFT) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const auto signal = MakeSignal<double>(size);
+        ExpectNear(DFT(signal), FFT(signal), 1e-9 * size);
+        ExpectNear(DFTInverse(signal), FFTInverse(signal), 1e-9 * size);
+    }
+}
+
+TEST(FFTTest, MatchesDFTInSinglePrecision) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const auto signal = MakeSignal<float>(size);
+        ExpectNear(DFT(signal), FFT(signal), 1e-4 * size);
+    }
+}
+
+TEST(FFTTest, RealInputMatchesDFT) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        std::vector<double> signal;
+        for (const auto& value : MakeSignal<double>(size)) {
+            signal.push_back(value.real());
+        }
+        ExpectNear(DFT(signal), FFT(signal), 1e-9 * size);
+        ExpectNear(DFTInverse(signal), FFTInverse(signal), 1e-9 * size);
+    }
+}
+
+TEST(FFTTest, InverseRestoresScaledInput) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const auto signal = MakeSignal<double>(size);
+        auto restored = FFTInverse(FFT(signal));
+        for (auto& value : restored) {
+            value /= static_cast<double>(size);
+        }
+        ExpectNear(signal, restored, 1e-12 * size);
+    }
+}
+
+TEST(FFTTest, InPlaceMatchesOutOfPlace) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const auto signal = MakeSignal<double>(size);
+        auto data = signal;
+        FFTInPlace(data.data(), size);
+        ExpectNear(FFT(signal), data, 1e-12 * size);
+
+        data = signal;
+        FFTInverseInPlace(data.data(), size);
+        ExpectNear(FFTInverse(signal), data, 1e-12 * size);
+    }
+}
+
+TEST(FFTTest, DetectsSinglePeak) {
+    const int size = 960;
+    const int bin = 37;
+    std::vector<float> signal(size);
+    for (int idx = 0; idx < size; ++idx) {
+        signal[idx] = static_cast<float>(std::cos(2.0 * M_PI * bin * idx / size));
+    }
+    const auto spectrum = FFT(signal);
+    for (int k = 0; k < size; ++k) {
+        const float expected = (k == bin || k == size - bin) ? size / 2.0f : 0.0f;
+        EXPECT_NEAR(std::abs(spectrum[k]), expected, 1e-2f) << "at " << k;
+    }
+}
+
+TEST(FftPlanTest, CachesOnePlanPerSizeAndType) {
+    const auto& plan = FftPlan<float>::get(480);
+    EXPECT_EQ(&plan, &FftPlan<float>::get(480));
+    EXPECT_NE(static_cast<const void*>(&plan),
+              static_cast<const void*>(&FftPlan<double>::get(480)));
+    EXPECT_NE(&plan, &FftPlan<float>::get(960));
+    EXPECT_EQ(plan.size(), 480);
+    EXPECT_TRUE(plan.isFast());
+    EXPECT_FALSE(FftPlan<float>::get(2 * 67).isFast());
+}
+
+TEST(FftPlanTest, ExecutesOutOfPlaceAndInPlace) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const FftPlan<double> plan(size);
+        const auto signal = MakeSignal<double>(size);
+        const auto expected = DFT(signal);
+
+        std::vector<std::complex<double>> output(size);
+        plan.execute(signal.data(), output.data());
+        ExpectNear(expected, output, 1e-9 * size);
+
+        // Aliasing input and output is the same as running in place
+        output = signal;
+        plan.execute(output.data(), output.data());
+        ExpectNear(expected, output, 1e-9 * size);
+
+        plan.executeInPlace(output.data(), FftDirection::Inverse);
+        for (auto& value : output) {
+            value /= static_cast<double>(size);
+        }
+        ExpectNear(signal, output, 1e-12 * size);
+    }
+}
+
+TEST(FftPlanTest, ExecutesConcurrently) {
+    const int size = 960;
+    const auto& plan = FftPlan<float>::get(size);
+    const auto signal = MakeSignal<float>(size);
+    std::vector<std::complex<float>> expected(size);
+    plan.execute(signal.data(), expected.data());
+
+    std::vector<std::vector<std::complex<float>>> results(4, signal);
+    std::vector<std::thread> threads;
+    for (auto& result : results) {
+        threads.emplace_back([&plan, &result] {
+            for (int repetition = 0; repetition < 50; ++repetition) {
+                plan.executeInPlace(result.data());
+                plan.executeInPlace(result.data(), FftDirection::Inverse);
+                for (auto& value : result) {
+                    value /= static_cast<float>(size);
+                }
+            }
+            plan.executeInPlace(result.data());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        ExpectNear(expected, result, 1e-2);
+    }
+}
+
+namespace {
+template <typename T>
+std::vector<T> MakeRealSignal(int size) {
+    std::vector<T> signal;
+    for (const auto& value : MakeSignal<T>(size)) {
+        signal.push_back(value.real());
+    }
+    return signal;
+}
+}  // namespace
+
+TEST(RealFFTTest, MatchesLowerHalfOfDFT) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const auto signal = MakeRealSignal<double>(size);
+        auto expected = DFT(signal);
+        expected.resize(size / 2 + 1);
+        ExpectNear(expected, RealFFT(signal), 1e-9 * size);
+    }
+}
+
+TEST(RealFFTTest, MatchesLowerHalfOfDFTInSinglePrecision) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const auto signal = MakeRealSignal<float>(size);
+        auto expected = DFT(signal);
+        expected.resize(size / 2 + 1);
+        ExpectNear(expected, RealFFT(signal), 1e-4 * size);
+    }
+}
+
+TEST(RealFFTTest, InverseRestoresScaledInput) {
+    for (const int size : kSizes) {
+        SCOPED_TRACE(size);
+        const auto signal = MakeRealSignal<double>(size);
+        const auto restored = RealFFTInverse(RealFFT(signal), size);
+        ASSERT_EQ(restored.size(), signal.size());
+        for (int idx = 0; idx < size; ++idx) {
+            EXPECT_NEAR(signal[idx], restored[idx] / size, 1e-12 * size) << "at " << idx;
+        }
+    }
+}
+
+TEST(RealFFTTest, InverseMatchesComplexInverseOfHermitianSpectrum) {
+    const int size = 480;
+    const auto bins = RealFFT(MakeRealSignal<double>(size));
+    std::vector<std::complex<double>> spectrum(size);
+    for (int k = 0; k < size; ++k) {
+        spectrum[k] = k <= size / 2 ? bins[k] : std::conj(bins[size - k]);
+    }
+    const auto expected = FFTInverse(spectrum);
+    const auto restored = RealFFTInverse(bins, size);
+    for (int idx = 0; idx < size; ++idx) {
+        EXPECT_NEAR(expected[idx].real(), restored[idx], 1e-9 * size) << "at " << idx;
+    }
+}
+
+TEST(RealFftPlanTest, TransformsInPlace) {
+    const int size = 1024;
+    const auto& plan = RealFftPlan<float>::get(size);
+    EXPECT_EQ(&plan, &RealFftPlan<float>::get(size));
+    EXPECT_EQ(plan.numBins(), size / 2 + 1);
+    EXPECT_TRUE(plan.isFast());
+    EXPECT_FALSE(RealFftPlan<float>::get(size + 1).isFast());
+
+    const auto signal = MakeRealSignal<float>(size);
+    std::vector<float> buffer(signal);
+    buffer.resize(size + 2);
+    auto* bins = reinterpret_cast<std::complex<float>*>(buffer.data());
+    plan.forward(buffer.data(), bins);
+    const std::vector<std::complex<float>> actual(bins, bins + plan.numBins());
+    ExpectNear(RealFFT(signal), actual, 1e-3);
+}
+
+namespace {
+template <typename T>
+bool BitwiseEqual(const std::vector<T>& expected, const std::vector<T>& actual) {
+    return expected.size() == actual.size() &&
+           std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(T)) == 0;
+}
+}  // namespace
+
+TEST(FftPlanTest, BatchIsBitwiseIdenticalToSingleFrames) {
+    kwc::system::ThreadPoolExecutor executor(4);
+    // The smallest sizes run as a single range of frames on the calling
+    // thread, the others are split into several ranges
+    for (const int size : {1, 30, 480, 1024, 2 * 67, 4096}) {
+        SCOPED_TRACE(size);
+        const int num_frames = 37;
+        const auto& plan = FftPlan<float>::get(size);
+        const auto input = MakeSignal<float>(size * num_frames);
+        for (const auto direction : {FftDirection::Forward, FftDirection::Inverse}) {
+            std::vector<std::complex<float>> expected(input.size());
+            for (int frame = 0; frame < num_frames; ++frame) {
+                plan.execute(&input[frame * size], &expected[frame * size], direction);
+            }
+
+            std::vector<std::complex<float>> output(input.size());
+            plan.executeBatch(input.data(), output.data(), num_frames, &executor, direction);
+            EXPECT_TRUE(BitwiseEqual(expected, output));
+
+            output = input;
+            plan.executeBatch(output.data(), output.data(), num_frames, &executor, direction);
+            EXPECT_TRUE(BitwiseEqual(expected, output));
+
+            std::fill(output.begin(), output.end(), std::complex<float>());
+            plan.executeBatch(input.data(), output.data(), num_frames, nullptr, direction);
+            EXPECT_TRUE(BitwiseEqual(expected, output));
+        }
+    }
+}
+
+TEST(RealFftPlanTest, BatchIsBitwiseIdenticalToSingleFrames) {
+    kwc::system::ThreadPoolExecutor executor(4);
+    for (const int size : {480, 1023, 4096}) {
+        SCOPED_TRACE(size);
+        const int num_frames = 23;
+        const auto& plan = RealFftPlan<double>::get(size);
+        const int num_bins = plan.numBins();
+        const auto input = MakeRealSignal<double>(size * num_frames);
+
+        std::vector<std::complex<double>> expected_bins(num_bins * num_frames);
+        std::vector<double> expected_samples(input.size());
+        for (int frame = 0; frame < num_frames; ++frame) {
+            plan.forward(&input[frame * size], &expected_bins[frame * num_bins]);
+            plan.inverse(&expected_bins[frame * num_bins], &expected_samples[frame * size]);
+        }
+
+        std::vector<std::complex<double>> bins(expected_bins.size());
+        plan.forwardBatch(input.data(), bins.data(), num_frames, &executor);
+        EXPECT_TRUE(BitwiseEqual(expected_bins, bins));
+        std::vector<double> samples(input.size());
+        plan.inverseBatch(bins.data(), samples.data(), num_frames, &executor);
+        EXPECT_TRUE(BitwiseEqual(expected_samples, samples));
+    }
+}
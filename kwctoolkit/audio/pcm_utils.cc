@@ -4,31 +4,562 @@
 
 #include "kwctoolkit/audio/pcm_utils.h"
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "kwctoolkit/base/assert.h"
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include <immintrin.h>
+
+    #include "kwctoolkit/system/cpu.h"
+#endif
+
 namespace kwc {
 namespace audio {
+namespace {
 
 constexpr float kScale16ToFloat = (1.0f / (1 << 15));
 
+// Integer sample of |kBits| bits from |sample| in [-1, 1), computed in the
+// precision of |T|. Every implementation computes (sample + 1) * 2^(N-1),
+// clamps it to [0, 2^N - 1] and truncates it before centering at zero. The
+// clamping is written as the x86 max/min instructions define it, such that
+// NaN ends up at zero as well
+template <int kBits, typename T>
+inline int32 FloatToInteger(T sample) {
+    constexpr T kOffset = static_cast<T>(int64{1} << (kBits - 1));
+    constexpr T kMax = static_cast<T>((int64{1} << kBits) - 1);
+    T fval = (sample + 1) * kOffset;
+    fval = fval > 0 ? fval : 0;
+    fval = fval < kMax ? fval : kMax;
+    // The unsigned range of 32 bit samples needs a wider type, which on the
+    // other hand prevents vectorization of all smaller formats
+    using Integer = typename std::conditional<(kBits < 32), int32, int64>::type;
+    return static_cast<int32>(static_cast<Integer>(fval) - (Integer{1} << (kBits - 1)));
+}
+
+inline int16 FloatToPCM16(float sample) {
+    return static_cast<int16>(FloatToInteger<16>(sample));
+}
+
+using FloatToPCM16Function = void (*)(const float*, int16*, int32);
+using PCM16ToFloatFunction = void (*)(const int16*, float*, int32);
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+// Vector versions of FloatToPCM16(), yielding 32 bit values. Note that
+// _mm_max_ps() returns its second operand for NaN
+KWC_TARGET_ATTRIBUTE("sse2")
+inline __m128i FloatToPCM16Sse2(__m128 samples) {
+    __m128 fval = _mm_mul_ps(_mm_add_ps(samples, _mm_set1_ps(1.0f)), _mm_set1_ps(1 << 15));
+    fval = _mm_min_ps(_mm_max_ps(fval, _mm_setzero_ps()), _mm_set1_ps((1 << 16) - 1));
+    return _mm_sub_epi32(_mm_cvttps_epi32(fval), _mm_set1_epi32(1 << 15));
+}
+
+KWC_TARGET_ATTRIBUTE("avx2")
+inline __m256i FloatToPCM16Avx2(__m256 samples) {
+    __m256 fval =
+        _mm256_mul_ps(_mm256_add_ps(samples, _mm256_set1_ps(1.0f)), _mm256_set1_ps(1 << 15));
+    fval = _mm256_min_ps(_mm256_max_ps(fval, _mm256_setzero_ps()), _mm256_set1_ps((1 << 16) - 1));
+    return _mm256_sub_epi32(_mm256_cvttps_epi32(fval), _mm256_set1_epi32(1 << 15));
+}
+
+FloatToPCM16Function SelectFloatToPCM16() {
+    const system::CPU& cpu = system::CPU::getInstance();
+    if (cpu.hasAvx2()) {
+        return internal::ConvertFloatToPCM16Avx2;
+    }
+    if (cpu.hasSse2()) {
+        return internal::ConvertFloatToPCM16Sse2;
+    }
+    return internal::ConvertFloatToPCM16Scalar;
+}
+
+PCM16ToFloatFunction SelectPCM16ToFloat() {
+    const system::CPU& cpu = system::CPU::getInstance();
+    if (cpu.hasAvx2()) {
+        return internal::ConvertPCM16ToFloatAvx2;
+    }
+    if (cpu.hasSse2()) {
+        return internal::ConvertPCM16ToFloatSse2;
+    }
+    return internal::ConvertPCM16ToFloatScalar;
+}
+#else
+FloatToPCM16Function SelectFloatToPCM16() {
+    return internal::ConvertFloatToPCM16Scalar;
+}
+
+PCM16ToFloatFunction SelectPCM16ToFloat() {
+    return internal::ConvertPCM16ToFloatScalar;
+}
+#endif
+
+// Number of samples converted at once through an intermediate block of
+// float or double samples, which stays in the L1 cache
+constexpr int kBlockSize = 256;
+
+// Largest sample size of all formats
+constexpr int kMaxSampleSize = 8;
+
+template <int kBits, typename T>
+inline T IntegerToFloat(int32 sample) {
+    constexpr T kScale = 1 / static_cast<T>(int64{1} << (kBits - 1));
+    return sample * kScale;
+}
+
+// Packed Int24 samples are unpacked into int32 first, such that the scaling
+// runs over contiguous int32 values
+void UnpackInt24(const uint8* source, int32* dest, int count) {
+    for (int idx = 0; idx < count; ++idx, source += 3) {
+        const uint32 value =
+            source[0] | (source[1] << 8) | (static_cast<uint32>(source[2]) << 16);
+        // Sign extension by moving the most significant byte into place first
+        dest[idx] = static_cast<int32>(value << 8) >> 8;
+    }
+}
+
+void PackInt24(const int32* source, uint8* dest, int count) {
+    for (int idx = 0; idx < count; ++idx, dest += 3) {
+        dest[0] = static_cast<uint8>(source[idx]);
+        dest[1] = static_cast<uint8>(source[idx] >> 8);
+        dest[2] = static_cast<uint8>(source[idx] >> 16);
+    }
+}
+
+template <typename T>
+void DecodeInt16(const int16* source, T* dest, int count) {
+    for (int idx = 0; idx < count; ++idx) {
+        dest[idx] = IntegerToFloat<16, T>(source[idx]);
+    }
+}
+
+// The vector kernels are bit-identical to the loop above
+inline void DecodeInt16(const int16* source, float* dest, int count) {
+    ConvertPCM16ToFloat(source, dest, count);
+}
+
+template <typename T>
+void EncodeInt16(const T* source, int16* dest, int count) {
+    for (int idx = 0; idx < count; ++idx) {
+        dest[idx] = static_cast<int16>(FloatToInteger<16>(source[idx]));
+    }
+}
+
+inline void EncodeInt16(const float* source, int16* dest, int count) {
+    ConvertFloatToPCM16(source, dest, count);
+}
+
+// Reads |count| contiguous samples into |dest|
+template <typename T>
+void DecodeSamples(const void* source, SampleFormat format, T* dest, int count) {
+    switch (format) {
+        case SampleFormat::Int16:
+            DecodeInt16(static_cast<const int16*>(source), dest, count);
+            break;
+        case SampleFormat::Int24: {
+            int32 samples[kBlockSize];
+            UnpackInt24(static_cast<const uint8*>(source), samples, count);
+            for (int idx = 0; idx < count; ++idx) {
+                dest[idx] = IntegerToFloat<24, T>(samples[idx]);
+            }
+            break;
+        }
+        case SampleFormat::Int32: {
+            const auto* samples = static_cast<const int32*>(source);
+            for (int idx = 0; idx < count; ++idx) {
+                dest[idx] = IntegerToFloat<32, T>(samples[idx]);
+            }
+            break;
+        }
+        case SampleFormat::Float32: {
+            const auto* samples = static_cast<const float*>(source);
+            for (int idx = 0; idx < count; ++idx) {
+                dest[idx] = static_cast<T>(samples[idx]);
+            }
+            break;
+        }
+        case SampleFormat::Float64: {
+            const auto* samples = static_cast<const double*>(source);
+            for (int idx = 0; idx < count; ++idx) {
+                dest[idx] = static_cast<T>(samples[idx]);
+            }
+            break;
+        }
+    }
+}
+
+// Writes |count| samples from |source| contiguously into |dest|
+template <typename T>
+void EncodeSamples(const T* source, void* dest, SampleFormat format, int count) {
+    switch (format) {
+        case SampleFormat::Int16:
+            EncodeInt16(source, static_cast<int16*>(dest), count);
+            break;
+        case SampleFormat::Int24: {
+            int32 samples[kBlockSize];
+            for (int idx = 0; idx < count; ++idx) {
+                samples[idx] = FloatToInteger<24>(source[idx]);
+            }
+            PackInt24(samples, static_cast<uint8*>(dest), count);
+            break;
+        }
+        case SampleFormat::Int32: {
+            auto* samples = static_cast<int32*>(dest);
+            for (int idx = 0; idx < count; ++idx) {
+                samples[idx] = FloatToInteger<32>(source[idx]);
+            }
+            break;
+        }
+        case SampleFormat::Float32: {
+            auto* samples = static_cast<float*>(dest);
+            for (int idx = 0; idx < count; ++idx) {
+                samples[idx] = static_cast<float>(source[idx]);
+            }
+            break;
+        }
+        case SampleFormat::Float64: {
+            auto* samples = static_cast<double*>(dest);
+            for (int idx = 0; idx < count; ++idx) {
+                samples[idx] = static_cast<double>(source[idx]);
+            }
+            break;
+        }
+    }
+}
+
+// Int16, Int24 and Float32 samples are exactly representable as float
+bool NeedsDoublePrecision(SampleFormat lhs, SampleFormat rhs) {
+    return lhs == SampleFormat::Int32 || lhs == SampleFormat::Float64 ||
+           rhs == SampleFormat::Int32 || rhs == SampleFormat::Float64;
+}
+
+// Converts up to kBlockSize contiguous samples. Float32 and Float64 samples
+// of the same precision as |T| are used in place instead of being copied
+template <typename T>
+void ConvertBlock(const void* source,
+                  SampleFormat source_format,
+                  void* dest,
+                  SampleFormat dest_format,
+                  int count) {
+    constexpr SampleFormat kFormat =
+        sizeof(T) == sizeof(float) ? SampleFormat::Float32 : SampleFormat::Float64;
+    if (source_format == kFormat) {
+        EncodeSamples(static_cast<const T*>(source), dest, dest_format, count);
+    } else if (dest_format == kFormat) {
+        DecodeSamples(source, source_format, static_cast<T*>(dest), count);
+    } else {
+        T block[kBlockSize];
+        DecodeSamples(source, source_format, block, count);
+        EncodeSamples(block, dest, dest_format, count);
+    }
+}
+
+void ConvertBlock(const void* source,
+                  SampleFormat source_format,
+                  void* dest,
+                  SampleFormat dest_format,
+                  int count) {
+    if (source_format == dest_format) {
+        std::memcpy(dest, source, static_cast<std::size_t>(count) * SampleFormatSize(dest_format));
+    } else if (NeedsDoublePrecision(source_format, dest_format)) {
+        ConvertBlock<double>(source, source_format, dest, dest_format, count);
+    } else {
+        ConvertBlock<float>(source, source_format, dest, dest_format, count);
+    }
+}
+
+// Copies |count| samples of |kSize| bytes from |source| into every
+// |stride|th sample of |dest|, or in reverse
+template <int kSize>
+void Scatter(const uint8* source, uint8* dest, int stride, int count) {
+    for (int idx = 0; idx < count; ++idx) {
+        std::memcpy(dest + idx * stride * kSize, source + idx * kSize, kSize);
+    }
+}
+
+template <int kSize>
+void Gather(const uint8* source, int stride, uint8* dest, int count) {
+    for (int idx = 0; idx < count; ++idx) {
+        std::memcpy(dest + idx * kSize, source + idx * stride * kSize, kSize);
+    }
+}
+
+// Same as above for two adjacent channels at once. With a constant stride
+// of two, i.e. stereo, the compiler turns these into vector shuffles
+template <int kSize>
+inline void ScatterPair(const uint8* first,
+                        const uint8* second,
+                        uint8* dest,
+                        int stride,
+                        int count) {
+    for (int idx = 0; idx < count; ++idx) {
+        std::memcpy(dest + idx * stride * kSize, first + idx * kSize, kSize);
+        std::memcpy(dest + (idx * stride + 1) * kSize, second + idx * kSize, kSize);
+    }
+}
+
+template <int kSize>
+inline void GatherPair(const uint8* source, int stride, uint8* first, uint8* second, int count) {
+    for (int idx = 0; idx < count; ++idx) {
+        std::memcpy(first + idx * kSize, source + idx * stride * kSize, kSize);
+        std::memcpy(second + idx * kSize, source + (idx * stride + 1) * kSize, kSize);
+    }
+}
+
+// Scatters one channel, or two adjacent ones if |second| isn't null
+template <int kSize>
+void ScatterChannels(const uint8* first, const uint8* second, void* dest, int stride, int count) {
+    if (second != nullptr && stride == 2) {
+        ScatterPair<kSize>(first, second, static_cast<uint8*>(dest), 2, count);
+    } else if (second != nullptr) {
+        ScatterPair<kSize>(first, second, static_cast<uint8*>(dest), stride, count);
+    } else {
+        Scatter<kSize>(first, static_cast<uint8*>(dest), stride, count);
+    }
+}
+
+template <int kSize>
+void GatherChannels(const void* source, int stride, uint8* first, uint8* second, int count) {
+    if (second != nullptr && stride == 2) {
+        GatherPair<kSize>(static_cast<const uint8*>(source), 2, first, second, count);
+    } else if (second != nullptr) {
+        GatherPair<kSize>(static_cast<const uint8*>(source), stride, first, second, count);
+    } else {
+        Gather<kSize>(static_cast<const uint8*>(source), stride, first, count);
+    }
+}
+
+void ScatterSamples(const uint8* first,
+                    const uint8* second,
+                    int size,
+                    void* dest,
+                    int stride,
+                    int count) {
+    switch (size) {
+        case 2:
+            return ScatterChannels<2>(first, second, dest, stride, count);
+        case 3:
+            return ScatterChannels<3>(first, second, dest, stride, count);
+        case 4:
+            return ScatterChannels<4>(first, second, dest, stride, count);
+        case 8:
+            return ScatterChannels<8>(first, second, dest, stride, count);
+    }
+}
+
+void GatherSamples(const void* source,
+                   int size,
+                   int stride,
+                   uint8* first,
+                   uint8* second,
+                   int count) {
+    switch (size) {
+        case 2:
+            return GatherChannels<2>(source, stride, first, second, count);
+        case 3:
+            return GatherChannels<3>(source, stride, first, second, count);
+        case 4:
+            return GatherChannels<4>(source, stride, first, second, count);
+        case 8:
+            return GatherChannels<8>(source, stride, first, second, count);
+    }
+}
+
+const void* SampleAt(const void* data, SampleFormat format, int64 index) {
+    return static_cast<const uint8*>(data) + index * SampleFormatSize(format);
+}
+
+void* SampleAt(void* data, SampleFormat format, int64 index) {
+    return static_cast<uint8*>(data) + index * SampleFormatSize(format);
+}
+
+}  // namespace
+
+int SampleFormatSize(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16:
+            return 2;
+        case SampleFormat::Int24:
+            return 3;
+        case SampleFormat::Int32:
+        case SampleFormat::Float32:
+            return 4;
+        case SampleFormat::Float64:
+            return 8;
+    }
+    return 0;
+}
+
+void ConvertSamples(const void* source,
+                    SampleFormat source_format,
+                    void* dest,
+                    SampleFormat dest_format,
+                    int32 num_samples) {
+    KWC_ASSERT(num_samples >= 0);
+    if (source_format == dest_format) {
+        std::memmove(dest, source,
+                     static_cast<std::size_t>(num_samples) * SampleFormatSize(source_format));
+        return;
+    }
+    for (int32 offset = 0; offset < num_samples; offset += kBlockSize) {
+        ConvertBlock(SampleAt(source, source_format, offset), source_format,
+                     SampleAt(dest, dest_format, offset), dest_format,
+                     std::min(kBlockSize, num_samples - offset));
+    }
+}
+
+// Every block of frames is completed for all channels before moving on, such
+// that each part of the interleaved buffer is only loaded into cache once.
+// Channels are converted contiguously and interleaved in pairs after, which
+// keeps all loops free of runtime strides and vectorizable
+void InterleaveSamples(const void* const* source,
+                       SampleFormat source_format,
+                       void* dest,
+                       SampleFormat dest_format,
+                       int num_channels,
+                       int32 num_frames) {
+    KWC_ASSERT(num_channels > 0 && num_frames >= 0);
+    const int size = SampleFormatSize(dest_format);
+    alignas(kMaxSampleSize) uint8 first[kBlockSize * kMaxSampleSize];
+    alignas(kMaxSampleSize) uint8 second[kBlockSize * kMaxSampleSize];
+    for (int32 offset = 0; offset < num_frames; offset += kBlockSize) {
+        const int count = std::min(kBlockSize, num_frames - offset);
+        for (int channel = 0; channel < num_channels; channel += 2) {
+            const bool has_pair = channel + 1 < num_channels;
+            ConvertBlock(SampleAt(source[channel], source_format, offset), source_format, first,
+                         dest_format, count);
+            if (has_pair) {
+                ConvertBlock(SampleAt(source[channel + 1], source_format, offset), source_format,
+                             second, dest_format, count);
+            }
+            ScatterSamples(first, has_pair ? second : nullptr, size,
+                           SampleAt(dest, dest_format, int64{offset} * num_channels + channel),
+                           num_channels, count);
+        }
+    }
+}
+
+void DeinterleaveSamples(const void* source,
+                         SampleFormat source_format,
+                         void* const* dest,
+                         SampleFormat dest_format,
+                         int num_channels,
+                         int32 num_frames) {
+    KWC_ASSERT(num_channels > 0 && num_frames >= 0);
+    const int size = SampleFormatSize(source_format);
+    alignas(kMaxSampleSize) uint8 first[kBlockSize * kMaxSampleSize];
+    alignas(kMaxSampleSize) uint8 second[kBlockSize * kMaxSampleSize];
+    for (int32 offset = 0; offset < num_frames; offset += kBlockSize) {
+        const int count = std::min(kBlockSize, num_frames - offset);
+        for (int channel = 0; channel < num_channels; channel += 2) {
+            const bool has_pair = channel + 1 < num_channels;
+            GatherSamples(SampleAt(source, source_format, int64{offset} * num_channels + channel),
+                          size, num_channels, first, has_pair ? second : nullptr, count);
+            ConvertBlock(first, source_format, SampleAt(dest[channel], dest_format, offset),
+                         dest_format, count);
+            if (has_pair) {
+                ConvertBlock(second, source_format,
+                             SampleAt(dest[channel + 1], dest_format, offset), dest_format,
+                             count);
+            }
+        }
+    }
+}
+
 void ConvertFloatToPCM16(const float* source, int16* dest, int32 num_samples) {
+    static const FloatToPCM16Function convert = SelectFloatToPCM16();
+    convert(source, dest, num_samples);
+}
+
+void ConvertPCM16ToFloat(const int16* source, float* dest, int32 num_samples) {
+    static const PCM16ToFloatFunction convert = SelectPCM16ToFloat();
+    convert(source, dest, num_samples);
+}
+
+namespace internal {
+
+void ConvertFloatToPCM16Scalar(const float* source, int16* dest, int32 num_samples) {
     for (int idx = 0; idx < num_samples; ++idx) {
-        auto fval = source[idx];
-        fval += 1.0f;
-        fval *= 1 << 15;
-        auto sample = static_cast<int32>(fval);
-        if (sample < 0)
-            sample = 0;
-        else if (sample > (1 << 16) - 1)
-            sample = (1 << 16) - 1;
-        sample -= 1 << 15;  // center at zero
-        dest[idx] = static_cast<int16>(sample);
+        dest[idx] = FloatToPCM16(source[idx]);
     }
 }
 
-void ConvertPCM16ToFloat(const int16* source, float* dest, int32 num_samples) {
+void ConvertPCM16ToFloatScalar(const int16* source, float* dest, int32 num_samples) {
     for (int idx = 0; idx < num_samples; ++idx) {
         dest[idx] = source[idx] * kScale16ToFloat;
     }
 }
 
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+KWC_TARGET_ATTRIBUTE("sse2")
+void ConvertFloatToPCM16Sse2(const float* source, int16* dest, int32 num_samples) {
+    int idx = 0;
+    for (; idx + 8 <= num_samples; idx += 8) {
+        const __m128i lo = FloatToPCM16Sse2(_mm_loadu_ps(source + idx));
+        const __m128i hi = FloatToPCM16Sse2(_mm_loadu_ps(source + idx + 4));
+        // All values are in range already, hence nothing saturates
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + idx), _mm_packs_epi32(lo, hi));
+    }
+    for (; idx < num_samples; ++idx) {
+        dest[idx] = FloatToPCM16(source[idx]);
+    }
+}
+
+KWC_TARGET_ATTRIBUTE("sse2")
+void ConvertPCM16ToFloatSse2(const int16* source, float* dest, int32 num_samples) {
+    const __m128 scale = _mm_set1_ps(kScale16ToFloat);
+
+    int idx = 0;
+    for (; idx + 8 <= num_samples; idx += 8) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + idx));
+        // Sign extension by moving each sample into the upper half first
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        _mm_storeu_ps(dest + idx, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dest + idx + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    for (; idx < num_samples; ++idx) {
+        dest[idx] = source[idx] * kScale16ToFloat;
+    }
+}
+
+KWC_TARGET_ATTRIBUTE("avx2")
+void ConvertFloatToPCM16Avx2(const float* source, int16* dest, int32 num_samples) {
+    int idx = 0;
+    for (; idx + 16 <= num_samples; idx += 16) {
+        const __m256i lo = FloatToPCM16Avx2(_mm256_loadu_ps(source + idx));
+        const __m256i hi = FloatToPCM16Avx2(_mm256_loadu_ps(source + idx + 8));
+        // Packing works per 128 bit lane, which leaves the quarters of the
+        // result in the order 0, 2, 1, 3
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + idx), packed);
+    }
+    for (; idx < num_samples; ++idx) {
+        dest[idx] = FloatToPCM16(source[idx]);
+    }
+}
+
+KWC_TARGET_ATTRIBUTE("avx2")
+void ConvertPCM16ToFloatAvx2(const int16* source, float* dest, int32 num_samples) {
+    const __m256 scale = _mm256_set1_ps(kScale16ToFloat);
+
+    int idx = 0;
+    for (; idx + 16 <= num_samples; idx += 16) {
+        const auto* samples = reinterpret_cast<const __m128i*>(source + idx);
+        const __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(samples));
+        const __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(samples + 1));
+        _mm256_storeu_ps(dest + idx, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(dest + idx + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+    }
+    for (; idx < num_samples; ++idx) {
+        dest[idx] = source[idx] * kScale16ToFloat;
+    }
+}
+#endif
+
+}  // namespace internal
+
 }  // namespace audio
 }  // namespace kwc
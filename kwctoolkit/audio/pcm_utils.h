@@ -7,14 +7,71 @@
 
 #include <sys/types.h>
 
+#include "kwctoolkit/base/compiler.h"
 #include "kwctoolkit/base/integral_types.h"
 
 namespace kwc {
 namespace audio {
 
+// Converts float samples in [-1, 1] to signed 16 bit PCM. Samples outside of
+// this range are clamped, NaN becomes the smallest sample value.
+//
+// On x86 the conversions use AVX2 or SSE2 if the CPU supports it, selected
+// once at runtime. All implementations produce bit-identical results.
 void ConvertFloatToPCM16(const float* source, int16* dest, int32 num_samples);
 void ConvertPCM16ToFloat(const int16* source, float* dest, int32 num_samples);
 
+// Sample formats in native byte order, except for Int24 which is always
+// packed into three bytes in little endian order
+enum class SampleFormat { Int16, Int24, Int32, Float32, Float64 };
+
+// Size of a single sample in bytes
+int SampleFormatSize(SampleFormat format);
+
+// Converts |num_samples| samples between any two formats. Integer samples of
+// N bits map to [-1, 1) by dividing by 2^(N-1), floating point samples are
+// clamped into the integer range, truncating like ConvertFloatToPCM16().
+// Int32 and Float64 samples are converted in double precision, all others in
+// single precision, such that converting a format to itself and back to the
+// original format after a conversion to a wider one is lossless. Source and
+// destination must not overlap, unless both formats are the same.
+void ConvertSamples(const void* source,
+                    SampleFormat source_format,
+                    void* dest,
+                    SampleFormat dest_format,
+                    int32 num_samples);
+
+// Converts |num_channels| planar buffers of |num_frames| samples each into a
+// single interleaved buffer, or vice versa. Conversion and (de)interleaving
+// happen in one pass over memory, via a small block of samples which stays
+// in the L1 cache.
+void InterleaveSamples(const void* const* source,
+                       SampleFormat source_format,
+                       void* dest,
+                       SampleFormat dest_format,
+                       int num_channels,
+                       int32 num_frames);
+void DeinterleaveSamples(const void* source,
+                         SampleFormat source_format,
+                         void* const* dest,
+                         SampleFormat dest_format,
+                         int num_channels,
+                         int32 num_frames);
+
+namespace internal {
+// Portable reference implementations
+void ConvertFloatToPCM16Scalar(const float* source, int16* dest, int32 num_samples);
+void ConvertPCM16ToFloatScalar(const int16* source, float* dest, int32 num_samples);
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+// Only to be called if system::CPU reports support for the extension
+void ConvertFloatToPCM16Sse2(const float* source, int16* dest, int32 num_samples);
+void ConvertPCM16ToFloatSse2(const int16* source, float* dest, int32 num_samples);
+void ConvertFloatToPCM16Avx2(const float* source, int16* dest, int32 num_samples);
+void ConvertPCM16ToFloatAvx2(const int16* source, float* dest, int32 num_samples);
+#endif
+}  // namespace internal
+
 }  // namespace audio
 }  // namespace kwc
 
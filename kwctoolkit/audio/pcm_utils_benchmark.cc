@@ -0,0 +1,150 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cmath>
+#include <vector>
+
+#include "kwctoolkit/audio/pcm_utils.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+std::vector<float> MakeSamples(kwc::int64 size) {
+    std::vector<float> samples(static_cast<std::size_t>(size));
+    for (std::size_t idx = 0; idx < samples.size(); ++idx) {
+        samples[idx] = 0.9f * std::sin(0.01f * idx);
+    }
+    return samples;
+}
+}  // namespace
+
+// Throughput is given in float input bytes and in samples per second
+BENCHMARK(ConvertFloatToPCM16) {
+    const auto samples = MakeSamples(context.arg());
+    std::vector<kwc::int16> pcm(samples.size());
+    while (context.running()) {
+        kwc::audio::ConvertFloatToPCM16(samples.data(), pcm.data(),
+                                        static_cast<kwc::int32>(samples.size()));
+        kwc::utils::DoNotOptimize(pcm.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * sizeof(float));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(ConvertFloatToPCM16)->range(256, 1 << 16);
+
+BENCHMARK(ConvertPCM16ToFloat) {
+    const auto samples = MakeSamples(context.arg());
+    std::vector<kwc::int16> pcm(samples.size());
+    kwc::audio::ConvertFloatToPCM16(samples.data(), pcm.data(),
+                                    static_cast<kwc::int32>(samples.size()));
+    std::vector<float> output(samples.size());
+    while (context.running()) {
+        kwc::audio::ConvertPCM16ToFloat(pcm.data(), output.data(),
+                                        static_cast<kwc::int32>(pcm.size()));
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * sizeof(kwc::int16));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(ConvertPCM16ToFloat)->range(256, 1 << 16);
+
+// Portable loops for comparison with the dispatched kernels above
+BENCHMARK(ConvertFloatToPCM16Scalar) {
+    const auto samples = MakeSamples(context.arg());
+    std::vector<kwc::int16> pcm(samples.size());
+    while (context.running()) {
+        kwc::audio::internal::ConvertFloatToPCM16Scalar(samples.data(), pcm.data(),
+                                                        static_cast<kwc::int32>(samples.size()));
+        kwc::utils::DoNotOptimize(pcm.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * sizeof(float));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(ConvertFloatToPCM16Scalar)->range(256, 1 << 16);
+
+BENCHMARK(ConvertPCM16ToFloatScalar) {
+    const auto samples = MakeSamples(context.arg());
+    std::vector<kwc::int16> pcm(samples.size());
+    kwc::audio::ConvertFloatToPCM16(samples.data(), pcm.data(),
+                                    static_cast<kwc::int32>(samples.size()));
+    std::vector<float> output(samples.size());
+    while (context.running()) {
+        kwc::audio::internal::ConvertPCM16ToFloatScalar(pcm.data(), output.data(),
+                                                        static_cast<kwc::int32>(pcm.size()));
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * sizeof(kwc::int16));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(ConvertPCM16ToFloatScalar)->range(256, 1 << 16);
+
+BENCHMARK(ConvertFloat32ToInt24) {
+    const auto samples = MakeSamples(context.arg());
+    std::vector<kwc::uint8> pcm(samples.size() * 3);
+    while (context.running()) {
+        kwc::audio::ConvertSamples(samples.data(), kwc::audio::SampleFormat::Float32, pcm.data(),
+                                   kwc::audio::SampleFormat::Int24,
+                                   static_cast<kwc::int32>(samples.size()));
+        kwc::utils::DoNotOptimize(pcm.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * sizeof(float));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(ConvertFloat32ToInt24)->range(256, 1 << 16);
+
+BENCHMARK(ConvertInt32ToFloat32) {
+    const auto samples = MakeSamples(context.arg());
+    std::vector<kwc::int32> pcm(samples.size());
+    kwc::audio::ConvertSamples(samples.data(), kwc::audio::SampleFormat::Float32, pcm.data(),
+                               kwc::audio::SampleFormat::Int32,
+                               static_cast<kwc::int32>(samples.size()));
+    std::vector<float> output(samples.size());
+    while (context.running()) {
+        kwc::audio::ConvertSamples(pcm.data(), kwc::audio::SampleFormat::Int32, output.data(),
+                                   kwc::audio::SampleFormat::Float32,
+                                   static_cast<kwc::int32>(pcm.size()));
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * sizeof(kwc::int32));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(ConvertInt32ToFloat32)->range(256, 1 << 16);
+
+// Planar stereo float to interleaved int16 in a single pass, items are frames
+BENCHMARK(InterleaveFloat32ToInt16) {
+    const auto left = MakeSamples(context.arg());
+    const auto right = MakeSamples(context.arg());
+    const void* planes[] = {left.data(), right.data()};
+    std::vector<kwc::int16> interleaved(2 * left.size());
+    while (context.running()) {
+        kwc::audio::InterleaveSamples(planes, kwc::audio::SampleFormat::Float32,
+                                      interleaved.data(), kwc::audio::SampleFormat::Int16, 2,
+                                      static_cast<kwc::int32>(left.size()));
+        kwc::utils::DoNotOptimize(interleaved.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * 2 * sizeof(float));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(InterleaveFloat32ToInt16)->range(256, 1 << 16);
+
+// Same as above, but converting each channel first and interleaving after
+BENCHMARK(InterleaveFloat32ToInt16TwoPass) {
+    const auto left = MakeSamples(context.arg());
+    const auto right = MakeSamples(context.arg());
+    const auto num_frames = static_cast<kwc::int32>(left.size());
+    std::vector<kwc::int16> left_pcm(left.size());
+    std::vector<kwc::int16> right_pcm(right.size());
+    std::vector<kwc::int16> interleaved(2 * left.size());
+    while (context.running()) {
+        kwc::audio::ConvertFloatToPCM16(left.data(), left_pcm.data(), num_frames);
+        kwc::audio::ConvertFloatToPCM16(right.data(), right_pcm.data(), num_frames);
+        for (kwc::int32 frame = 0; frame < num_frames; ++frame) {
+            interleaved[2 * frame] = left_pcm[frame];
+            interleaved[2 * frame + 1] = right_pcm[frame];
+        }
+        kwc::utils::DoNotOptimize(interleaved.data());
+    }
+    context.setBytesProcessed(context.iterations() * context.arg() * 2 * sizeof(float));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(InterleaveFloat32ToInt16TwoPass)->range(256, 1 << 16);
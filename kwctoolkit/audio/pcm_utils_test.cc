@@ -0,0 +1,279 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/audio/pcm_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include "kwctoolkit/system/cpu.h"
+#endif
+
+using namespace kwc;
+using namespace kwc::audio;
+
+namespace {
+// Regular samples, values around every clamping and rounding boundary and
+// odd lengths, such that the scalar tail of the vector loops is used too
+std::vector<float> MakeFloatSamples() {
+    std::vector<float> samples = {0.0f,
+                                  -0.0f,
+                                  1.0f,
+                                  -1.0f,
+                                  1.5f,
+                                  -1.5f,
+                                  1e10f,
+                                  -1e10f,
+                                  std::numeric_limits<float>::infinity(),
+                                  -std::numeric_limits<float>::infinity(),
+                                  std::numeric_limits<float>::quiet_NaN(),
+                                  std::numeric_limits<float>::denorm_min(),
+                                  std::nextafter(1.0f, 2.0f),
+                                  std::nextafter(1.0f, 0.0f),
+                                  std::nextafter(-1.0f, -2.0f),
+                                  std::nextafter(-1.0f, 0.0f),
+                                  0.5f / (1 << 15),
+                                  -0.5f / (1 << 15),
+                                  1.0f / (1 << 15),
+                                  -1.0f / (1 << 15)};
+    for (int idx = 0; idx < 4099; ++idx) {
+        samples.push_back(1.2f * static_cast<float>(std::sin(0.37 * idx)));
+    }
+    return samples;
+}
+
+std::vector<int16> MakePCM16Samples() {
+    std::vector<int16> samples;
+    for (int value = -32768; value <= 32767; ++value) {
+        samples.push_back(static_cast<int16>(value));
+    }
+    samples.push_back(0);
+    return samples;
+}
+
+using FloatToPCM16Function = void (*)(const float*, int16*, int32);
+using PCM16ToFloatFunction = void (*)(const int16*, float*, int32);
+
+void ExpectBitExactFloatToPCM16(FloatToPCM16Function convert) {
+    const auto samples = MakeFloatSamples();
+    for (const std::size_t size : {std::size_t{0}, std::size_t{7}, std::size_t{15},
+                                   std::size_t{33}, samples.size()}) {
+        SCOPED_TRACE(size);
+        std::vector<int16> expected(size);
+        std::vector<int16> actual(size);
+        internal::ConvertFloatToPCM16Scalar(samples.data(), expected.data(),
+                                            static_cast<int32>(size));
+        convert(samples.data(), actual.data(), static_cast<int32>(size));
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+void ExpectBitExactPCM16ToFloat(PCM16ToFloatFunction convert) {
+    const auto samples = MakePCM16Samples();
+    for (const std::size_t size : {std::size_t{0}, std::size_t{7}, std::size_t{15},
+                                   std::size_t{33}, samples.size()}) {
+        SCOPED_TRACE(size);
+        std::vector<float> expected(size);
+        std::vector<float> actual(size);
+        internal::ConvertPCM16ToFloatScalar(samples.data(), expected.data(),
+                                            static_cast<int32>(size));
+        convert(samples.data(), actual.data(), static_cast<int32>(size));
+        EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(), size * sizeof(float)));
+    }
+}
+}  // namespace
+
+TEST(PCMUtilsTest, ConvertsFloatToPCM16) {
+    const float samples[] = {0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 2.0f, -2.0f,
+                             std::numeric_limits<float>::quiet_NaN()};
+    const int16 expected[] = {0, 32767, -32768, 16384, -16384, 32767, -32768, -32768};
+    int16 actual[8];
+    ConvertFloatToPCM16(samples, actual, 8);
+    for (int idx = 0; idx < 8; ++idx) {
+        EXPECT_EQ(expected[idx], actual[idx]) << "at " << idx;
+    }
+}
+
+TEST(PCMUtilsTest, ConvertsPCM16ToFloat) {
+    const int16 samples[] = {0, 16384, -16384, -32768, 32767};
+    const float expected[] = {0.0f, 0.5f, -0.5f, -1.0f, 32767.0f / 32768.0f};
+    float actual[5];
+    ConvertPCM16ToFloat(samples, actual, 5);
+    for (int idx = 0; idx < 5; ++idx) {
+        EXPECT_EQ(expected[idx], actual[idx]) << "at " << idx;
+    }
+}
+
+TEST(PCMUtilsTest, RoundTripsEveryPCM16Value) {
+    const auto samples = MakePCM16Samples();
+    std::vector<float> floats(samples.size());
+    std::vector<int16> restored(samples.size());
+    ConvertPCM16ToFloat(samples.data(), floats.data(), static_cast<int32>(samples.size()));
+    ConvertFloatToPCM16(floats.data(), restored.data(), static_cast<int32>(floats.size()));
+    EXPECT_EQ(samples, restored);
+}
+
+TEST(PCMUtilsTest, DispatchedConversionIsBitExact) {
+    ExpectBitExactFloatToPCM16(ConvertFloatToPCM16);
+    ExpectBitExactPCM16ToFloat(ConvertPCM16ToFloat);
+}
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+TEST(PCMUtilsTest, Sse2ConversionIsBitExact) {
+    if (!system::CPU::getInstance().hasSse2()) {
+        GTEST_SKIP() << "SSE2 is not supported";
+    }
+    ExpectBitExactFloatToPCM16(internal::ConvertFloatToPCM16Sse2);
+    ExpectBitExactPCM16ToFloat(internal::ConvertPCM16ToFloatSse2);
+}
+
+TEST(PCMUtilsTest, Avx2ConversionIsBitExact) {
+    if (!system::CPU::getInstance().hasAvx2()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+    ExpectBitExactFloatToPCM16(internal::ConvertFloatToPCM16Avx2);
+    ExpectBitExactPCM16ToFloat(internal::ConvertPCM16ToFloatAvx2);
+}
+#endif
+
+namespace {
+const SampleFormat kSampleFormats[] = {SampleFormat::Int16, SampleFormat::Int24,
+                                       SampleFormat::Int32, SampleFormat::Float32,
+                                       SampleFormat::Float64};
+
+std::vector<uint8> ConvertTo(const std::vector<uint8>& source,
+                             SampleFormat source_format,
+                             SampleFormat dest_format) {
+    const auto num_samples = static_cast<int32>(source.size() / SampleFormatSize(source_format));
+    std::vector<uint8> dest(static_cast<std::size_t>(num_samples) * SampleFormatSize(dest_format));
+    ConvertSamples(source.data(), source_format, dest.data(), dest_format, num_samples);
+    return dest;
+}
+
+std::vector<uint8> MakeSamples(SampleFormat format, int32 num_samples) {
+    std::vector<double> samples;
+    for (int idx = 0; idx < num_samples; ++idx) {
+        samples.push_back(std::sin(0.37 * idx) * (idx % 7 == 0 ? 1.5 : 0.99));
+    }
+    std::vector<uint8> source(samples.size() * sizeof(double));
+    std::memcpy(source.data(), samples.data(), source.size());
+    return ConvertTo(source, SampleFormat::Float64, format);
+}
+}  // namespace
+
+TEST(PCMUtilsTest, ConvertsIntoPackedLittleEndianInt24) {
+    const float samples[] = {0.0f, 0.5f, -1.0f, 1.0f, -0.5f / (1 << 23)};
+    const uint8 expected[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x80,
+                              0xFF, 0xFF, 0x7F, 0xFF, 0xFF, 0xFF};
+    uint8 actual[15];
+    ConvertSamples(samples, SampleFormat::Float32, actual, SampleFormat::Int24, 5);
+    for (int idx = 0; idx < 15; ++idx) {
+        EXPECT_EQ(expected[idx], actual[idx]) << "at " << idx;
+    }
+
+    float restored[5];
+    ConvertSamples(actual, SampleFormat::Int24, restored, SampleFormat::Float32, 5);
+    EXPECT_EQ(restored[0], 0.0f);
+    EXPECT_EQ(restored[1], 0.5f);
+    EXPECT_EQ(restored[2], -1.0f);
+    EXPECT_EQ(restored[3], 1.0f - 1.0f / (1 << 23));
+    EXPECT_EQ(restored[4], -1.0f / (1 << 23));
+}
+
+TEST(PCMUtilsTest, ConvertsInt32InDoublePrecision) {
+    const double samples[] = {0.5, -1.0, 1.0, 1.0 / (int64{1} << 31), -3.0};
+    const int32 expected[] = {1 << 30, kINT32min, kINT32max, 1, kINT32min};
+    int32 actual[5];
+    ConvertSamples(samples, SampleFormat::Float64, actual, SampleFormat::Int32, 5);
+    for (int idx = 0; idx < 5; ++idx) {
+        EXPECT_EQ(expected[idx], actual[idx]) << "at " << idx;
+    }
+}
+
+TEST(PCMUtilsTest, Int16MatchesDedicatedConversion) {
+    const auto samples = MakeFloatSamples();
+    const auto num_samples = static_cast<int32>(samples.size());
+    std::vector<int16> expected(samples.size());
+    std::vector<int16> actual(samples.size());
+    ConvertFloatToPCM16(samples.data(), expected.data(), num_samples);
+    ConvertSamples(samples.data(), SampleFormat::Float32, actual.data(), SampleFormat::Int16,
+                   num_samples);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(PCMUtilsTest, WideningConversionsRoundTrip) {
+    for (const SampleFormat narrow : kSampleFormats) {
+        for (const SampleFormat wide : kSampleFormats) {
+            if (SampleFormatSize(wide) < SampleFormatSize(narrow) ||
+                (narrow == SampleFormat::Int32 && wide == SampleFormat::Float32) ||
+                (narrow == SampleFormat::Float32 && wide == SampleFormat::Int32)) {
+                continue;
+            }
+            SCOPED_TRACE(static_cast<int>(narrow));
+            SCOPED_TRACE(static_cast<int>(wide));
+            const auto samples = MakeSamples(narrow, 1001);
+            EXPECT_EQ(samples, ConvertTo(ConvertTo(samples, narrow, wide), wide, narrow));
+        }
+    }
+}
+
+namespace {
+void ExpectInterleavesAndDeinterleaves(int num_channels) {
+    const int32 kNumFrames = 1001;
+    std::vector<std::vector<uint8>> planes;
+    std::vector<const void*> source;
+    for (int channel = 0; channel < num_channels; ++channel) {
+        planes.push_back(MakeSamples(SampleFormat::Float32, kNumFrames + channel));
+        planes.back().resize(kNumFrames * sizeof(float));
+    }
+    for (const auto& plane : planes) {
+        source.push_back(plane.data());
+    }
+
+    for (const SampleFormat format : kSampleFormats) {
+        SCOPED_TRACE(static_cast<int>(format));
+        const int size = SampleFormatSize(format);
+        std::vector<uint8> interleaved(num_channels * kNumFrames * size);
+        InterleaveSamples(source.data(), SampleFormat::Float32, interleaved.data(), format,
+                          num_channels, kNumFrames);
+        for (int channel = 0; channel < num_channels; ++channel) {
+            const auto expected = ConvertTo(planes[channel], SampleFormat::Float32, format);
+            for (int32 frame = 0; frame < kNumFrames; ++frame) {
+                ASSERT_EQ(0, std::memcmp(&expected[frame * size],
+                                         &interleaved[(frame * num_channels + channel) * size],
+                                         size))
+                    << "at channel " << channel << ", frame " << frame;
+            }
+        }
+
+        std::vector<std::vector<uint8>> restored(num_channels,
+                                                 std::vector<uint8>(kNumFrames * sizeof(float)));
+        std::vector<void*> dest;
+        for (auto& plane : restored) {
+            dest.push_back(plane.data());
+        }
+        DeinterleaveSamples(interleaved.data(), format, dest.data(), SampleFormat::Float32,
+                            num_channels, kNumFrames);
+        for (int channel = 0; channel < num_channels; ++channel) {
+            const auto expected = ConvertTo(
+                ConvertTo(planes[channel], SampleFormat::Float32, format), format,
+                SampleFormat::Float32);
+            EXPECT_EQ(expected, restored[channel]) << "at channel " << channel;
+        }
+    }
+}
+}  // namespace
+
+// Mono, stereo and an odd number of channels take different paths
+TEST(PCMUtilsTest, InterleavesAndDeinterleavesWhileConverting) {
+    for (const int num_channels : {1, 2, 3, 6}) {
+        SCOPED_TRACE(num_channels);
+        ExpectInterleavesAndDeinterleaves(num_channels);
+    }
+}
@@ -0,0 +1,293 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/audio/resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+#include "kwctoolkit/base/assert.h"
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include <immintrin.h>
+
+    #include "kwctoolkit/system/cpu.h"
+#endif
+
+namespace kwc {
+namespace audio {
+namespace {
+
+struct QualityPreset {
+    int32 num_taps;
+    // Kaiser window parameter for the stop band attenuation
+    double beta;
+    // Cutoff relative to the Nyquist frequency, which places the stop band
+    // edge close to the Nyquist frequency for the transition band of the
+    // number of taps
+    double cutoff;
+};
+
+// Kaiser's empirical formula for an attenuation of more than 50 dB is
+// beta = 0.1102 * (A - 8.7)
+constexpr QualityPreset kQualityPresets[] = {
+    {16, 5.653, 0.77},   // Fast, 60 dB
+    {32, 7.857, 0.84},   // Balanced, 80 dB
+    {64, 10.061, 0.90},  // Best, 100 dB
+};
+
+// Number of input frames copied into the buffer at once, which bounds the
+// buffer size independently of the block size passed to process()
+constexpr int32 kChunkFrames = 512;
+
+int32 GreatestCommonDivisor(int32 lhs, int32 rhs) {
+    while (rhs != 0) {
+        const int32 remainder = lhs % rhs;
+        lhs = rhs;
+        rhs = remainder;
+    }
+    return lhs;
+}
+
+// Zeroth order modified Bessel function of the first kind, from its power
+// series
+double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; term > 1e-12 * sum; ++k) {
+        const double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+    }
+    return sum;
+}
+
+double Sinc(double x) {
+    return x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+}
+
+using DotProductFunction = float (*)(const float*, const float*, int32);
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+// Sum of all lanes as ((x0 + x2) + (x1 + x3)), the same order as the scalar
+// version
+KWC_TARGET_ATTRIBUTE("sse2")
+inline float HorizontalSumSse2(__m128 sum) {
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+DotProductFunction SelectDotProduct() {
+    const system::CPU& cpu = system::CPU::getInstance();
+    if (cpu.hasAvx2()) {
+        return internal::DotProductAvx2;
+    }
+    if (cpu.hasSse2()) {
+        return internal::DotProductSse2;
+    }
+    return internal::DotProductScalar;
+}
+#else
+DotProductFunction SelectDotProduct() {
+    return internal::DotProductScalar;
+}
+#endif
+}  // namespace
+
+constexpr int32 Resampler::kMaxPhases;
+
+base::Status Resampler::create(int32 input_rate, int32 output_rate, Quality quality,
+                               std::unique_ptr<Resampler>* resampler) {
+    if (input_rate <= 0 || output_rate <= 0) {
+        return base::Status(base::error::INVALID_ARGUMENT, "Sample rates must be positive");
+    }
+    if (output_rate / GreatestCommonDivisor(input_rate, output_rate) > kMaxPhases) {
+        return base::Status(base::error::INVALID_ARGUMENT,
+                            "Converting " + std::to_string(input_rate) + " Hz to " +
+                                std::to_string(output_rate) + " Hz needs more than " +
+                                std::to_string(kMaxPhases) + " filter phases");
+    }
+    resampler->reset(new Resampler(input_rate, output_rate, quality));
+    return base::Status();
+}
+
+Resampler::Resampler(int32 input_rate, int32 output_rate, Quality quality)
+    : input_rate_(input_rate), output_rate_(output_rate) {
+    const int32 divisor = GreatestCommonDivisor(input_rate, output_rate);
+    num_phases_ = output_rate / divisor;
+    const int32 decimation = input_rate / divisor;
+    step_frames_ = decimation / num_phases_;
+    step_phases_ = decimation % num_phases_;
+
+    const QualityPreset& preset = kQualityPresets[static_cast<int>(quality)];
+    // Lowering the cutoff for downsampling narrows the transition band in
+    // terms of input frames as well, which needs proportionally more taps.
+    // Multiples of eight fill whole AVX2 registers
+    const double downsampling = std::max(1.0, static_cast<double>(decimation) / num_phases_);
+    num_taps_ = static_cast<int32>(std::ceil(preset.num_taps * downsampling / 8.0)) * 8;
+    const double cutoff = preset.cutoff / downsampling;
+
+    // Phase p computes output frames at input time n + p / L from input
+    // frames n - taps / 2 + 1 up to n + taps / 2
+    const int32 half_taps = num_taps_ / 2;
+    const double window_scale = 1.0 / BesselI0(preset.beta);
+    filter_bank_.resize(static_cast<std::size_t>(num_phases_) * num_taps_);
+    std::vector<double> values(static_cast<std::size_t>(num_taps_));
+    for (int32 phase = 0; phase < num_phases_; ++phase) {
+        float* coefficients = &filter_bank_[static_cast<std::size_t>(phase) * num_taps_];
+        double sum = 0.0;
+        for (int32 tap = 0; tap < num_taps_; ++tap) {
+            const double time = half_taps - 1 - tap + static_cast<double>(phase) / num_phases_;
+            const double x = time / half_taps;
+            const double window = BesselI0(preset.beta * std::sqrt(std::max(0.0, 1.0 - x * x)));
+            values[tap] = cutoff * Sinc(cutoff * time) * window * window_scale;
+            sum += values[tap];
+        }
+        // Unity gain at DC for every phase, otherwise the phases modulate a
+        // constant signal
+        for (int32 tap = 0; tap < num_taps_; ++tap) {
+            coefficients[tap] = static_cast<float>(values[tap] / sum);
+        }
+    }
+
+    static const DotProductFunction dot_product = SelectDotProduct();
+    dot_product_ = dot_product;
+    buffer_.resize(static_cast<std::size_t>(num_taps_ + kChunkFrames));
+    reset();
+}
+
+int32 Resampler::numOutputFrames(int32 num_input_frames) const {
+    KWC_ASSERT(num_input_frames >= 0);
+    // Output frames are written while position + taps <= buffered frames,
+    // i.e. for all k with (phase + k * M) / L <= last
+    const int64 last = int64{num_buffered_} + num_input_frames - num_taps_ - position_;
+    const int64 decimation = int64{step_frames_} * num_phases_ + step_phases_;
+    const int64 numerator = (last + 1) * num_phases_ - phase_;
+    return numerator > 0 ? static_cast<int32>((numerator + decimation - 1) / decimation) : 0;
+}
+
+int32 Resampler::process(const float* input, int32 num_input_frames, float* output) {
+    KWC_ASSERT(num_input_frames >= 0);
+    int32 num_output_frames = 0;
+    while (num_input_frames > 0) {
+        const int32 count = std::min(num_input_frames, kChunkFrames);
+        std::copy(input, input + count, buffer_.data() + num_buffered_);
+        num_buffered_ += count;
+        input += count;
+        num_input_frames -= count;
+        num_output_frames += filterBuffer(output + num_output_frames);
+    }
+    return num_output_frames;
+}
+
+int32 Resampler::flush(float* output) {
+    const std::vector<float> zeros(static_cast<std::size_t>(num_taps_ / 2), 0.0f);
+    return process(zeros.data(), num_taps_ / 2, output);
+}
+
+void Resampler::reset() {
+    num_buffered_ = num_taps_ / 2 - 1;
+    std::fill(buffer_.begin(), buffer_.begin() + num_buffered_, 0.0f);
+    position_ = 0;
+    phase_ = 0;
+}
+
+int32 Resampler::filterBuffer(float* output) {
+    // Locals, as the indirect calls would reload all members otherwise
+    const DotProductFunction dot_product = dot_product_;
+    const float* buffer = buffer_.data();
+    const float* filter_bank = filter_bank_.data();
+    const int32 num_taps = num_taps_;
+    const int32 last_position = num_buffered_ - num_taps;
+    int32 position = position_;
+    int32 phase = phase_;
+    int32 num_output_frames = 0;
+    while (position <= last_position) {
+        output[num_output_frames++] =
+            dot_product(filter_bank + phase * num_taps, buffer + position, num_taps);
+        position += step_frames_;
+        phase += step_phases_;
+        if (phase >= num_phases_) {
+            phase -= num_phases_;
+            ++position;
+        }
+    }
+
+    // Less than |num_taps_| frames remain, which are moved to the front
+    const int32 consumed = std::min(position, num_buffered_);
+    std::copy(buffer_.begin() + consumed, buffer_.begin() + num_buffered_, buffer_.begin());
+    num_buffered_ -= consumed;
+    position_ = position - consumed;
+    phase_ = phase;
+    return num_output_frames;
+}
+
+namespace internal {
+
+float DotProductScalar(const float* lhs, const float* rhs, int32 size) {
+    float sums[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    int32 idx = 0;
+    for (; idx + 4 <= size; idx += 4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            sums[lane] += lhs[idx + lane] * rhs[idx + lane];
+        }
+    }
+    float sum = (sums[0] + sums[2]) + (sums[1] + sums[3]);
+    for (; idx < size; ++idx) {
+        sum += lhs[idx] * rhs[idx];
+    }
+    return sum;
+}
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+KWC_TARGET_ATTRIBUTE("sse2")
+float DotProductSse2(const float* lhs, const float* rhs, int32 size) {
+    __m128 sums = _mm_setzero_ps();
+    int32 idx = 0;
+    for (; idx + 4 <= size; idx += 4) {
+        sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(lhs + idx), _mm_loadu_ps(rhs + idx)));
+    }
+    float sum = HorizontalSumSse2(sums);
+    for (; idx < size; ++idx) {
+        sum += lhs[idx] * rhs[idx];
+    }
+    return sum;
+}
+
+// Two independent accumulators hide the latency of the additions
+KWC_TARGET_ATTRIBUTE("avx2")
+float DotProductAvx2(const float* lhs, const float* rhs, int32 size) {
+    __m256 first = _mm256_setzero_ps();
+    __m256 second = _mm256_setzero_ps();
+    int32 idx = 0;
+    for (; idx + 16 <= size; idx += 16) {
+        first = _mm256_add_ps(
+            first, _mm256_mul_ps(_mm256_loadu_ps(lhs + idx), _mm256_loadu_ps(rhs + idx)));
+        second = _mm256_add_ps(second, _mm256_mul_ps(_mm256_loadu_ps(lhs + idx + 8),
+                                                     _mm256_loadu_ps(rhs + idx + 8)));
+    }
+    if (idx + 8 <= size) {
+        first = _mm256_add_ps(
+            first, _mm256_mul_ps(_mm256_loadu_ps(lhs + idx), _mm256_loadu_ps(rhs + idx)));
+        idx += 8;
+    }
+    const __m256 sums = _mm256_add_ps(first, second);
+    float sum = HorizontalSumSse2(
+        _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1)));
+    for (; idx < size; ++idx) {
+        sum += lhs[idx] * rhs[idx];
+    }
+    return sum;
+}
+#endif
+
+}  // namespace internal
+
+}  // namespace audio
+}  // namespace kwc
@@ -0,0 +1,120 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_AUDIO_RESAMPLER_H_
+#define KWCTOOLKIT_AUDIO_RESAMPLER_H_
+
+#include <memory>
+#include <vector>
+
+#include "kwctoolkit/base/compiler.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/status.h"
+
+namespace kwc {
+namespace audio {
+
+// Converts a stream of mono float samples from one sample rate to another.
+// The ratio output_rate / input_rate is reduced to L / M and every output
+// sample is the inner product of the input with one of L phases of a Kaiser
+// windowed sinc, which are computed once in the constructor. Interleaved
+// streams need one Resampler per channel.
+//
+// Output frame k corresponds to the input at time k * M / L without any
+// delay, but it is only written once the taps reaching past that time are
+// available. Hence process() holds back about numTaps() / 2 input frames
+// until more input arrives or flush() pads the stream with zeros
+class Resampler {
+  public:
+    // Presets trading speed for quality, i.e. the number of taps per output
+    // frame, the stop band attenuation and the cutoff frequency relative to
+    // the lower of both Nyquist frequencies:
+    //   - Fast: 16 taps, 60 dB, 77%
+    //   - Balanced: 32 taps, 80 dB, 84%
+    //   - Best: 64 taps, 100 dB, 90%
+    // When downsampling the number of taps grows by the ratio of the rates
+    // to keep the transition band equally narrow
+    enum class Quality { Fast, Balanced, Best };
+
+    // Upper bound for L, such that the filter bank stays small. Converting
+    // 44.1 kHz to 48 kHz requires 160 phases
+    static constexpr int32 kMaxPhases = 1024;
+
+    // Creates a resampler in |resampler|. Fails with INVALID_ARGUMENT unless
+    // both rates are positive and their ratio reduces to at most kMaxPhases
+    // phases, which rules out nearly coprime rates such as 44100 and 44101
+    static base::Status create(int32 input_rate, int32 output_rate, Quality quality,
+                               std::unique_ptr<Resampler>* resampler);
+    ~Resampler() = default;
+
+    int32 inputRate() const { return input_rate_; }
+    int32 outputRate() const { return output_rate_; }
+    int32 numTaps() const { return num_taps_; }
+
+    // Exact number of frames the next call of process() writes for
+    // |num_input_frames| input frames
+    int32 numOutputFrames(int32 num_input_frames) const;
+
+    // Consumes all |num_input_frames| frames of |input| and writes the
+    // resampled frames to |output|, which needs to have room for
+    // numOutputFrames(num_input_frames) frames. Returns the number of frames
+    // written. The filter state carries over to the next call, such that
+    // splitting a stream into blocks of any size yields the same output
+    int32 process(const float* input, int32 num_input_frames, float* output);
+
+    // Writes the frames held back at the end of the stream, which are
+    // numOutputFrames(numTaps() / 2) frames. After flush() the total number
+    // of frames written for N input frames is ceil(N * L / M). Call reset()
+    // before processing another stream
+    int32 flush(float* output);
+
+    // Clears the filter state for processing a new stream
+    void reset();
+
+  private:
+    using DotProductFunction = float (*)(const float*, const float*, int32);
+
+    Resampler(int32 input_rate, int32 output_rate, Quality quality);
+
+    int32 input_rate_;
+    int32 output_rate_;
+    int32 num_phases_;
+    int32 num_taps_;
+    // Progress of the input position per output frame in whole frames and in
+    // phases
+    int32 step_frames_;
+    int32 step_phases_;
+    // Coefficients of phase p are at [p * num_taps_, (p + 1) * num_taps_)
+    std::vector<float> filter_bank_;
+    DotProductFunction dot_product_;
+
+    // Pending input, preceded by numTaps() / 2 - 1 zeros at the start of a
+    // stream. The next output frame is computed from |num_taps_| frames at
+    // |position_| with the coefficients of |phase_|. Position can be beyond
+    // the buffered frames when downsampling skips frames
+    std::vector<float> buffer_;
+    int32 num_buffered_;
+    int32 position_;
+    int32 phase_;
+
+    int32 filterBuffer(float* output);
+};
+
+namespace internal {
+// Inner product of |size| floats. The scalar and the SSE2 version add up
+// four partial sums in the same order and yield identical results, whereas
+// the sixteen partial sums of the AVX2 version differ in the last bits
+float DotProductScalar(const float* lhs, const float* rhs, int32 size);
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+// Only to be called if system::CPU reports support for the extension
+float DotProductSse2(const float* lhs, const float* rhs, int32 size);
+float DotProductAvx2(const float* lhs, const float* rhs, int32 size);
+#endif
+}  // namespace internal
+
+}  // namespace audio
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_AUDIO_RESAMPLER_H_
@@ -0,0 +1,54 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "kwctoolkit/audio/resampler.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+void Resample(kwc::utils::Context& context,
+              kwc::int32 input_rate,
+              kwc::int32 output_rate,
+              kwc::audio::Resampler::Quality quality) {
+    std::unique_ptr<kwc::audio::Resampler> resampler;
+    kwc::audio::Resampler::create(input_rate, output_rate, quality, &resampler);
+    std::vector<float> input(static_cast<std::size_t>(context.arg()));
+    for (std::size_t idx = 0; idx < input.size(); ++idx) {
+        input[idx] = std::sin(0.05f * idx) + 0.25f * std::sin(0.31f * idx);
+    }
+    // Room for the frames of the taps still buffered from the last iteration
+    std::vector<float> output(static_cast<std::size_t>(
+        resampler->numOutputFrames(static_cast<kwc::int32>(input.size()) + resampler->numTaps())));
+    while (context.running()) {
+        resampler->process(input.data(), static_cast<kwc::int32>(input.size()), output.data());
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+}  // namespace
+
+// Items are input frames, processed in blocks of the argument
+BENCHMARK(Resample44100To48000Fast) {
+    Resample(context, 44100, 48000, kwc::audio::Resampler::Quality::Fast);
+}
+BENCHMARK_CONFIGURE(Resample44100To48000Fast)->arg(64)->arg(512)->arg(4096);
+
+BENCHMARK(Resample44100To48000Balanced) {
+    Resample(context, 44100, 48000, kwc::audio::Resampler::Quality::Balanced);
+}
+BENCHMARK_CONFIGURE(Resample44100To48000Balanced)->arg(64)->arg(512)->arg(4096);
+
+BENCHMARK(Resample44100To48000Best) {
+    Resample(context, 44100, 48000, kwc::audio::Resampler::Quality::Best);
+}
+BENCHMARK_CONFIGURE(Resample44100To48000Best)->arg(64)->arg(512)->arg(4096);
+
+BENCHMARK(Resample48000To44100Balanced) {
+    Resample(context, 48000, 44100, kwc::audio::Resampler::Quality::Balanced);
+}
+BENCHMARK_CONFIGURE(Resample48000To44100Balanced)->arg(64)->arg(512)->arg(4096);
+
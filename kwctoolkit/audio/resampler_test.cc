@@ -0,0 +1,176 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/audio/resampler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+#include "kwctoolkit/system/cpu.h"
+
+using namespace kwc;
+using namespace kwc::audio;
+
+namespace {
+const Resampler::Quality kQualities[] = {Resampler::Quality::Fast, Resampler::Quality::Balanced,
+                                         Resampler::Quality::Best};
+
+std::unique_ptr<Resampler> MakeResampler(
+    int32 input_rate,
+    int32 output_rate,
+    Resampler::Quality quality = Resampler::Quality::Balanced) {
+    std::unique_ptr<Resampler> resampler;
+    const base::Status status = Resampler::create(input_rate, output_rate, quality, &resampler);
+    EXPECT_TRUE(status.ok()) << status.toString();
+    return resampler;
+}
+
+std::vector<float> MakeTone(double frequency, int32 frame_rate, int32 num_frames) {
+    std::vector<float> samples(num_frames);
+    for (int32 frame = 0; frame < num_frames; ++frame) {
+        samples[frame] =
+            static_cast<float>(0.5 * std::sin(2 * M_PI * frequency * frame / frame_rate));
+    }
+    return samples;
+}
+
+// Resamples |input| in blocks of |block_size| frames including the frames
+// held back at the end
+std::vector<float> Resample(Resampler* resampler, const std::vector<float>& input,
+                            int32 block_size) {
+    std::vector<float> output;
+    for (std::size_t offset = 0; offset < input.size(); offset += block_size) {
+        const int32 count = std::min(block_size, static_cast<int32>(input.size() - offset));
+        const std::size_t size = output.size();
+        output.resize(size + resampler->numOutputFrames(count));
+        const int32 written = resampler->process(&input[offset], count, &output[size]);
+        EXPECT_EQ(static_cast<std::size_t>(written), output.size() - size);
+    }
+    const std::size_t size = output.size();
+    output.resize(size + resampler->numOutputFrames(resampler->numTaps() / 2));
+    EXPECT_EQ(static_cast<std::size_t>(resampler->flush(&output[size])), output.size() - size);
+    return output;
+}
+
+// Largest deviation from a tone of |frequency| at the output rate, skipping
+// the transients at both ends
+double MaxToneError(const std::vector<float>& output, double frequency, int32 frame_rate,
+                    int32 margin) {
+    const auto expected = MakeTone(frequency, frame_rate, static_cast<int32>(output.size()));
+    double error = 0.0;
+    for (std::size_t idx = margin; idx + margin < output.size(); ++idx) {
+        error = std::max(error, std::abs(static_cast<double>(expected[idx]) - output[idx]));
+    }
+    return error;
+}
+}  // namespace
+
+TEST(ResamplerTest, DotProductKernelsMatchScalar) {
+    std::vector<float> lhs(70);
+    std::vector<float> rhs(70);
+    for (std::size_t idx = 0; idx < lhs.size(); ++idx) {
+        lhs[idx] = static_cast<float>(std::sin(0.37 * idx));
+        rhs[idx] = static_cast<float>(std::cos(1.3 * idx * idx));
+    }
+    const system::CPU& cpu = system::CPU::getInstance();
+    for (int32 size = 0; size <= 70; ++size) {
+        SCOPED_TRACE(size);
+        const float expected = internal::DotProductScalar(lhs.data(), rhs.data(), size);
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+        if (cpu.hasSse2()) {
+            EXPECT_EQ(expected, internal::DotProductSse2(lhs.data(), rhs.data(), size));
+        }
+        if (cpu.hasAvx2()) {
+            EXPECT_NEAR(expected, internal::DotProductAvx2(lhs.data(), rhs.data(), size), 1e-5);
+        }
+#endif
+    }
+}
+
+TEST(ResamplerTest, RejectsUnsupportedRates) {
+    const int32 rates[][2] = {{0, 48000}, {44100, -1}, {44100, 44101}, {44101, 44100}, {1, 1025}};
+    for (const auto& rate : rates) {
+        SCOPED_TRACE(rate[0]);
+        SCOPED_TRACE(rate[1]);
+        std::unique_ptr<Resampler> resampler;
+        const base::Status status =
+            Resampler::create(rate[0], rate[1], Resampler::Quality::Fast, &resampler);
+        EXPECT_EQ(status.errorCode(), base::error::INVALID_ARGUMENT);
+        EXPECT_EQ(resampler, nullptr);
+    }
+    EXPECT_NE(MakeResampler(1, Resampler::kMaxPhases), nullptr);
+}
+
+TEST(ResamplerTest, WritesExactNumberOfFrames) {
+    const int32 rates[][2] = {{44100, 48000}, {48000, 44100}, {8000, 48000}, {48000, 16000}};
+    for (const auto& rate : rates) {
+        SCOPED_TRACE(rate[0]);
+        SCOPED_TRACE(rate[1]);
+        const auto resampler = MakeResampler(rate[0], rate[1]);
+        const int32 num_frames = 10007;
+        const auto output = Resample(resampler.get(), std::vector<float>(num_frames, 0.25f), 441);
+        const int64 expected = (int64{num_frames} * rate[1] + rate[0] - 1) / rate[0];
+        EXPECT_EQ(static_cast<int64>(output.size()), expected);
+    }
+}
+
+TEST(ResamplerTest, BlockSizeDoesNotChangeOutput) {
+    const auto input = MakeTone(997.0, 44100, 20000);
+    const auto resampler = MakeResampler(44100, 48000);
+    const auto expected = Resample(resampler.get(), input, static_cast<int32>(input.size()));
+    for (const int32 block_size : {1, 7, 147, 512, 1000}) {
+        SCOPED_TRACE(block_size);
+        resampler->reset();
+        EXPECT_EQ(expected, Resample(resampler.get(), input, block_size));
+    }
+}
+
+TEST(ResamplerTest, KeepsConstantSignal) {
+    for (const auto quality : kQualities) {
+        const auto resampler = MakeResampler(44100, 48000, quality);
+        const auto output = Resample(resampler.get(), std::vector<float>(4000, 0.75f), 256);
+        for (std::size_t idx = resampler->numTaps(); idx + resampler->numTaps() < output.size();
+             ++idx) {
+            ASSERT_NEAR(output[idx], 0.75f, 1e-6) << "at " << idx;
+        }
+    }
+}
+
+TEST(ResamplerTest, PreservesToneWithoutDelay) {
+    const double max_errors[] = {1e-3, 1e-4, 1e-5};
+    for (const auto quality : kQualities) {
+        SCOPED_TRACE(static_cast<int>(quality));
+        const double max_error = max_errors[static_cast<int>(quality)];
+        const auto upsampler = MakeResampler(44100, 48000, quality);
+        const auto upsampled = Resample(upsampler.get(), MakeTone(1000.0, 44100, 44100), 512);
+        EXPECT_LT(MaxToneError(upsampled, 1000.0, 48000, upsampler->numTaps()), max_error);
+
+        const auto downsampler = MakeResampler(48000, 44100, quality);
+        const auto downsampled = Resample(downsampler.get(), MakeTone(1000.0, 48000, 48000), 512);
+        EXPECT_LT(MaxToneError(downsampled, 1000.0, 44100, downsampler->numTaps()), max_error);
+    }
+}
+
+TEST(ResamplerTest, SuppressesFrequenciesAboveOutputNyquist) {
+    // Aliases to 44100 - 23000 = 21100 Hz without filtering
+    const double max_gains[] = {1e-3, 2e-4, 2e-5};
+    for (const auto quality : kQualities) {
+        SCOPED_TRACE(static_cast<int>(quality));
+        const auto resampler = MakeResampler(48000, 44100, quality);
+        const auto output = Resample(resampler.get(), MakeTone(23000.0, 48000, 48000), 512);
+        double peak = 0.0;
+        for (std::size_t idx = resampler->numTaps(); idx + resampler->numTaps() < output.size();
+             ++idx) {
+            peak = std::max(peak, std::abs(static_cast<double>(output[idx])));
+        }
+        EXPECT_LT(peak, 0.5 * max_gains[static_cast<int>(quality)]);
+    }
+}
@@ -4,6 +4,7 @@
 
 #include "kwctoolkit/audio/sine_generator.h"
 
+#include <algorithm>
 #include <cmath>
 #ifndef M_PI
     #define M_PI 3.14159265358979323846
@@ -19,6 +20,8 @@ struct Default {
     static constexpr double kTwoPi = M_PI * 2;
 };
 
+constexpr int32 SineGenerator::kFastBlockFrames;
+
 SineGenerator::SineGenerator() {
     setup(Default::kFrequency, Default::kFrameRate, Default::kAmplitude);
 }
@@ -34,13 +37,70 @@ void SineGenerator::setup(double frequency, int32 frame_rate, double amplitude)
 }
 
 void SineGenerator::render(double* buffer, int32 channel_stride, int32 num_frames) {
+    if (mode_ == Mode::Fast) {
+        renderFast(buffer, channel_stride, num_frames);
+    } else {
+        renderPrecise(buffer, channel_stride, num_frames);
+    }
+}
+
+void SineGenerator::render(float* buffer, int32 channel_stride, int32 num_frames) {
+    if (mode_ == Mode::Fast) {
+        renderFast(buffer, channel_stride, num_frames);
+    } else {
+        renderPrecise(buffer, channel_stride, num_frames);
+    }
+}
+
+template <typename T>
+void SineGenerator::renderPrecise(T* buffer, int32 channel_stride, int32 num_frames) {
     for (int idx = 0, sample_index = 0; idx < num_frames; ++idx) {
-        buffer[sample_index] = static_cast<double>(std::sin(phase_) * amplitude_);
+        buffer[sample_index] = static_cast<T>(std::sin(phase_) * amplitude_);
         sample_index += channel_stride;
         advancePhase();
     }
 }
 
+template <typename T>
+void SineGenerator::renderFast(T* buffer, int32 channel_stride, int32 num_frames) {
+    // Frames are rendered by kLanes phasors, each starting one phase
+    // increment after the previous one and rotating by kLanes increments per
+    // step. The lanes are independent of each other, which leaves the
+    // compiler room to vectorize the rotation
+    constexpr int kLanes = 4;
+    const double step = kLanes * phase_increment_;
+    const double step_real = std::cos(step);
+    const double step_imag = std::sin(step);
+
+    for (int32 offset = 0; offset < num_frames; offset += kFastBlockFrames) {
+        const int32 block_frames = std::min(kFastBlockFrames, num_frames - offset);
+        T* block = buffer + static_cast<int64>(offset) * channel_stride;
+
+        // Amplitude times e^(i * phase) of every lane
+        double real[kLanes];
+        double imag[kLanes];
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const double phase = phase_ + lane * phase_increment_;
+            real[lane] = amplitude_ * std::cos(phase);
+            imag[lane] = amplitude_ * std::sin(phase);
+        }
+
+        int32 frame = 0;
+        for (; frame + kLanes <= block_frames; frame += kLanes) {
+            for (int lane = 0; lane < kLanes; ++lane) {
+                block[(frame + lane) * channel_stride] = static_cast<T>(imag[lane]);
+                const double next_real = real[lane] * step_real - imag[lane] * step_imag;
+                imag[lane] = real[lane] * step_imag + imag[lane] * step_real;
+                real[lane] = next_real;
+            }
+        }
+        for (int lane = 0; frame < block_frames; ++frame, ++lane) {
+            block[frame * channel_stride] = static_cast<T>(imag[lane]);
+        }
+        advancePhase(block_frames);
+    }
+}
+
 void SineGenerator::advancePhase() {
     phase_ += phase_increment_;
     while (phase_ >= Default::kTwoPi) {
@@ -48,6 +108,10 @@ void SineGenerator::advancePhase() {
     }
 }
 
+void SineGenerator::advancePhase(int32 num_frames) {
+    phase_ = std::fmod(phase_ + num_frames * phase_increment_, Default::kTwoPi);
+}
+
 double SineGenerator::getPhaseIncrement(double frequency) {
     return frequency * Default::kTwoPi / frame_rate_;
 }
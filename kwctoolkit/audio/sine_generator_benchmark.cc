@@ -0,0 +1,39 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <vector>
+
+#include "kwctoolkit/audio/sine_generator.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+template <typename T>
+void RenderTone(kwc::utils::Context& context, kwc::audio::SineGenerator::Mode mode) {
+    kwc::audio::SineGenerator generator;
+    generator.setup(440.0, 48000, 0.5);
+    generator.setMode(mode);
+    std::vector<T> buffer(static_cast<std::size_t>(context.arg()));
+    while (context.running()) {
+        generator.render(buffer.data(), 1, static_cast<kwc::int32>(buffer.size()));
+        kwc::utils::DoNotOptimize(buffer.data());
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+}  // namespace
+
+// Items are rendered frames
+BENCHMARK(SineGeneratorPrecise) {
+    RenderTone<double>(context, kwc::audio::SineGenerator::Mode::Precise);
+}
+BENCHMARK_CONFIGURE(SineGeneratorPrecise)->range(64, 1 << 16);
+
+BENCHMARK(SineGeneratorFast) {
+    RenderTone<double>(context, kwc::audio::SineGenerator::Mode::Fast);
+}
+BENCHMARK_CONFIGURE(SineGeneratorFast)->range(64, 1 << 16);
+
+BENCHMARK(SineGeneratorFastFloat) {
+    RenderTone<float>(context, kwc::audio::SineGenerator::Mode::Fast);
+}
+BENCHMARK_CONFIGURE(SineGeneratorFastFloat)->range(64, 1 << 16);
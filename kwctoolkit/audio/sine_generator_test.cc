@@ -0,0 +1,97 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/audio/sine_generator.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace kwc;
+using namespace kwc::audio;
+
+namespace {
+constexpr int32 kFrameRate = 48000;
+constexpr double kAmplitude = 0.5;
+
+// Exact phase of every frame, without the rounding errors of adding up the
+// phase increment
+template <typename T>
+std::vector<T> MakeReference(double frequency, int32 num_frames) {
+    std::vector<T> samples(num_frames);
+    for (int32 frame = 0; frame < num_frames; ++frame) {
+        const long double cycles = static_cast<long double>(frequency) * frame / kFrameRate;
+        const double phase = static_cast<double>(2 * M_PI * (cycles - std::floor(cycles)));
+        samples[frame] = static_cast<T>(kAmplitude * std::sin(phase));
+    }
+    return samples;
+}
+
+template <typename T>
+double MaxError(const std::vector<T>& expected, const std::vector<T>& actual) {
+    double error = 0.0;
+    for (std::size_t idx = 0; idx < expected.size(); ++idx) {
+        error = std::max(error, std::abs(static_cast<double>(expected[idx]) - actual[idx]));
+    }
+    return error;
+}
+}  // namespace
+
+TEST(SineGeneratorTest, PreciseModeMatchesSine) {
+    const int32 kNumFrames = kFrameRate;
+    SineGenerator generator;
+    generator.setup(440.0, kFrameRate, kAmplitude);
+    std::vector<double> samples(kNumFrames);
+    generator.render(samples.data(), 1, kNumFrames);
+    EXPECT_LT(MaxError(MakeReference<double>(440.0, kNumFrames), samples), 1e-9);
+}
+
+TEST(SineGeneratorTest, FastModeStaysWithinErrorBound) {
+    // Ten seconds, such that errors would have plenty of time to accumulate
+    const int32 kNumFrames = 10 * kFrameRate;
+    for (const double frequency : {1.0, 440.0, 997.0, 12345.6, 23999.0}) {
+        SCOPED_TRACE(frequency);
+        SineGenerator generator;
+        generator.setup(frequency, kFrameRate, kAmplitude);
+        generator.setMode(SineGenerator::Mode::Fast);
+        std::vector<double> samples(kNumFrames);
+        generator.render(samples.data(), 1, kNumFrames);
+        EXPECT_LT(MaxError(MakeReference<double>(frequency, kNumFrames), samples), 1e-9);
+    }
+}
+
+TEST(SineGeneratorTest, FastModeRendersFloat) {
+    const int32 kNumFrames = 10 * kFrameRate;
+    SineGenerator generator;
+    generator.setup(440.0, kFrameRate, kAmplitude);
+    generator.setMode(SineGenerator::Mode::Fast);
+    std::vector<float> samples(kNumFrames);
+    generator.render(samples.data(), 1, kNumFrames);
+    // Rounding to float dominates the error
+    EXPECT_LT(MaxError(MakeReference<float>(440.0, kNumFrames), samples), 1e-7);
+}
+
+TEST(SineGeneratorTest, FastModeContinuesAcrossCallsAndStrides) {
+    const int32 kNumFrames = 5000;
+    SineGenerator generator;
+    generator.setup(997.0, kFrameRate, kAmplitude);
+    generator.setMode(SineGenerator::Mode::Fast);
+
+    // Interleaved stereo buffer with the tone in the right channel, rendered
+    // in chunks which don't align with the block size or the phasor lanes
+    std::vector<double> samples(2 * kNumFrames, 0.0);
+    int32 frame = 0;
+    for (const int32 chunk : {1, 3, 1023, 1025, 7, 2941}) {
+        generator.render(samples.data() + 2 * frame + 1, 2, chunk);
+        frame += chunk;
+    }
+    ASSERT_EQ(frame, kNumFrames);
+
+    const auto expected = MakeReference<double>(997.0, kNumFrames);
+    for (int32 idx = 0; idx < kNumFrames; ++idx) {
+        EXPECT_EQ(samples[2 * idx], 0.0);
+        EXPECT_NEAR(samples[2 * idx + 1], expected[idx], 1e-9) << "at " << idx;
+    }
+}
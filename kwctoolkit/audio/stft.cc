@@ -0,0 +1,156 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/audio/stft.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kwctoolkit/base/assert.h"
+
+namespace kwc {
+namespace audio {
+
+std::vector<float> MakeWindow(WindowFunction function, int size) {
+    KWC_ASSERT(size >= 1);
+    std::vector<float> window(size);
+    for (int idx = 0; idx < size; ++idx) {
+        const double angle = 2.0 * M_PI * idx / size;
+        double value = 0.0;
+        switch (function) {
+            case WindowFunction::Hann:
+                value = 0.5 - 0.5 * std::cos(angle);
+                break;
+            case WindowFunction::Hamming:
+                value = 0.54 - 0.46 * std::cos(angle);
+                break;
+            case WindowFunction::Blackman:
+                value = 0.42 - 0.5 * std::cos(angle) + 0.08 * std::cos(2.0 * angle);
+                break;
+        }
+        // The Blackman coefficients add up to slightly below zero at the edge
+        window[idx] = static_cast<float>(std::max(0.0, value));
+    }
+    return window;
+}
+
+Stft::Stft(int frame_size, int hop_size, WindowFunction window)
+    : plan_(RealFftPlan<float>::get(frame_size)),
+      hop_size_(hop_size),
+      window_(MakeWindow(window, frame_size)),
+      buffer_(2 * static_cast<std::size_t>(frame_size)) {
+    KWC_ASSERT(hop_size >= 1 && hop_size <= frame_size);
+    if (frame_size % 2 != 0) {
+        frame_.resize(frame_size);
+    }
+}
+
+int32 Stft::numFrames(int32 num_samples) const {
+    KWC_ASSERT(num_samples >= 0);
+    const int64 available = int64{num_buffered_} + num_samples - frameSize();
+    return available >= 0 ? static_cast<int32>(available / hop_size_ + 1) : 0;
+}
+
+int32 Stft::analyze(const float* input, int32 num_samples, std::complex<float>* spectra) {
+    KWC_ASSERT(num_samples >= 0);
+    // Copying at most a frame at once bounds the buffer to two frames
+    const int32 chunk_size = frameSize();
+    int32 num_frames = 0;
+    while (num_samples > 0) {
+        const int32 count = std::min(num_samples, chunk_size);
+        std::copy(input, input + count, buffer_.data() + num_buffered_);
+        num_buffered_ += count;
+        input += count;
+        num_samples -= count;
+        num_frames += analyzeBuffer(spectra + int64{num_frames} * numBins());
+    }
+    return num_frames;
+}
+
+int32 Stft::analyzeBuffer(std::complex<float>* spectra) {
+    const int frame_size = frameSize();
+    const int num_bins = numBins();
+    const float* window = window_.data();
+    int32 position = 0;
+    int32 num_frames = 0;
+    for (; position + frame_size <= num_buffered_; position += hop_size_, ++num_frames) {
+        std::complex<float>* bins = spectra + int64{num_frames} * num_bins;
+        // Even sizes are transformed within the numBins() bins of the output,
+        // which have room for frameSize() + 2 samples
+        float* frame = frame_.empty() ? reinterpret_cast<float*>(bins) : frame_.data();
+        const float* samples = buffer_.data() + position;
+        for (int idx = 0; idx < frame_size; ++idx) {
+            frame[idx] = samples[idx] * window[idx];
+        }
+        plan_.forward(frame, bins);
+    }
+
+    // Less than a frame remains, which is moved to the front
+    std::copy(buffer_.begin() + position, buffer_.begin() + num_buffered_, buffer_.begin());
+    num_buffered_ -= position;
+    return num_frames;
+}
+
+InverseStft::InverseStft(int frame_size, int hop_size, WindowFunction window)
+    : plan_(RealFftPlan<float>::get(frame_size)),
+      hop_size_(hop_size),
+      window_(MakeWindow(window, frame_size)),
+      squared_window_(frame_size),
+      sums_(frame_size),
+      weights_(frame_size),
+      frame_(frame_size) {
+    KWC_ASSERT(hop_size >= 1 && hop_size <= frame_size);
+    double total_weight = 0.0;
+    for (int idx = 0; idx < frame_size; ++idx) {
+        squared_window_[idx] = window_[idx] * window_[idx];
+        total_weight += squared_window_[idx];
+        window_[idx] /= static_cast<float>(frame_size);
+    }
+    // 60 dB below the average window sum, which applies only to samples at
+    // the very start of the stream
+    min_weight_ = static_cast<float>(1e-6 * total_weight / hop_size);
+}
+
+void InverseStft::synthesize(const std::complex<float>* spectra, int32 num_frames,
+                             float* output) {
+    KWC_ASSERT(num_frames >= 0);
+    const int frame_size = frameSize();
+    const float* window = window_.data();
+    const float* squared_window = squared_window_.data();
+    float* sums = sums_.data();
+    float* weights = weights_.data();
+    for (int32 frame_idx = 0; frame_idx < num_frames; ++frame_idx) {
+        plan_.inverse(spectra + int64{frame_idx} * numBins(), frame_.data());
+        const float* frame = frame_.data();
+        for (int idx = 0; idx < frame_size; ++idx) {
+            sums[idx] += frame[idx] * window[idx];
+            weights[idx] += squared_window[idx];
+        }
+        emit(hop_size_, output + int64{frame_idx} * hop_size_);
+    }
+}
+
+void InverseStft::flush(float* output) {
+    emit(frameSize() - hop_size_, output);
+    reset();
+}
+
+void InverseStft::reset() {
+    std::fill(sums_.begin(), sums_.end(), 0.0f);
+    std::fill(weights_.begin(), weights_.end(), 0.0f);
+}
+
+void InverseStft::emit(int count, float* output) {
+    for (int idx = 0; idx < count; ++idx) {
+        output[idx] = sums_[idx] / std::max(weights_[idx], min_weight_);
+    }
+    // Shifts the overlap of the following frames to the front
+    std::copy(sums_.begin() + count, sums_.end(), sums_.begin());
+    std::fill(sums_.end() - count, sums_.end(), 0.0f);
+    std::copy(weights_.begin() + count, weights_.end(), weights_.begin());
+    std::fill(weights_.end() - count, weights_.end(), 0.0f);
+}
+
+}  // namespace audio
+}  // namespace kwc
@@ -0,0 +1,133 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_AUDIO_STFT_H_
+#define KWCTOOLKIT_AUDIO_STFT_H_
+
+#include <complex>
+#include <vector>
+
+#include "kwctoolkit/audio/fft.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/macros.h"
+
+namespace kwc {
+namespace audio {
+
+enum class WindowFunction { Hann, Hamming, Blackman };
+
+// Periodic window of |size| samples, i.e. the first |size| samples of the
+// symmetric window of size + 1 samples. Hann and Hamming windows overlap-add
+// to a constant at a hop size of size / 2, Blackman windows at size / 3
+std::vector<float> MakeWindow(WindowFunction function, int size);
+
+// Short-time Fourier transform of a stream of mono samples. Frame m covers
+// the samples [m * hopSize(), m * hopSize() + frameSize()), is multiplied by
+// the window and transformed by the cached RealFftPlan of the frame size
+// into numBins() bins from DC up to Nyquist.
+//
+// Input can be passed in blocks of any size. Samples not yet covered by a
+// complete frame are kept for the next call, such that blocks of any size
+// yield the same frames. Spectra of all frames completed by a block are
+// written at once to a caller provided buffer and the buffers of the
+// transform are allocated once in the constructor. Hence analyzing a long
+// stream keeps no more than a frame of input and doesn't allocate for even
+// frame sizes, see RealFftPlan::isFast().
+//
+// Example:
+//
+//     Stft stft(1024, 256);
+//     std::vector<std::complex<float>> spectra(stft.numFrames(block_size) * stft.numBins());
+//     const int32 num_frames = stft.analyze(block, block_size, spectra.data());
+class Stft {
+  public:
+    // |hop_size| needs to be in [1, |frame_size|]
+    Stft(int frame_size, int hop_size, WindowFunction window = WindowFunction::Hann);
+    ~Stft() = default;
+
+    int frameSize() const { return plan_.size(); }
+    int hopSize() const { return hop_size_; }
+    int numBins() const { return plan_.numBins(); }
+
+    // Exact number of frames the next call of analyze() completes for
+    // |num_samples| input samples
+    int32 numFrames(int32 num_samples) const;
+
+    // Consumes |num_samples| samples of |input| and writes numBins() bins for
+    // every completed frame to |spectra|, which needs to have room for
+    // numFrames(num_samples) * numBins() bins. Returns the number of frames
+    int32 analyze(const float* input, int32 num_samples, std::complex<float>* spectra);
+
+    // Drops the pending samples for analyzing a new stream
+    void reset() { num_buffered_ = 0; }
+
+  private:
+    const RealFftPlan<float>& plan_;
+    const int hop_size_;
+    const std::vector<float> window_;
+    // Pending samples, less than a frame between calls
+    std::vector<float> buffer_;
+    int32 num_buffered_ = 0;
+    // Windowed frame for odd frame sizes, which can't be transformed within
+    // the output buffer
+    std::vector<float> frame_;
+
+    int32 analyzeBuffer(std::complex<float>* spectra);
+
+    DISALLOW_COPY_AND_ASSIGN(Stft);
+};
+
+// Inverse of Stft by weighted overlap-add. Every frame is transformed back,
+// multiplied by the window once more and added to the output, which is
+// divided by the sum of the squared windows at each sample. Therefore
+// unmodified spectra restore the input of Stft for any window, as long as
+// the windows overlap, i.e. the hop size is below the frame size. Only the
+// first samples of a stream are attenuated, where the window is close to
+// zero.
+//
+// Each frame completes hopSize() output samples. The last
+// frameSize() - hopSize() samples of a stream are written by flush()
+class InverseStft {
+  public:
+    // |hop_size| needs to be in [1, |frame_size|]
+    InverseStft(int frame_size, int hop_size, WindowFunction window = WindowFunction::Hann);
+    ~InverseStft() = default;
+
+    int frameSize() const { return plan_.size(); }
+    int hopSize() const { return hop_size_; }
+    int numBins() const { return plan_.numBins(); }
+
+    // Consumes |num_frames| frames of numBins() bins each from |spectra| and
+    // writes |num_frames| * hopSize() samples to |output|
+    void synthesize(const std::complex<float>* spectra, int32 num_frames, float* output);
+
+    // Writes the remaining frameSize() - hopSize() samples of the stream and
+    // resets the state for a new stream
+    void flush(float* output);
+
+    // Drops the pending overlap for synthesizing a new stream
+    void reset();
+
+  private:
+    const RealFftPlan<float>& plan_;
+    const int hop_size_;
+    // Window scaled by 1 / frameSize() for the unnormalized inverse transform
+    std::vector<float> window_;
+    std::vector<float> squared_window_;
+    // Lower bound of the window sums, which keeps the first samples finite
+    float min_weight_;
+    // Overlap-added frames and window sums for the next frameSize() samples
+    std::vector<float> sums_;
+    std::vector<float> weights_;
+    std::vector<float> frame_;
+
+    void emit(int count, float* output);
+
+    DISALLOW_COPY_AND_ASSIGN(InverseStft);
+};
+
+}  // namespace audio
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_AUDIO_STFT_H_
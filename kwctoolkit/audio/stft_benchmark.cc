@@ -0,0 +1,58 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "kwctoolkit/audio/stft.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// One second of audio at 48 kHz, passed in blocks of 480 samples
+constexpr kwc::int32 kNumSamples = 48000;
+constexpr kwc::int32 kBlockSize = 480;
+
+std::vector<float> MakeSignal() {
+    std::vector<float> signal(kNumSamples);
+    for (std::size_t idx = 0; idx < signal.size(); ++idx) {
+        signal[idx] = std::sin(0.05f * idx) + 0.5f * std::sin(0.31f * idx);
+    }
+    return signal;
+}
+}  // namespace
+
+// Items are input samples with a hop size of a quarter frame
+BENCHMARK(StftAnalyze) {
+    const int frame_size = static_cast<int>(context.arg());
+    kwc::audio::Stft stft(frame_size, frame_size / 4);
+    const auto signal = MakeSignal();
+    std::vector<std::complex<float>> spectra(
+        static_cast<std::size_t>(stft.numFrames(kBlockSize + frame_size)) * stft.numBins());
+    while (context.running()) {
+        for (kwc::int32 offset = 0; offset < kNumSamples; offset += kBlockSize) {
+            stft.analyze(signal.data() + offset, kBlockSize, spectra.data());
+        }
+        kwc::utils::DoNotOptimize(spectra.data());
+    }
+    context.setItemsProcessed(context.iterations() * kNumSamples);
+}
+BENCHMARK_CONFIGURE(StftAnalyze)->arg(256)->arg(1024)->arg(4096);
+
+// Items are output samples
+BENCHMARK(InverseStftSynthesize) {
+    const int frame_size = static_cast<int>(context.arg());
+    const int hop_size = frame_size / 4;
+    kwc::audio::InverseStft inverse(frame_size, hop_size);
+    const kwc::int32 num_frames = kNumSamples / hop_size;
+    const std::vector<std::complex<float>> spectra(
+        static_cast<std::size_t>(num_frames) * inverse.numBins(), 1.0f);
+    std::vector<float> output(static_cast<std::size_t>(num_frames) * hop_size);
+    while (context.running()) {
+        inverse.synthesize(spectra.data(), num_frames, output.data());
+        kwc::utils::DoNotOptimize(output.data());
+    }
+    context.setItemsProcessed(context.iterations() * num_frames * hop_size);
+}
+BENCHMARK_CONFIGURE(InverseStftSynthesize)->arg(256)->arg(1024)->arg(4096);
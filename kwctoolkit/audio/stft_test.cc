@@ -0,0 +1,157 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/audio/stft.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace kwc;
+using namespace kwc::audio;
+
+namespace {
+const WindowFunction kWindows[] = {WindowFunction::Hann, WindowFunction::Hamming,
+                                   WindowFunction::Blackman};
+
+std::vector<float> MakeSignal(int32 size) {
+    std::vector<float> signal(size);
+    for (int32 idx = 0; idx < size; ++idx) {
+        signal[idx] = static_cast<float>(0.5 * std::sin(0.031 * idx) +
+                                         0.25 * std::sin(0.7 * idx + std::cos(0.0013 * idx)));
+    }
+    return signal;
+}
+
+std::vector<std::complex<float>> Analyze(Stft* stft, const std::vector<float>& input,
+                                         int32 block_size) {
+    std::vector<std::complex<float>> spectra;
+    for (std::size_t offset = 0; offset < input.size(); offset += block_size) {
+        const int32 count = std::min(block_size, static_cast<int32>(input.size() - offset));
+        const std::size_t size = spectra.size();
+        spectra.resize(size + static_cast<std::size_t>(stft->numFrames(count)) * stft->numBins());
+        const int32 num_frames = stft->analyze(&input[offset], count, &spectra[size]);
+        EXPECT_EQ(static_cast<std::size_t>(num_frames) * stft->numBins(), spectra.size() - size);
+    }
+    return spectra;
+}
+
+std::vector<float> Synthesize(InverseStft* inverse,
+                              const std::vector<std::complex<float>>& spectra,
+                              int32 frames_per_block) {
+    const auto num_frames = static_cast<int32>(spectra.size() / inverse->numBins());
+    std::vector<float> output(static_cast<std::size_t>(num_frames) * inverse->hopSize() +
+                              inverse->frameSize() - inverse->hopSize());
+    for (int32 frame = 0; frame < num_frames; frame += frames_per_block) {
+        inverse->synthesize(&spectra[static_cast<std::size_t>(frame) * inverse->numBins()],
+                            std::min(frames_per_block, num_frames - frame),
+                            &output[static_cast<std::size_t>(frame) * inverse->hopSize()]);
+    }
+    inverse->flush(&output[static_cast<std::size_t>(num_frames) * inverse->hopSize()]);
+    return output;
+}
+}  // namespace
+
+TEST(StftTest, WindowsAreSymmetricAndOverlapAddToConstant) {
+    const int size = 480;
+    const struct {
+        WindowFunction function;
+        int hop_size;
+        double sum;
+    } kCases[] = {{WindowFunction::Hann, size / 2, 1.0},
+                  {WindowFunction::Hamming, size / 2, 1.08},
+                  {WindowFunction::Blackman, size / 3, 1.26}};
+    for (const auto& test_case : kCases) {
+        const auto window = MakeWindow(test_case.function, size);
+        EXPECT_NEAR(window[size / 2], 1.0f, 1e-6);
+        for (int idx = 1; idx < size; ++idx) {
+            EXPECT_EQ(window[idx], window[size - idx]) << "at " << idx;
+        }
+        for (int idx = 0; idx < test_case.hop_size; ++idx) {
+            double sum = 0.0;
+            for (int offset = idx; offset < size; offset += test_case.hop_size) {
+                sum += window[offset];
+            }
+            EXPECT_NEAR(sum, test_case.sum, 1e-6) << "at " << idx;
+        }
+    }
+    EXPECT_EQ(MakeWindow(WindowFunction::Hann, size)[0], 0.0f);
+    EXPECT_EQ(MakeWindow(WindowFunction::Blackman, size)[0], 0.0f);
+}
+
+TEST(StftTest, FramesMatchRealFFTOfWindowedInput) {
+    for (const int frame_size : {256, 255}) {
+        SCOPED_TRACE(frame_size);
+        const int hop_size = 100;
+        const auto input = MakeSignal(2000);
+        Stft stft(frame_size, hop_size, WindowFunction::Hamming);
+        EXPECT_EQ(stft.numFrames(2000), (2000 - frame_size) / hop_size + 1);
+        const auto spectra = Analyze(&stft, input, 2000);
+        ASSERT_EQ(spectra.size(), static_cast<std::size_t>(18 * stft.numBins()));
+
+        const auto window = MakeWindow(WindowFunction::Hamming, frame_size);
+        for (int frame = 0; frame < 18; ++frame) {
+            std::vector<float> windowed(frame_size);
+            for (int idx = 0; idx < frame_size; ++idx) {
+                windowed[idx] = input[frame * hop_size + idx] * window[idx];
+            }
+            const auto expected = RealFFT(windowed);
+            for (int bin = 0; bin < stft.numBins(); ++bin) {
+                const auto& actual = spectra[frame * stft.numBins() + bin];
+                EXPECT_NEAR(expected[bin].real(), actual.real(), 1e-4) << frame << ", " << bin;
+                EXPECT_NEAR(expected[bin].imag(), actual.imag(), 1e-4) << frame << ", " << bin;
+            }
+        }
+    }
+}
+
+TEST(StftTest, BlockSizeDoesNotChangeFrames) {
+    const auto input = MakeSignal(10000);
+    Stft stft(512, 128);
+    const auto expected = Analyze(&stft, input, static_cast<int32>(input.size()));
+    EXPECT_EQ(expected.size(), static_cast<std::size_t>(75 * stft.numBins()));
+    for (const int32 block_size : {1, 127, 512, 3000}) {
+        SCOPED_TRACE(block_size);
+        stft.reset();
+        EXPECT_EQ(expected, Analyze(&stft, input, block_size));
+    }
+}
+
+TEST(StftTest, InverseRestoresInput) {
+    const int sizes[][2] = {{1024, 256}, {1024, 300}, {1024, 512}, {999, 333}};
+    for (const auto window : kWindows) {
+        for (const auto& size : sizes) {
+            SCOPED_TRACE(static_cast<int>(window));
+            SCOPED_TRACE(size[0]);
+            SCOPED_TRACE(size[1]);
+            // A whole number of frames, such that the output covers the input
+            const int32 num_samples = size[0] + 20 * size[1];
+            const auto input = MakeSignal(num_samples);
+            Stft stft(size[0], size[1], window);
+            InverseStft inverse(size[0], size[1], window);
+            const auto output = Synthesize(&inverse, Analyze(&stft, input, 4096), 7);
+            ASSERT_EQ(output.size(), input.size());
+            // Leaves out the edges of the stream, where the window is close to
+            // zero and is the only one covering the samples
+            const int32 margin = size[0] / 16;
+            for (int32 idx = margin; idx < num_samples - margin; ++idx) {
+                ASSERT_NEAR(input[idx], output[idx], 1e-4) << "at " << idx;
+            }
+        }
+    }
+}
+
+TEST(StftTest, InverseBlockSizeDoesNotChangeOutput) {
+    Stft stft(256, 64, WindowFunction::Blackman);
+    const auto spectra = Analyze(&stft, MakeSignal(5000), 5000);
+    InverseStft inverse(256, 64, WindowFunction::Blackman);
+    const auto expected = Synthesize(&inverse, spectra, 1000);
+    for (const int32 frames_per_block : {1, 5, 16}) {
+        SCOPED_TRACE(frames_per_block);
+        EXPECT_EQ(expected, Synthesize(&inverse, spectra, frames_per_block));
+    }
+}
@@ -37,6 +37,9 @@
 // callback object has to be called repeatedly or several times, one should use
 // 'MakePermanentCallback'. Note that in the latter case, one has to take care
 // of the correct deletion of the callback in order to avoid memory leaks.
+// 'MakePooledCallback' takes the same arguments as 'MakeCallback', but
+// allocates the callback from a thread-caching pool (see callback_pool.h),
+// which pays off when many short-lived callbacks are created.
 //
 // There are two types of arguments which may be passed to the callback:
 //   - "pre-bound arguments" -> supplied when the callback is created
@@ -8,6 +8,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "kwctoolkit/base/callback_pool.h"
 #include "kwctoolkit/base/callback_types.h"
 
 namespace kwc {
@@ -79,6 +80,14 @@ inline typename ConstMemberResultCallback00<true, RetType, Caller>::base* MakeCa
     return new ConstMemberResultCallback00<true, RetType, Caller>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType>
+inline typename ConstMemberResultCallback00<true, RetType, Caller>::base* MakePooledCallback(
+    const Caller* instance,
+    RetType (Callee::*method)() const) {
+    return new internal::PooledCallback<ConstMemberResultCallback00<true, RetType, Caller>>(
+        instance, method);
+}
+
 template <typename Caller, typename Callee, typename RetType>
 inline typename ConstMemberResultCallback00<false, RetType, Caller>::base* MakePermanentCallback(
     const Caller* instance,
@@ -145,6 +154,14 @@ inline typename MemberResultCallback00<true, RetType, Caller>::base* MakeCallbac
     return new MemberResultCallback00<true, RetType, Caller>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType>
+inline typename MemberResultCallback00<true, RetType, Caller>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)()) {
+    return new internal::PooledCallback<MemberResultCallback00<true, RetType, Caller>>(instance,
+                                                                                       method);
+}
+
 template <typename Caller, typename Callee, typename RetType>
 inline typename MemberResultCallback00<false, RetType, Caller>::base* MakePermanentCallback(
     Caller* instance,
@@ -198,6 +215,12 @@ inline typename FunctionResultCallback00<true, RetType>::base* MakeCallback(RetT
     return new FunctionResultCallback00<true, RetType>(function);
 }
 
+template <typename RetType>
+inline typename FunctionResultCallback00<true, RetType>::base* MakePooledCallback(
+    RetType (*function)()) {
+    return new internal::PooledCallback<FunctionResultCallback00<true, RetType>>(function);
+}
+
 template <typename RetType>
 inline typename FunctionResultCallback00<false, RetType>::base* MakePermanentCallback(
     RetType (*function)()) {
@@ -265,6 +288,14 @@ inline typename ConstMemberResultCallback01<true, RetType, Caller, A1>::base* Ma
     return new ConstMemberResultCallback01<true, RetType, Caller, A1>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename A1>
+inline typename ConstMemberResultCallback01<true, RetType, Caller, A1>::base* MakePooledCallback(
+    const Caller* instance,
+    RetType (Callee::*method)(A1) const) {
+    return new internal::PooledCallback<ConstMemberResultCallback01<true, RetType, Caller, A1>>(
+        instance, method);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename A1>
 inline typename ConstMemberResultCallback01<false, RetType, Caller, A1>::base*
 MakePermanentCallback(const Caller* instance, RetType (Callee::*method)(A1) const) {
@@ -332,6 +363,14 @@ inline typename MemberResultCallback01<true, RetType, Caller, A1>::base* MakeCal
     return new MemberResultCallback01<true, RetType, Caller, A1>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename A1>
+inline typename MemberResultCallback01<true, RetType, Caller, A1>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(A1)) {
+    return new internal::PooledCallback<MemberResultCallback01<true, RetType, Caller, A1>>(instance,
+                                                                                           method);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename A1>
 inline typename MemberResultCallback01<false, RetType, Caller, A1>::base* MakePermanentCallback(
     Caller* instance,
@@ -386,6 +425,12 @@ inline typename FunctionResultCallback01<true, RetType, A1>::base* MakeCallback(
     return new FunctionResultCallback01<true, RetType, A1>(function);
 }
 
+template <typename RetType, typename A1>
+inline typename FunctionResultCallback01<true, RetType, A1>::base* MakePooledCallback(
+    RetType (*function)(A1)) {
+    return new internal::PooledCallback<FunctionResultCallback01<true, RetType, A1>>(function);
+}
+
 template <typename RetType, typename A1>
 inline typename FunctionResultCallback01<false, RetType, A1>::base* MakePermanentCallback(
     RetType (*function)(A1)) {
@@ -455,6 +500,13 @@ inline typename ConstMemberResultCallback02<true, RetType, Caller, A1, A2>::base
     return new ConstMemberResultCallback02<true, RetType, Caller, A1, A2>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename A1, typename A2>
+inline typename ConstMemberResultCallback02<true, RetType, Caller, A1, A2>::base*
+MakePooledCallback(const Caller* instance, RetType (Callee::*method)(A1, A2) const) {
+    return new internal::PooledCallback<ConstMemberResultCallback02<true, RetType, Caller, A1, A2>>(
+        instance, method);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename A1, typename A2>
 inline typename ConstMemberResultCallback02<false, RetType, Caller, A1, A2>::base*
 MakePermanentCallback(const Caller* instance, RetType (Callee::*method)(A1, A2) const) {
@@ -524,6 +576,14 @@ inline typename MemberResultCallback02<true, RetType, Caller, A1, A2>::base* Mak
     return new MemberResultCallback02<true, RetType, Caller, A1, A2>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename A1, typename A2>
+inline typename MemberResultCallback02<true, RetType, Caller, A1, A2>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(A1, A2)) {
+    return new internal::PooledCallback<MemberResultCallback02<true, RetType, Caller, A1, A2>>(
+        instance, method);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename A1, typename A2>
 inline typename MemberResultCallback02<false, RetType, Caller, A1, A2>::base* MakePermanentCallback(
     Caller* instance,
@@ -578,6 +638,12 @@ inline typename FunctionResultCallback02<true, RetType, A1, A2>::base* MakeCallb
     return new FunctionResultCallback02<true, RetType, A1, A2>(function);
 }
 
+template <typename RetType, typename A1, typename A2>
+inline typename FunctionResultCallback02<true, RetType, A1, A2>::base* MakePooledCallback(
+    RetType (*function)(A1, A2)) {
+    return new internal::PooledCallback<FunctionResultCallback02<true, RetType, A1, A2>>(function);
+}
+
 template <typename RetType, typename A1, typename A2>
 inline typename FunctionResultCallback02<false, RetType, A1, A2>::base* MakePermanentCallback(
     RetType (*function)(A1, A2)) {
@@ -649,6 +715,13 @@ inline typename ConstMemberResultCallback03<true, RetType, Caller, A1, A2, A3>::
     return new ConstMemberResultCallback03<true, RetType, Caller, A1, A2, A3>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename A1, typename A2, typename A3>
+inline typename ConstMemberResultCallback03<true, RetType, Caller, A1, A2, A3>::base*
+MakePooledCallback(const Caller* instance, RetType (Callee::*method)(A1, A2, A3) const) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback03<true, RetType, Caller, A1, A2, A3>>(instance, method);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename A1, typename A2, typename A3>
 inline typename ConstMemberResultCallback03<false, RetType, Caller, A1, A2, A3>::base*
 MakePermanentCallback(const Caller* instance, RetType (Callee::*method)(A1, A2, A3) const) {
@@ -720,6 +793,14 @@ inline typename MemberResultCallback03<true, RetType, Caller, A1, A2, A3>::base*
     return new MemberResultCallback03<true, RetType, Caller, A1, A2, A3>(instance, method);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename A1, typename A2, typename A3>
+inline typename MemberResultCallback03<true, RetType, Caller, A1, A2, A3>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(A1, A2, A3)) {
+    return new internal::PooledCallback<MemberResultCallback03<true, RetType, Caller, A1, A2, A3>>(
+        instance, method);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename A1, typename A2, typename A3>
 inline typename MemberResultCallback03<false, RetType, Caller, A1, A2, A3>::base*
 MakePermanentCallback(Caller* instance, RetType (Callee::*method)(A1, A2, A3)) {
@@ -773,6 +854,13 @@ inline typename FunctionResultCallback03<true, RetType, A1, A2, A3>::base* MakeC
     return new FunctionResultCallback03<true, RetType, A1, A2, A3>(function);
 }
 
+template <typename RetType, typename A1, typename A2, typename A3>
+inline typename FunctionResultCallback03<true, RetType, A1, A2, A3>::base* MakePooledCallback(
+    RetType (*function)(A1, A2, A3)) {
+    return new internal::PooledCallback<FunctionResultCallback03<true, RetType, A1, A2, A3>>(
+        function);
+}
+
 template <typename RetType, typename A1, typename A2, typename A3>
 inline typename FunctionResultCallback03<false, RetType, A1, A2, A3>::base* MakePermanentCallback(
     RetType (*function)(A1, A2, A3)) {
@@ -847,6 +935,15 @@ inline typename ConstMemberResultCallback10<true, RetType, Caller, P1>::base* Ma
     return new ConstMemberResultCallback10<true, RetType, Caller, P1>(instance, method, p1);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1>
+inline typename ConstMemberResultCallback10<true, RetType, Caller, P1>::base* MakePooledCallback(
+    const Caller* instance,
+    RetType (Callee::*method)(P1) const,
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<ConstMemberResultCallback10<true, RetType, Caller, P1>>(
+        instance, method, p1);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1>
 inline typename ConstMemberResultCallback10<false, RetType, Caller, P1>::base*
 MakePermanentCallback(const Caller* instance,
@@ -923,6 +1020,15 @@ inline typename MemberResultCallback10<true, RetType, Caller, P1>::base* MakeCal
     return new MemberResultCallback10<true, RetType, Caller, P1>(instance, method, p1);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1>
+inline typename MemberResultCallback10<true, RetType, Caller, P1>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(P1),
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<MemberResultCallback10<true, RetType, Caller, P1>>(
+        instance, method, p1);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1>
 inline typename MemberResultCallback10<false, RetType, Caller, P1>::base* MakePermanentCallback(
     Caller* instance,
@@ -983,6 +1089,13 @@ inline typename FunctionResultCallback10<true, RetType, P1>::base* MakeCallback(
     return new FunctionResultCallback10<true, RetType, P1>(function, p1);
 }
 
+template <typename RetType, typename P1>
+inline typename FunctionResultCallback10<true, RetType, P1>::base* MakePooledCallback(
+    RetType (*function)(P1),
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<FunctionResultCallback10<true, RetType, P1>>(function, p1);
+}
+
 template <typename RetType, typename P1>
 inline typename FunctionResultCallback10<false, RetType, P1>::base* MakePermanentCallback(
     RetType (*function)(P1),
@@ -1060,6 +1173,15 @@ inline typename ConstMemberResultCallback11<true, RetType, Caller, P1, A1>::base
     return new ConstMemberResultCallback11<true, RetType, Caller, P1, A1>(instance, method, p1);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename A1>
+inline typename ConstMemberResultCallback11<true, RetType, Caller, P1, A1>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, A1) const,
+                   typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<ConstMemberResultCallback11<true, RetType, Caller, P1, A1>>(
+        instance, method, p1);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename A1>
 inline typename ConstMemberResultCallback11<false, RetType, Caller, P1, A1>::base*
 MakePermanentCallback(const Caller* instance,
@@ -1138,6 +1260,15 @@ inline typename MemberResultCallback11<true, RetType, Caller, P1, A1>::base* Mak
     return new MemberResultCallback11<true, RetType, Caller, P1, A1>(instance, method, p1);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename A1>
+inline typename MemberResultCallback11<true, RetType, Caller, P1, A1>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(P1, A1),
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<MemberResultCallback11<true, RetType, Caller, P1, A1>>(
+        instance, method, p1);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename A1>
 inline typename MemberResultCallback11<false, RetType, Caller, P1, A1>::base* MakePermanentCallback(
     Caller* instance,
@@ -1198,6 +1329,14 @@ inline typename FunctionResultCallback11<true, RetType, P1, A1>::base* MakeCallb
     return new FunctionResultCallback11<true, RetType, P1, A1>(function, p1);
 }
 
+template <typename RetType, typename P1, typename A1>
+inline typename FunctionResultCallback11<true, RetType, P1, A1>::base* MakePooledCallback(
+    RetType (*function)(P1, A1),
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<FunctionResultCallback11<true, RetType, P1, A1>>(function,
+                                                                                         p1);
+}
+
 template <typename RetType, typename P1, typename A1>
 inline typename FunctionResultCallback11<false, RetType, P1, A1>::base* MakePermanentCallback(
     RetType (*function)(P1, A1),
@@ -1277,6 +1416,15 @@ inline typename ConstMemberResultCallback12<true, RetType, Caller, P1, A1, A2>::
     return new ConstMemberResultCallback12<true, RetType, Caller, P1, A1, A2>(instance, method, p1);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename A1, typename A2>
+inline typename ConstMemberResultCallback12<true, RetType, Caller, P1, A1, A2>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, A1, A2) const,
+                   typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback12<true, RetType, Caller, P1, A1, A2>>(instance, method, p1);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename A1, typename A2>
 inline typename ConstMemberResultCallback12<false, RetType, Caller, P1, A1, A2>::base*
 MakePermanentCallback(const Caller* instance,
@@ -1358,6 +1506,15 @@ inline typename MemberResultCallback12<true, RetType, Caller, P1, A1, A2>::base*
     return new MemberResultCallback12<true, RetType, Caller, P1, A1, A2>(instance, method, p1);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename A1, typename A2>
+inline typename MemberResultCallback12<true, RetType, Caller, P1, A1, A2>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(P1, A1, A2),
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<MemberResultCallback12<true, RetType, Caller, P1, A1, A2>>(
+        instance, method, p1);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename A1, typename A2>
 inline typename MemberResultCallback12<false, RetType, Caller, P1, A1, A2>::base*
 MakePermanentCallback(Caller* instance,
@@ -1418,6 +1575,14 @@ inline typename FunctionResultCallback12<true, RetType, P1, A1, A2>::base* MakeC
     return new FunctionResultCallback12<true, RetType, P1, A1, A2>(function, p1);
 }
 
+template <typename RetType, typename P1, typename A1, typename A2>
+inline typename FunctionResultCallback12<true, RetType, P1, A1, A2>::base* MakePooledCallback(
+    RetType (*function)(P1, A1, A2),
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<FunctionResultCallback12<true, RetType, P1, A1, A2>>(
+        function, p1);
+}
+
 template <typename RetType, typename P1, typename A1, typename A2>
 inline typename FunctionResultCallback12<false, RetType, P1, A1, A2>::base* MakePermanentCallback(
     RetType (*function)(P1, A1, A2),
@@ -1506,6 +1671,21 @@ MakeCallback(const Caller* instance,
                                                                                   p1);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename A1,
+          typename A2,
+          typename A3>
+inline typename ConstMemberResultCallback13<true, RetType, Caller, P1, A1, A2, A3>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, A1, A2, A3) const,
+                   typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback13<true, RetType, Caller, P1, A1, A2, A3>>(instance, method, p1);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -1601,6 +1781,21 @@ inline typename MemberResultCallback13<true, RetType, Caller, P1, A1, A2, A3>::b
     return new MemberResultCallback13<true, RetType, Caller, P1, A1, A2, A3>(instance, method, p1);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename A1,
+          typename A2,
+          typename A3>
+inline typename MemberResultCallback13<true, RetType, Caller, P1, A1, A2, A3>::base*
+MakePooledCallback(Caller* instance,
+                   RetType (Callee::*method)(P1, A1, A2, A3),
+                   typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<
+        MemberResultCallback13<true, RetType, Caller, P1, A1, A2, A3>>(instance, method, p1);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -1667,6 +1862,14 @@ inline typename FunctionResultCallback13<true, RetType, P1, A1, A2, A3>::base* M
     return new FunctionResultCallback13<true, RetType, P1, A1, A2, A3>(function, p1);
 }
 
+template <typename RetType, typename P1, typename A1, typename A2, typename A3>
+inline typename FunctionResultCallback13<true, RetType, P1, A1, A2, A3>::base* MakePooledCallback(
+    RetType (*function)(P1, A1, A2, A3),
+    typename internal::ConstRef<P1>::type p1) {
+    return new internal::PooledCallback<FunctionResultCallback13<true, RetType, P1, A1, A2, A3>>(
+        function, p1);
+}
+
 template <typename RetType, typename P1, typename A1, typename A2, typename A3>
 inline typename FunctionResultCallback13<false, RetType, P1, A1, A2, A3>::base*
 MakePermanentCallback(RetType (*function)(P1, A1, A2, A3),
@@ -1749,6 +1952,16 @@ inline typename ConstMemberResultCallback20<true, RetType, Caller, P1, P2>::base
     return new ConstMemberResultCallback20<true, RetType, Caller, P1, P2>(instance, method, p1, p2);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename P2>
+inline typename ConstMemberResultCallback20<true, RetType, Caller, P1, P2>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<ConstMemberResultCallback20<true, RetType, Caller, P1, P2>>(
+        instance, method, p1, p2);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename P2>
 inline typename ConstMemberResultCallback20<false, RetType, Caller, P1, P2>::base*
 MakePermanentCallback(const Caller* instance,
@@ -1834,6 +2047,16 @@ inline typename MemberResultCallback20<true, RetType, Caller, P1, P2>::base* Mak
     return new MemberResultCallback20<true, RetType, Caller, P1, P2>(instance, method, p1, p2);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename P2>
+inline typename MemberResultCallback20<true, RetType, Caller, P1, P2>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(P1, P2),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<MemberResultCallback20<true, RetType, Caller, P1, P2>>(
+        instance, method, p1, p2);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename P2>
 inline typename MemberResultCallback20<false, RetType, Caller, P1, P2>::base* MakePermanentCallback(
     Caller* instance,
@@ -1902,6 +2125,15 @@ inline typename FunctionResultCallback20<true, RetType, P1, P2>::base* MakeCallb
     return new FunctionResultCallback20<true, RetType, P1, P2>(function, p1, p2);
 }
 
+template <typename RetType, typename P1, typename P2>
+inline typename FunctionResultCallback20<true, RetType, P1, P2>::base* MakePooledCallback(
+    RetType (*function)(P1, P2),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<FunctionResultCallback20<true, RetType, P1, P2>>(function,
+                                                                                         p1, p2);
+}
+
 template <typename RetType, typename P1, typename P2>
 inline typename FunctionResultCallback20<false, RetType, P1, P2>::base* MakePermanentCallback(
     RetType (*function)(P1, P2),
@@ -1988,6 +2220,16 @@ inline typename ConstMemberResultCallback21<true, RetType, Caller, P1, P2, A1>::
                                                                               p2);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename A1>
+inline typename ConstMemberResultCallback21<true, RetType, Caller, P1, P2, A1>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2, A1) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback21<true, RetType, Caller, P1, P2, A1>>(instance, method, p1, p2);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename A1>
 inline typename ConstMemberResultCallback21<false, RetType, Caller, P1, P2, A1>::base*
 MakePermanentCallback(const Caller* instance,
@@ -2075,6 +2317,16 @@ inline typename MemberResultCallback21<true, RetType, Caller, P1, P2, A1>::base*
     return new MemberResultCallback21<true, RetType, Caller, P1, P2, A1>(instance, method, p1, p2);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename A1>
+inline typename MemberResultCallback21<true, RetType, Caller, P1, P2, A1>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(P1, P2, A1),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<MemberResultCallback21<true, RetType, Caller, P1, P2, A1>>(
+        instance, method, p1, p2);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename A1>
 inline typename MemberResultCallback21<false, RetType, Caller, P1, P2, A1>::base*
 MakePermanentCallback(Caller* instance,
@@ -2143,6 +2395,15 @@ inline typename FunctionResultCallback21<true, RetType, P1, P2, A1>::base* MakeC
     return new FunctionResultCallback21<true, RetType, P1, P2, A1>(function, p1, p2);
 }
 
+template <typename RetType, typename P1, typename P2, typename A1>
+inline typename FunctionResultCallback21<true, RetType, P1, P2, A1>::base* MakePooledCallback(
+    RetType (*function)(P1, P2, A1),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<FunctionResultCallback21<true, RetType, P1, P2, A1>>(
+        function, p1, p2);
+}
+
 template <typename RetType, typename P1, typename P2, typename A1>
 inline typename FunctionResultCallback21<false, RetType, P1, P2, A1>::base* MakePermanentCallback(
     RetType (*function)(P1, P2, A1),
@@ -2237,6 +2498,23 @@ MakeCallback(const Caller* instance,
                                                                                   p1, p2);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename A1,
+          typename A2>
+inline typename ConstMemberResultCallback22<true, RetType, Caller, P1, P2, A1, A2>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2, A1, A2) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback22<true, RetType, Caller, P1, P2, A1, A2>>(
+        instance, method, p1, p2);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -2339,6 +2617,22 @@ inline typename MemberResultCallback22<true, RetType, Caller, P1, P2, A1, A2>::b
                                                                              p2);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename A1,
+          typename A2>
+inline typename MemberResultCallback22<true, RetType, Caller, P1, P2, A1, A2>::base*
+MakePooledCallback(Caller* instance,
+                   RetType (Callee::*method)(P1, P2, A1, A2),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<
+        MemberResultCallback22<true, RetType, Caller, P1, P2, A1, A2>>(instance, method, p1, p2);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -2414,6 +2708,15 @@ inline typename FunctionResultCallback22<true, RetType, P1, P2, A1, A2>::base* M
     return new FunctionResultCallback22<true, RetType, P1, P2, A1, A2>(function, p1, p2);
 }
 
+template <typename RetType, typename P1, typename P2, typename A1, typename A2>
+inline typename FunctionResultCallback22<true, RetType, P1, P2, A1, A2>::base* MakePooledCallback(
+    RetType (*function)(P1, P2, A1, A2),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<FunctionResultCallback22<true, RetType, P1, P2, A1, A2>>(
+        function, p1, p2);
+}
+
 template <typename RetType, typename P1, typename P2, typename A1, typename A2>
 inline typename FunctionResultCallback22<false, RetType, P1, P2, A1, A2>::base*
 MakePermanentCallback(RetType (*function)(P1, P2, A1, A2),
@@ -2511,6 +2814,24 @@ MakeCallback(const Caller* instance,
         instance, method, p1, p2);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename A1,
+          typename A2,
+          typename A3>
+inline typename ConstMemberResultCallback23<true, RetType, Caller, P1, P2, A1, A2, A3>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2, A1, A2, A3) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback23<true, RetType, Caller, P1, P2, A1, A2, A3>>(
+        instance, method, p1, p2);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -2617,6 +2938,24 @@ MakeCallback(Caller* instance,
                                                                                  p1, p2);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename A1,
+          typename A2,
+          typename A3>
+inline typename MemberResultCallback23<true, RetType, Caller, P1, P2, A1, A2, A3>::base*
+MakePooledCallback(Caller* instance,
+                   RetType (Callee::*method)(P1, P2, A1, A2, A3),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<
+        MemberResultCallback23<true, RetType, Caller, P1, P2, A1, A2, A3>>(
+        instance, method, p1, p2);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -2699,6 +3038,15 @@ inline typename FunctionResultCallback23<true, RetType, P1, P2, A1, A2, A3>::bas
     return new FunctionResultCallback23<true, RetType, P1, P2, A1, A2, A3>(function, p1, p2);
 }
 
+template <typename RetType, typename P1, typename P2, typename A1, typename A2, typename A3>
+inline typename FunctionResultCallback23<true, RetType, P1, P2, A1, A2, A3>::base*
+MakePooledCallback(RetType (*function)(P1, P2, A1, A2, A3),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2) {
+    return new internal::PooledCallback<
+        FunctionResultCallback23<true, RetType, P1, P2, A1, A2, A3>>(function, p1, p2);
+}
+
 template <typename RetType, typename P1, typename P2, typename A1, typename A2, typename A3>
 inline typename FunctionResultCallback23<false, RetType, P1, P2, A1, A2, A3>::base*
 MakePermanentCallback(RetType (*function)(P1, P2, A1, A2, A3),
@@ -2790,6 +3138,18 @@ inline typename ConstMemberResultCallback30<true, RetType, Caller, P1, P2, P3>::
                                                                               p2, p3);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename P3>
+inline typename ConstMemberResultCallback30<true, RetType, Caller, P1, P2, P3>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2, P3) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback30<true, RetType, Caller, P1, P2, P3>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename P3>
 inline typename ConstMemberResultCallback30<false, RetType, Caller, P1, P2, P3>::base*
 MakePermanentCallback(const Caller* instance,
@@ -2884,6 +3244,17 @@ inline typename MemberResultCallback30<true, RetType, Caller, P1, P2, P3>::base*
                                                                          p3);
 }
 
+template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename P3>
+inline typename MemberResultCallback30<true, RetType, Caller, P1, P2, P3>::base* MakePooledCallback(
+    Caller* instance,
+    RetType (Callee::*method)(P1, P2, P3),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2,
+    typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<MemberResultCallback30<true, RetType, Caller, P1, P2, P3>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller, typename Callee, typename RetType, typename P1, typename P2, typename P3>
 inline typename MemberResultCallback30<false, RetType, Caller, P1, P2, P3>::base*
 MakePermanentCallback(Caller* instance,
@@ -2959,6 +3330,16 @@ inline typename FunctionResultCallback30<true, RetType, P1, P2, P3>::base* MakeC
     return new FunctionResultCallback30<true, RetType, P1, P2, P3>(function, p1, p2, p3);
 }
 
+template <typename RetType, typename P1, typename P2, typename P3>
+inline typename FunctionResultCallback30<true, RetType, P1, P2, P3>::base* MakePooledCallback(
+    RetType (*function)(P1, P2, P3),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2,
+    typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<FunctionResultCallback30<true, RetType, P1, P2, P3>>(
+        function, p1, p2, p3);
+}
+
 template <typename RetType, typename P1, typename P2, typename P3>
 inline typename FunctionResultCallback30<false, RetType, P1, P2, P3>::base* MakePermanentCallback(
     RetType (*function)(P1, P2, P3),
@@ -3059,6 +3440,24 @@ MakeCallback(const Caller* instance,
                                                                                   p1, p2, p3);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename P3,
+          typename A1>
+inline typename ConstMemberResultCallback31<true, RetType, Caller, P1, P2, P3, A1>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2, P3, A1) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback31<true, RetType, Caller, P1, P2, P3, A1>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -3167,6 +3566,24 @@ inline typename MemberResultCallback31<true, RetType, Caller, P1, P2, P3, A1>::b
                                                                              p2, p3);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename P3,
+          typename A1>
+inline typename MemberResultCallback31<true, RetType, Caller, P1, P2, P3, A1>::base*
+MakePooledCallback(Caller* instance,
+                   RetType (Callee::*method)(P1, P2, P3, A1),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        MemberResultCallback31<true, RetType, Caller, P1, P2, P3, A1>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -3248,6 +3665,16 @@ inline typename FunctionResultCallback31<true, RetType, P1, P2, P3, A1>::base* M
     return new FunctionResultCallback31<true, RetType, P1, P2, P3, A1>(function, p1, p2, p3);
 }
 
+template <typename RetType, typename P1, typename P2, typename P3, typename A1>
+inline typename FunctionResultCallback31<true, RetType, P1, P2, P3, A1>::base* MakePooledCallback(
+    RetType (*function)(P1, P2, P3, A1),
+    typename internal::ConstRef<P1>::type p1,
+    typename internal::ConstRef<P2>::type p2,
+    typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<FunctionResultCallback31<true, RetType, P1, P2, P3, A1>>(
+        function, p1, p2, p3);
+}
+
 template <typename RetType, typename P1, typename P2, typename P3, typename A1>
 inline typename FunctionResultCallback31<false, RetType, P1, P2, P3, A1>::base*
 MakePermanentCallback(RetType (*function)(P1, P2, P3, A1),
@@ -3351,6 +3778,25 @@ MakeCallback(const Caller* instance,
         instance, method, p1, p2, p3);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename P3,
+          typename A1,
+          typename A2>
+inline typename ConstMemberResultCallback32<true, RetType, Caller, P1, P2, P3, A1, A2>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2, P3, A1, A2) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback32<true, RetType, Caller, P1, P2, P3, A1, A2>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -3463,6 +3909,25 @@ MakeCallback(Caller* instance,
                                                                                  p1, p2, p3);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename P3,
+          typename A1,
+          typename A2>
+inline typename MemberResultCallback32<true, RetType, Caller, P1, P2, P3, A1, A2>::base*
+MakePooledCallback(Caller* instance,
+                   RetType (Callee::*method)(P1, P2, P3, A1, A2),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        MemberResultCallback32<true, RetType, Caller, P1, P2, P3, A1, A2>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -3551,6 +4016,16 @@ inline typename FunctionResultCallback32<true, RetType, P1, P2, P3, A1, A2>::bas
     return new FunctionResultCallback32<true, RetType, P1, P2, P3, A1, A2>(function, p1, p2, p3);
 }
 
+template <typename RetType, typename P1, typename P2, typename P3, typename A1, typename A2>
+inline typename FunctionResultCallback32<true, RetType, P1, P2, P3, A1, A2>::base*
+MakePooledCallback(RetType (*function)(P1, P2, P3, A1, A2),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        FunctionResultCallback32<true, RetType, P1, P2, P3, A1, A2>>(function, p1, p2, p3);
+}
+
 template <typename RetType, typename P1, typename P2, typename P3, typename A1, typename A2>
 inline typename FunctionResultCallback32<false, RetType, P1, P2, P3, A1, A2>::base*
 MakePermanentCallback(RetType (*function)(P1, P2, P3, A1, A2),
@@ -3664,6 +4139,26 @@ MakeCallback(const Caller* instance,
         instance, method, p1, p2, p3);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename P3,
+          typename A1,
+          typename A2,
+          typename A3>
+inline typename ConstMemberResultCallback33<true, RetType, Caller, P1, P2, P3, A1, A2, A3>::base*
+MakePooledCallback(const Caller* instance,
+                   RetType (Callee::*method)(P1, P2, P3, A1, A2, A3) const,
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        ConstMemberResultCallback33<true, RetType, Caller, P1, P2, P3, A1, A2, A3>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -3787,6 +4282,26 @@ MakeCallback(Caller* instance,
         instance, method, p1, p2, p3);
 }
 
+template <typename Caller,
+          typename Callee,
+          typename RetType,
+          typename P1,
+          typename P2,
+          typename P3,
+          typename A1,
+          typename A2,
+          typename A3>
+inline typename MemberResultCallback33<true, RetType, Caller, P1, P2, P3, A1, A2, A3>::base*
+MakePooledCallback(Caller* instance,
+                   RetType (Callee::*method)(P1, P2, P3, A1, A2, A3),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        MemberResultCallback33<true, RetType, Caller, P1, P2, P3, A1, A2, A3>>(
+        instance, method, p1, p2, p3);
+}
+
 template <typename Caller,
           typename Callee,
           typename RetType,
@@ -3884,6 +4399,22 @@ inline typename FunctionResultCallback33<true, RetType, P1, P2, P3, A1, A2, A3>:
                                                                                p3);
 }
 
+template <typename RetType,
+          typename P1,
+          typename P2,
+          typename P3,
+          typename A1,
+          typename A2,
+          typename A3>
+inline typename FunctionResultCallback33<true, RetType, P1, P2, P3, A1, A2, A3>::base*
+MakePooledCallback(RetType (*function)(P1, P2, P3, A1, A2, A3),
+                   typename internal::ConstRef<P1>::type p1,
+                   typename internal::ConstRef<P2>::type p2,
+                   typename internal::ConstRef<P3>::type p3) {
+    return new internal::PooledCallback<
+        FunctionResultCallback33<true, RetType, P1, P2, P3, A1, A2, A3>>(function, p1, p2, p3);
+}
+
 template <typename RetType,
           typename P1,
           typename P2,
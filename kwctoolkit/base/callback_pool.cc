@@ -0,0 +1,180 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/base/callback_pool.h"
+
+#include <mutex>
+#include <new>
+
+namespace kwc {
+namespace internal {
+namespace {
+constexpr std::size_t kNumSizeClasses = kMaxPooledCallbackSize / kCallbackSizeClassStep;
+
+// Number of blocks moved between a thread cache and the central free list at
+// once. A thread cache holds at most twice as many blocks per size class
+constexpr int kBatchSize = 32;
+constexpr int kMaxCachedBlocks = 2 * kBatchSize;
+
+// Size of the chunks requested from the global allocator once the central
+// free list of a size class runs empty
+constexpr std::size_t kChunkSize = 16 * 1024;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct FreeList {
+    FreeBlock* head;
+    int count;
+};
+
+struct CentralFreeList {
+    std::mutex mutex;
+    FreeList list;
+};
+
+// Intentionally leaked, callbacks may still be deleted during static
+// destruction
+CentralFreeList* CentralFreeLists() {
+    static auto* lists = new CentralFreeList[kNumSizeClasses]();
+    return lists;
+}
+
+// Trivially destructible, so it stays accessible until the thread exits.
+// |active| is set once the ThreadCacheReaper below has been registered for
+// the thread, |destroyed| once it has run
+struct ThreadCache {
+    FreeList lists[kNumSizeClasses];
+    bool active;
+    bool destroyed;
+};
+
+thread_local ThreadCache tls_cache;
+
+void Push(FreeList* list, FreeBlock* block) {
+    block->next = list->head;
+    list->head = block;
+    ++list->count;
+}
+
+FreeBlock* Pop(FreeList* list) {
+    FreeBlock* block = list->head;
+    list->head = block->next;
+    --list->count;
+    return block;
+}
+
+// Moves up to |max_count| blocks from |from| to |to|
+void Transfer(FreeList* from, FreeList* to, int max_count) {
+    for (int idx = 0; idx < max_count && from->head != nullptr; ++idx) {
+        Push(to, Pop(from));
+    }
+}
+
+// Returns all cached blocks of the exiting thread to the central free lists
+struct ThreadCacheReaper {
+    ~ThreadCacheReaper() {
+        tls_cache.active = false;
+        tls_cache.destroyed = true;
+        for (std::size_t cls = 0; cls < kNumSizeClasses; ++cls) {
+            CentralFreeList& central = CentralFreeLists()[cls];
+            std::lock_guard<std::mutex> guard(central.mutex);
+            Transfer(&tls_cache.lists[cls], &central.list, tls_cache.lists[cls].count);
+        }
+    }
+};
+
+thread_local ThreadCacheReaper tls_reaper;
+
+// Returns true if the calling thread may use its cache
+bool ActivateThreadCache() {
+    if (!tls_cache.active && !tls_cache.destroyed) {
+        static_cast<void>(&tls_reaper);
+        tls_cache.active = true;
+    }
+    return tls_cache.active;
+}
+
+std::size_t SizeClass(std::size_t size) {
+    return (size + kCallbackSizeClassStep - 1) / kCallbackSizeClassStep - 1;
+}
+
+// Carves a fresh chunk into blocks of size class |cls|. Chunks are never
+// released, their blocks are recycled through the free lists forever
+void Refill(FreeList* list, std::size_t cls) {
+    const std::size_t block_size = (cls + 1) * kCallbackSizeClassStep;
+    auto* chunk = static_cast<char*>(::operator new(kChunkSize));
+    for (std::size_t offset = 0; offset + block_size <= kChunkSize; offset += block_size) {
+        Push(list, reinterpret_cast<FreeBlock*>(chunk + offset));
+    }
+}
+
+void* AllocateSlow(std::size_t cls) {
+    CentralFreeList& central = CentralFreeLists()[cls];
+    std::lock_guard<std::mutex> guard(central.mutex);
+    if (central.list.head == nullptr) {
+        Refill(&central.list, cls);
+    }
+    if (!ActivateThreadCache()) {
+        // Thread is exiting, serve straight from the central free list
+        return Pop(&central.list);
+    }
+
+    FreeList* list = &tls_cache.lists[cls];
+    Transfer(&central.list, list, kBatchSize);
+    return Pop(list);
+}
+
+void FreeSlow(FreeBlock* block, std::size_t cls) {
+    CentralFreeList& central = CentralFreeLists()[cls];
+    if (!ActivateThreadCache()) {
+        std::lock_guard<std::mutex> guard(central.mutex);
+        Push(&central.list, block);
+        return;
+    }
+
+    FreeList* list = &tls_cache.lists[cls];
+    Push(list, block);
+    if (list->count > kMaxCachedBlocks) {
+        std::lock_guard<std::mutex> guard(central.mutex);
+        Transfer(list, &central.list, kBatchSize);
+    }
+}
+}  // namespace
+
+void* AllocateCallback(std::size_t size) {
+    if (size > kMaxPooledCallbackSize) {
+        return ::operator new(size);
+    }
+
+    // The cache is only ever filled by active threads, no need to check
+    const std::size_t cls = SizeClass(size);
+    FreeList* list = &tls_cache.lists[cls];
+    if (list->head != nullptr) {
+        return Pop(list);
+    }
+    return AllocateSlow(cls);
+}
+
+void FreeCallback(void* ptr, std::size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (size > kMaxPooledCallbackSize) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const std::size_t cls = SizeClass(size);
+    FreeList* list = &tls_cache.lists[cls];
+    if (tls_cache.active && list->count < kMaxCachedBlocks) {
+        Push(list, static_cast<FreeBlock*>(ptr));
+        return;
+    }
+    FreeSlow(static_cast<FreeBlock*>(ptr), cls);
+}
+
+}  // namespace internal
+}  // namespace kwc
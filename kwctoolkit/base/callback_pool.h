@@ -0,0 +1,53 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_BASE_CALLBACK_POOL_H_
+#define KWCTOOLKIT_BASE_CALLBACK_POOL_H_
+
+#include <cstddef>
+
+namespace kwc {
+namespace internal {
+
+// Thread-caching pool for callback objects
+//
+// Every MakeCallback() heap allocates a small closure, which deletes itself
+// right after it has been run. MakePooledCallback() takes the same arguments,
+// but allocates the closure from this pool instead, in order to keep this
+// churn away from the global allocator at high callback rates. Callbacks
+// created any other way keep using the global operator new and delete.
+//
+// The size class is selected from the size of the concrete callback type.
+// Callbacks of up to |kMaxPooledCallbackSize| bytes are served from a
+// per-thread free list without taking any lock. Only if that list runs empty
+// (or grows too long, e.g. when callbacks are created on one thread and run
+// on another) a batch of blocks is exchanged with a mutex protected central
+// free list. Larger callbacks fall back to the global operator new.
+//
+// Storage handed out by the pool is recycled, but never returned to the
+// system.
+constexpr std::size_t kCallbackSizeClassStep = 16;
+constexpr std::size_t kMaxPooledCallbackSize = 128;
+
+void* AllocateCallback(std::size_t size);
+
+// |size| must be the same value the storage was allocated with
+void FreeCallback(void* ptr, std::size_t size);
+
+// |CallbackImpl| allocated from the pool. As all callbacks have a virtual
+// destructor, deleting one through a pointer to its base class calls the
+// sized operator delete of this class with the size of this class
+template <typename CallbackImpl>
+class PooledCallback final : public CallbackImpl {
+  public:
+    using CallbackImpl::CallbackImpl;
+
+    static void* operator new(std::size_t size) { return AllocateCallback(size); }
+    static void operator delete(void* ptr, std::size_t size) { FreeCallback(ptr, size); }
+};
+
+}  // namespace internal
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_BASE_CALLBACK_POOL_H_
@@ -0,0 +1,63 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <vector>
+
+#include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// Number of callbacks created per iteration of the batched benchmarks
+constexpr int kNumCallbacks = 256;
+
+void Accumulate(kwc::uint64* sink, kwc::uint64 value) {
+    *sink += value;
+}
+
+// Keeps the compiler from optimizing the pointer away
+kwc::Callback* volatile callback_sink;
+}  // namespace
+
+BENCHMARK(OneShotClosureNewDelete) {
+    kwc::uint64 sink = 0;
+    while (context.running()) {
+        callback_sink = kwc::MakeCallback(&Accumulate, &sink, kwc::uint64(1));
+        callback_sink->run();
+    }
+}
+
+BENCHMARK(OneShotClosurePooled) {
+    kwc::uint64 sink = 0;
+    while (context.running()) {
+        callback_sink = kwc::MakePooledCallback(&Accumulate, &sink, kwc::uint64(1));
+        callback_sink->run();
+    }
+}
+
+BENCHMARK(BatchedClosuresNewDelete) {
+    kwc::uint64 sink = 0;
+    std::vector<kwc::Callback*> callbacks(kNumCallbacks);
+    while (context.running()) {
+        for (auto& callback : callbacks) {
+            callback = kwc::MakeCallback(&Accumulate, &sink, kwc::uint64(1));
+        }
+        for (auto* callback : callbacks) {
+            callback->run();
+        }
+    }
+}
+
+BENCHMARK(BatchedClosuresPooled) {
+    kwc::uint64 sink = 0;
+    std::vector<kwc::Callback*> callbacks(kNumCallbacks);
+    while (context.running()) {
+        for (auto& callback : callbacks) {
+            callback = kwc::MakePooledCallback(&Accumulate, &sink, kwc::uint64(1));
+        }
+        for (auto* callback : callbacks) {
+            callback->run();
+        }
+    }
+}
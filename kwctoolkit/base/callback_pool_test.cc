@@ -0,0 +1,121 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/base/callback_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "kwctoolkit/base/callback.h"
+
+using namespace kwc::internal;
+
+namespace {
+void Increment(std::atomic<int>* counter) {
+    counter->fetch_add(1);
+}
+
+int Add(int lhs, int rhs) {
+    return lhs + rhs;
+}
+
+// Callback implementing two callback interfaces, allocated the default way
+class TwoInterfaces : public kwc::Callback, public kwc::Callback1<int> {
+  public:
+    explicit TwoInterfaces(int* sum) : sum_(sum) {}
+
+    void run() override { ++*sum_; }
+    void run(int value) override { *sum_ += value; }
+
+  private:
+    int* sum_;
+};
+}  // namespace
+
+TEST(CallbackPoolTest, RecyclesStorageOfTheSameSizeClass) {
+    void* first = AllocateCallback(24);
+    FreeCallback(first, 24);
+    void* second = AllocateCallback(32);
+    EXPECT_EQ(first, second);
+    FreeCallback(second, 32);
+}
+
+TEST(CallbackPoolTest, BlocksAreDisjointAndAligned) {
+    std::vector<char*> blocks;
+    std::set<char*> unique_blocks;
+    for (int idx = 0; idx < 1000; ++idx) {
+        auto* block = static_cast<char*>(AllocateCallback(kMaxPooledCallbackSize));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % kCallbackSizeClassStep, 0u);
+        block[0] = 1;
+        block[kMaxPooledCallbackSize - 1] = 1;
+        blocks.push_back(block);
+        unique_blocks.insert(block);
+    }
+    EXPECT_EQ(unique_blocks.size(), blocks.size());
+    for (auto* block : blocks) {
+        FreeCallback(block, kMaxPooledCallbackSize);
+    }
+}
+
+TEST(CallbackPoolTest, LargeAllocationsBypassThePool) {
+    void* block = AllocateCallback(kMaxPooledCallbackSize + 1);
+    ASSERT_NE(block, nullptr);
+    FreeCallback(block, kMaxPooledCallbackSize + 1);
+}
+
+TEST(CallbackPoolTest, PooledCallbacksReuseTheirStorage) {
+    std::atomic<int> counter{0};
+    kwc::Callback* first = kwc::MakePooledCallback(&Increment, &counter);
+    const void* storage = first;
+    first->run();
+    kwc::Callback* second = kwc::MakePooledCallback(&Increment, &counter);
+    EXPECT_EQ(storage, second);
+    second->run();
+    EXPECT_EQ(counter.load(), 2);
+
+    kwc::ResultCallback1<int, int>* add = kwc::MakePooledCallback(&Add, 1);
+    EXPECT_FALSE(add->isRepeatable());
+    EXPECT_EQ(add->run(2), 3);
+}
+
+TEST(CallbackPoolTest, OtherCallbacksUseTheGlobalAllocator) {
+    int sum = 0;
+    auto* callback = new TwoInterfaces(&sum);
+    static_cast<kwc::Callback*>(callback)->run();
+    static_cast<kwc::Callback1<int>*>(callback)->run(2);
+    EXPECT_EQ(sum, 3);
+    delete static_cast<kwc::Callback1<int>*>(callback);
+
+    std::atomic<int> counter{0};
+    kwc::MakeCallback(&Increment, &counter)->run();
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(CallbackPoolTest, CallbacksMayBeRunOnAnotherThread) {
+    constexpr int kNumCallbacks = 10000;
+    std::atomic<int> counter{0};
+    std::vector<kwc::Callback*> callbacks;
+    for (int idx = 0; idx < kNumCallbacks; ++idx) {
+        callbacks.push_back(kwc::MakePooledCallback(&Increment, &counter));
+    }
+
+    std::thread runner([&callbacks] {
+        for (auto* callback : callbacks) {
+            callback->run();
+        }
+    });
+    runner.join();
+    EXPECT_EQ(counter.load(), kNumCallbacks);
+
+    // Blocks returned by the exited thread are available again
+    for (int idx = 0; idx < kNumCallbacks; ++idx) {
+        kwc::MakePooledCallback(&Increment, &counter)->run();
+    }
+    EXPECT_EQ(counter.load(), 2 * kNumCallbacks);
+}
@@ -133,6 +133,16 @@
     #define KWC_GUARDED_BY(x)
 #endif
 
+// Compile a single function for an instruction set extension, which isn't
+// enabled for the whole translation unit, e.g. KWC_TARGET_ATTRIBUTE("avx2").
+// Callers need to check for support at runtime first, see system::CPU. MSVC
+// allows intrinsics of any extension without such an attribute
+#if defined(KWC_COMPILER_GCC) && defined(KWC_ARCH_CPU_X86_FAMILY)
+    #define KWC_TARGET_ATTRIBUTE(arch) __attribute__((target(arch)))
+#else
+    #define KWC_TARGET_ATTRIBUTE(arch)
+#endif
+
 // Ensure that restrict is available
 #if defined(KWC_COMPILER_MSVC)
     #define KWC_RESTRICT __restrict
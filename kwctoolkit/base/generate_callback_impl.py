@@ -205,7 +205,7 @@ class ACallback:
                          self.method_signature(from_result_cb), self.ctor(),
                          self.run_method(from_result_cb), self.class_members())
 
-    def api(self, deletable):
+    def api(self, deletable, pooled=False):
         delete = "false"
         cb_fn = "MakePermanentCallback"
         caller = "RetType (*function)"
@@ -234,7 +234,7 @@ class ACallback:
             cb_sig = "RetType (*function)(%s)" % cb_params
         if deletable:
             delete = "true"
-            cb_fn = "MakeCallback"
+            cb_fn = "MakePooledCallback" if pooled else "MakeCallback"
         temp_decl, templ_spec = [], [delete, "RetType"]
         if not self.kind() is CallbackKind.Function:
             temp_decl.append("typename Caller, typename Callee")
@@ -249,20 +249,23 @@ class ACallback:
         if self.num_ct_args:
             temp_decl.append(make_enum("typename A%d", self.num_ct_args))
             templ_spec.append(make_enum("A%d", self.num_ct_args))
+        cb_type = "%s<%s>" % (self.name(), ", ".join(templ_spec))
+        new_type = "internal::PooledCallback<%s>" % cb_type if pooled else cb_type
         cb_call = """
         template <%s>
-        inline typename %s<%s>::base* %s(%s %s) {
-            return new %s<%s>(%s);
+        inline typename %s::base* %s(%s %s) {
+            return new %s(%s);
         }
-        """ % (", ".join(temp_decl), self.name(), ", ".join(templ_spec), cb_fn,
-               cb_sig, pb_args, self.name(), ", ".join(templ_spec), cb_args)
+        """ % (", ".join(temp_decl), cb_type, cb_fn, cb_sig, pb_args, new_type,
+               cb_args)
         return cb_call
 
     def serialize(self, out_handle):
         for t in [True, False]:
             out_handle.write(self.generate(t))
-        for t in [True, False]:
-            out_handle.write(self.api(t))
+        out_handle.write(self.api(True))
+        out_handle.write(self.api(True, pooled=True))
+        out_handle.write(self.api(False))
 
     def compound_type(self):
         return "typename ::std::enable_if<::std::is_compound<Class>::value>::type"
@@ -417,7 +420,9 @@ if __name__ == "__main__":
         write_copyright_header(f)
         f.write("#ifndef KWCTOOLKIT_BASE_CALLBACK_IMPL_H_\n"
                 "#define KWCTOOLKIT_BASE_CALLBACK_IMPL_H_\n\n"
-                "#include <type_traits>\n#include \"kwctoolkit/base/%s\"\n\n" %
+                "#include <type_traits>\n"
+                "#include \"kwctoolkit/base/callback_pool.h\"\n"
+                "#include \"kwctoolkit/base/%s\"\n\n" %
                 args.cb_types_filename)
         f.write("namespace kwc {\nnamespace internal {\n\n"
                 "template <typename T> struct ConstRef {\n"
@@ -0,0 +1,39 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <memory>
+
+#include "kwctoolkit/base/ref_count.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+class Counted : public kwc::base::RefCount {};
+
+struct Plain {};
+}  // namespace
+
+BENCHMARK(RefCopy) {
+    auto ref = kwc::base::AcquireRef(new Counted());
+    while (context.running()) {
+        kwc::base::Ref<Counted> copy(ref);
+        kwc::utils::DoNotOptimize(copy);
+    }
+}
+
+BENCHMARK(SharedPtrCopy) {
+    auto ptr = std::make_shared<Plain>();
+    while (context.running()) {
+        std::shared_ptr<Plain> copy(ptr);
+        kwc::utils::DoNotOptimize(copy);
+    }
+}
+
+// All threads copy the same reference, i.e. contend on a single count
+BENCHMARK_THREADS(RefCopyContended, 0) {
+    static const auto ref = kwc::base::AcquireRef(new Counted());
+    while (context.running()) {
+        kwc::base::Ref<Counted> copy(ref);
+        kwc::utils::DoNotOptimize(copy);
+    }
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_BASE_UNIQUE_FUNCTION_H_
+#define KWCTOOLKIT_BASE_UNIQUE_FUNCTION_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "kwctoolkit/base/assert.h"
+
+namespace kwc {
+namespace internal {
+
+template <typename F, typename R, typename... Args>
+struct IsCallableAs {
+  private:
+    template <typename G>
+    static auto check(int)
+        -> decltype(std::declval<G&>()(std::declval<Args>()...), std::true_type());
+    template <typename G>
+    static std::false_type check(...);
+
+    template <typename G, bool = decltype(check<G>(0))::value>
+    struct Result : std::false_type {};
+    template <typename G>
+    struct Result<G, true>
+        : std::integral_constant<
+              bool,
+              std::is_void<R>::value ||
+                  std::is_convertible<decltype(std::declval<G&>()(std::declval<Args>()...)),
+                                      R>::value> {};
+
+  public:
+    static constexpr bool value = Result<F>::value;
+};
+}  // namespace internal
+
+template <typename Signature>
+class UniqueFunction;
+
+// Move-only type-erased function with small buffer optimization
+//
+// Unlike the generated Callback hierarchy (see callback.h), which costs one
+// heap allocation per bound closure, UniqueFunction stores callables of up to
+// |kInlineSize| bytes inside the object itself. Only larger captures (or
+// callables which may throw when being moved) are placed on the heap. As it
+// is move-only, it may own move-only state like std::unique_ptr, which
+// std::function can't.
+//
+// Example:
+//
+//     std::unique_ptr<Data> data = ...;
+//     UniqueFunction<int(int)> fn = [data = std::move(data)](int x) {
+//         return data->process(x);
+//     };
+//     int result = fn(23);
+//
+// Invoking an empty UniqueFunction is a programming error.
+template <typename R, typename... Args>
+class UniqueFunction<R(Args...)> {
+  public:
+    static constexpr std::size_t kInlineSize = 48;
+
+    UniqueFunction() noexcept = default;
+
+    template <typename F,
+              typename Fn = typename std::decay<F>::type,
+              typename = typename std::enable_if<
+                  !std::is_same<Fn, UniqueFunction>::value &&
+                  internal::IsCallableAs<Fn, R, Args...>::value>::type>
+    UniqueFunction(F&& fn) {
+        construct<Fn>(std::forward<F>(fn), std::integral_constant<bool, storedInline<Fn>()>());
+    }
+
+    UniqueFunction(UniqueFunction&& other) noexcept { moveFrom(&other); }
+
+    UniqueFunction& operator=(UniqueFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(&other);
+        }
+        return *this;
+    }
+
+    ~UniqueFunction() { reset(); }
+
+    R operator()(Args... args) {
+        KWC_ASSERT(invoke_ != nullptr);
+        return invoke_(&storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+    // Destroys the stored callable, if any
+    void reset() noexcept {
+        if (manage_ != nullptr) {
+            manage_(Operation::Destroy, &storage_, nullptr);
+        }
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+    // Whether a callable of type F would be stored without heap allocation
+    template <typename F>
+    static constexpr bool storedInline() {
+        return sizeof(F) <= kInlineSize && alignof(F) <= alignof(Storage) &&
+               std::is_nothrow_move_constructible<F>::value;
+    }
+
+  private:
+    enum class Operation { Move, Destroy };
+
+    using Storage = typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type;
+    using Invoker = R (*)(void* storage, Args&&... args);
+    using Manager = void (*)(Operation operation, void* storage, void* target);
+
+    template <typename F>
+    static R InvokeInline(void* storage, Args&&... args) {
+        return static_cast<R>((*static_cast<F*>(storage))(std::forward<Args>(args)...));
+    }
+
+    template <typename F>
+    static R InvokeHeap(void* storage, Args&&... args) {
+        return static_cast<R>((**static_cast<F**>(storage))(std::forward<Args>(args)...));
+    }
+
+    template <typename F>
+    static void ManageInline(Operation operation, void* storage, void* target) {
+        auto* fn = static_cast<F*>(storage);
+        if (operation == Operation::Move) {
+            new (target) F(std::move(*fn));
+        }
+        fn->~F();
+    }
+
+    template <typename F>
+    static void ManageHeap(Operation operation, void* storage, void* target) {
+        auto** fn = static_cast<F**>(storage);
+        if (operation == Operation::Move) {
+            *static_cast<F**>(target) = *fn;
+        } else {
+            delete *fn;
+        }
+    }
+
+    template <typename F, typename G>
+    void construct(G&& fn, std::true_type /*inline*/) {
+        new (&storage_) F(std::forward<G>(fn));
+        invoke_ = &InvokeInline<F>;
+        manage_ = &ManageInline<F>;
+    }
+
+    template <typename F, typename G>
+    void construct(G&& fn, std::false_type /*inline*/) {
+        *reinterpret_cast<F**>(&storage_) = new F(std::forward<G>(fn));
+        invoke_ = &InvokeHeap<F>;
+        manage_ = &ManageHeap<F>;
+    }
+
+    void moveFrom(UniqueFunction* other) noexcept {
+        if (other->manage_ != nullptr) {
+            other->manage_(Operation::Move, &other->storage_, &storage_);
+        }
+        invoke_ = other->invoke_;
+        manage_ = other->manage_;
+        other->invoke_ = nullptr;
+        other->manage_ = nullptr;
+    }
+
+    Storage storage_;
+    Invoker invoke_ = nullptr;
+    Manager manage_ = nullptr;
+};
+
+template <typename R, typename... Args>
+constexpr std::size_t UniqueFunction<R(Args...)>::kInlineSize;
+
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_BASE_UNIQUE_FUNCTION_H_
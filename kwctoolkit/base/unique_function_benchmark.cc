@@ -0,0 +1,49 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <functional>
+
+#include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/unique_function.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+void Accumulate(kwc::uint64* sink, kwc::uint64 value) {
+    *sink += value;
+}
+}  // namespace
+
+// One-shot closures binding two arguments, created and run right away
+BENCHMARK(OneShotMakeCallback) {
+    kwc::uint64 sink = 0;
+    while (context.running()) {
+        kwc::MakeCallback(&Accumulate, &sink, kwc::uint64(1))->run();
+    }
+}
+
+BENCHMARK(OneShotStdFunction) {
+    kwc::uint64 sink = 0;
+    kwc::uint64 value = 1;
+    while (context.running()) {
+        // Three pointers exceed the inline buffer of common implementations
+        std::function<void()> fn = [&sink, value, &context] {
+            Accumulate(&sink, value);
+            static_cast<void>(context);
+        };
+        fn();
+    }
+}
+
+BENCHMARK(OneShotUniqueFunction) {
+    kwc::uint64 sink = 0;
+    kwc::uint64 value = 1;
+    while (context.running()) {
+        kwc::UniqueFunction<void()> fn = [&sink, value, &context] {
+            Accumulate(&sink, value);
+            static_cast<void>(context);
+        };
+        fn();
+    }
+}
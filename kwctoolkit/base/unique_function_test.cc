@@ -0,0 +1,109 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/base/unique_function.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+
+using kwc::UniqueFunction;
+
+namespace {
+int Add(int lhs, int rhs) {
+    return lhs + rhs;
+}
+
+// Counts the number of live instances to verify proper destruction
+struct Tracked {
+    explicit Tracked(int* live) : live_(live) { ++*live_; }
+    Tracked(const Tracked& other) : live_(other.live_) { ++*live_; }
+    ~Tracked() { --*live_; }
+    void operator()() const {}
+
+    int* live_;
+};
+}  // namespace
+
+TEST(UniqueFunctionTest, DefaultConstructedIsEmpty) {
+    UniqueFunction<void()> fn;
+    EXPECT_FALSE(fn);
+}
+
+TEST(UniqueFunctionTest, CallsFreeFunction) {
+    UniqueFunction<int(int, int)> fn = &Add;
+    ASSERT_TRUE(fn);
+    EXPECT_EQ(fn(17, 4), 21);
+}
+
+TEST(UniqueFunctionTest, CallsLambdaWithCaptures) {
+    int base = 10;
+    UniqueFunction<int(int)> fn = [&base](int value) { return base + value; };
+    EXPECT_EQ(fn(5), 15);
+    base = 20;
+    EXPECT_EQ(fn(5), 25);
+}
+
+TEST(UniqueFunctionTest, OwnsMoveOnlyState) {
+    auto text = std::make_unique<std::string>("foo");
+    UniqueFunction<std::string()> fn = [text = std::move(text)] { return *text + "bar"; };
+    EXPECT_EQ(fn(), "foobar");
+}
+
+TEST(UniqueFunctionTest, SmallCapturesAreStoredInline) {
+    using Function = UniqueFunction<void()>;
+    struct Small {
+        void operator()() const {}
+        char data[Function::kInlineSize];
+    };
+    struct Large {
+        void operator()() const {}
+        char data[Function::kInlineSize + 1];
+    };
+    EXPECT_TRUE(Function::storedInline<Small>());
+    EXPECT_FALSE(Function::storedInline<Large>());
+}
+
+TEST(UniqueFunctionTest, LargeCapturesWork) {
+    std::array<int, 64> values;
+    values.fill(1);
+    UniqueFunction<int()> fn = [values] {
+        int sum = 0;
+        for (auto value : values) {
+            sum += value;
+        }
+        return sum;
+    };
+    UniqueFunction<int()> moved = std::move(fn);
+    EXPECT_FALSE(fn);
+    EXPECT_EQ(moved(), 64);
+}
+
+TEST(UniqueFunctionTest, MoveTransfersOwnership) {
+    int live = 0;
+    {
+        UniqueFunction<void()> fn = Tracked(&live);
+        EXPECT_EQ(live, 1);
+        UniqueFunction<void()> other = std::move(fn);
+        EXPECT_EQ(live, 1);
+        EXPECT_FALSE(fn);
+        ASSERT_TRUE(other);
+
+        fn = std::move(other);
+        EXPECT_EQ(live, 1);
+        fn.reset();
+        EXPECT_EQ(live, 0);
+        EXPECT_FALSE(fn);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(UniqueFunctionTest, ForwardsArgumentsWithoutCopies) {
+    UniqueFunction<std::size_t(std::unique_ptr<std::string>)> fn =
+        [](std::unique_ptr<std::string> text) { return text->size(); };
+    EXPECT_EQ(fn(std::make_unique<std::string>("abc")), 3u);
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <string>
+#include <vector>
+
+#include "kwctoolkit/file/file.h"
+#include "kwctoolkit/file/file_enumerator.h"
+#include "kwctoolkit/file/file_utils.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+constexpr int kNumDirectories = 8;
+constexpr int kFilesPerDirectory = 64;
+
+// Temporary directory tree, created before and removed after every run
+class DirectoryTree : public kwc::utils::Benchmark {
+  protected:
+    void setUp() override {
+        root_ = kwc::file::GetTempDir().append("kwc-file-enumerator-benchmark");
+        createDirectory(root_);
+        for (int dir = 0; dir < kNumDirectories; ++dir) {
+            const auto directory = root_.append("dir" + std::to_string(dir));
+            createDirectory(directory);
+            for (int file = 0; file < kFilesPerDirectory; ++file) {
+                const auto path = directory.append("file" + std::to_string(file) + ".txt");
+                kwc::file::WriteFile(path, std::string("x"));
+                created_.push_back(path);
+            }
+        }
+    }
+
+    void tearDown() override {
+        // Files before the directories containing them
+        for (auto it = created_.rbegin(); it != created_.rend(); ++it) {
+            kwc::file::File::remove(*it);
+        }
+        created_.clear();
+    }
+
+    int numEntries() const { return static_cast<int>(created_.size()); }
+
+    kwc::file::FilePath root_;
+
+  private:
+    void createDirectory(const kwc::file::FilePath& path) {
+        kwc::file::CreateDirectory(path);
+        created_.push_back(path);
+    }
+
+    std::vector<kwc::file::FilePath> created_;
+};
+}  // namespace
+
+BENCHMARK_F(DirectoryTree, FileEnumerator) {
+    int num_found = 0;
+    while (context.running()) {
+        kwc::file::FileEnumerator enumerator(
+            root_, true, kwc::file::FileType::FILES | kwc::file::FileType::DIRECTORIES);
+        while (!enumerator.next().value().empty()) {
+            ++num_found;
+        }
+    }
+    kwc::utils::DoNotOptimize(num_found);
+    // The root itself is not reported
+    context.setItemsProcessed(context.iterations() * (numEntries() - 1));
+}
@@ -0,0 +1,35 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "tests/assets.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/file/file_path.h"
+#include "kwctoolkit/file/file_utils.h"
+#include "kwctoolkit/image/png_decoder.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+std::vector<kwc::uint8> ReadAsset(const char* name) {
+    std::vector<kwc::uint8> data;
+    if (!kwc::file::ReadFile(kwc::file::FilePath(kwc::kAssetsPath).append(name), data)) {
+        std::cerr << "Failed to read " << name << " from " << kwc::kAssetsPath << std::endl;
+        std::abort();
+    }
+    return data;
+}
+}  // namespace
+
+// Throughput is given in encoded bytes
+BENCHMARK(ReadPNG) {
+    const auto data = ReadAsset("basket_rgb.png");
+    while (context.running()) {
+        auto result = kwc::image::ReadPNG(data, kwc::image::MODE_RGB);
+        kwc::utils::DoNotOptimize(result);
+    }
+    context.setBytesProcessed(context.iterations() * static_cast<kwc::int64>(data.size()));
+}
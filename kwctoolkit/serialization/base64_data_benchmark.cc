@@ -0,0 +1,86 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "kwctoolkit/serialization/data_reader.h"
+#include "kwctoolkit/serialization/data_writer.h"
+#include "kwctoolkit/utils/base64.h"
+#include "kwctoolkit/utils/benchmark.h"
+#include "tests/random_data.h"
+
+namespace {
+// Four MiB of data, passed in chunks of |context.arg()| bytes
+constexpr kwc::int64 kDataSize = 1 << 22;
+
+std::string MakeData() {
+    return kwc::test::RandomBytes(kDataSize, 0x12345678);
+}
+}  // namespace
+
+BENCHMARK(Base64EncodingDataWriter) {
+    const std::string data = MakeData();
+    std::string encoded;
+    std::unique_ptr<kwc::serialization::DataWriter> destination(
+        kwc::serialization::CreateStringDataWriter(&encoded));
+    std::unique_ptr<kwc::serialization::DataWriter> writer(
+        kwc::serialization::CreateBase64EncodingDataWriter(destination.get()));
+    while (context.running()) {
+        writer->begin();
+        for (kwc::int64 offset = 0; offset < kDataSize; offset += context.arg()) {
+            writer->writeData(std::min(context.arg(), kDataSize - offset), data.data() + offset);
+        }
+        writer->end();
+        kwc::utils::DoNotOptimize(encoded);
+    }
+    context.setBytesProcessed(context.iterations() * kDataSize);
+}
+BENCHMARK_CONFIGURE(Base64EncodingDataWriter)->arg(1000)->arg(1 << 16);
+
+BENCHMARK(Base64DecodingDataReader) {
+    const std::string data = MakeData();
+    const std::string encoded = kwc::utils::Base64Encode(
+        reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    std::unique_ptr<kwc::serialization::DataReader> source(
+        kwc::serialization::CreateUnmanagedInMemoryDataReader(encoded));
+    std::unique_ptr<kwc::serialization::DataReader> reader(
+        kwc::serialization::CreateUnmanagedBase64DecodingDataReader(source.get()));
+    std::string buffer(static_cast<std::size_t>(context.arg()), '\0');
+    while (context.running()) {
+        reader->reset();
+        while (!reader->isDone()) {
+            reader->readIntoBuffer(context.arg(), &buffer[0]);
+        }
+        kwc::utils::DoNotOptimize(buffer);
+    }
+    context.setBytesProcessed(context.iterations() * kDataSize);
+}
+BENCHMARK_CONFIGURE(Base64DecodingDataReader)->arg(1000)->arg(1 << 16);
+
+// Attachment as in MIME, with lines of |context.arg()| characters
+BENCHMARK(Base64DecodingDataReaderLines) {
+    const std::string data = MakeData();
+    const std::string encoded = kwc::utils::Base64Encode(
+        reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    std::string lines;
+    for (std::size_t offset = 0; offset < encoded.size(); offset += context.arg()) {
+        lines += encoded.substr(offset, context.arg()) + "\r\n";
+    }
+    std::unique_ptr<kwc::serialization::DataReader> source(
+        kwc::serialization::CreateUnmanagedInMemoryDataReader(lines));
+    std::unique_ptr<kwc::serialization::DataReader> reader(
+        kwc::serialization::CreateUnmanagedBase64DecodingDataReader(source.get()));
+    std::string buffer(1 << 16, '\0');
+    while (context.running()) {
+        reader->reset();
+        while (!reader->isDone()) {
+            reader->readIntoBuffer(static_cast<kwc::int64>(buffer.size()), &buffer[0]);
+        }
+        kwc::utils::DoNotOptimize(buffer);
+    }
+    context.setBytesProcessed(context.iterations() * kDataSize);
+}
+BENCHMARK_CONFIGURE(Base64DecodingDataReaderLines)->arg(76);
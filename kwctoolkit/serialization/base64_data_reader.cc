@@ -0,0 +1,189 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/status.h"
+#include "kwctoolkit/serialization/data_reader.h"
+#include "kwctoolkit/utils/base64.h"
+
+namespace kwc {
+class Callback;
+
+namespace serialization {
+namespace {
+// Characters read from the source at once, a multiple of four
+const int64 kChunkSize = 1 << 14;
+
+bool IsWhitespace(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+// First whitespace character in [begin, end) or |end|. Skips eight
+// characters at once as long as none of them is a control character or
+// space, which are the only ones below '!' and not part of the alphabet
+const char* FindWhitespace(const char* begin, const char* end) {
+    const uint64 kOnes = 0x0101010101010101ULL;
+    while (begin != end) {
+        uint64 word;
+        while (end - begin >= 8) {
+            std::memcpy(&word, begin, sizeof(word));
+            if (((word - kOnes * '!') & ~word & (kOnes * 0x80)) != 0) {
+                break;
+            }
+            begin += 8;
+        }
+        for (const char* stop = begin + std::min<std::ptrdiff_t>(end - begin, 8); begin != stop;
+             ++begin) {
+            if (IsWhitespace(*begin)) {
+                return begin;
+            }
+        }
+    }
+    return end;
+}
+
+bool IsBase64Char(char ch) {
+    return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') ||
+           ch == '+' || ch == '/';
+}
+}  // namespace
+
+class Base64DecodingDataReader : public DataReader {
+  public:
+    Base64DecodingDataReader(DataReader* source, Callback* delete_cb)
+        : DataReader(delete_cb),
+          source_(source),
+          encoded_(kChunkSize + 3),
+          decoded_(kChunkSize / 4 * 3 + 2) {}
+
+    ~Base64DecodingDataReader() override = default;
+
+  protected:
+    int64 doReadIntoBuffer(int64 max_bytes, char* storage) override {
+        int64 read = 0;
+        while (read < max_bytes) {
+            if (decoded_begin_ == decoded_end_) {
+                if (finished_) {
+                    setDone(true);
+                    break;
+                }
+                refill();
+                if (error()) {
+                    break;
+                }
+                continue;
+            }
+            const int64 count = std::min(max_bytes - read, decoded_end_ - decoded_begin_);
+            std::memcpy(storage + read, decoded_.data() + decoded_begin_, count);
+            decoded_begin_ += count;
+            read += count;
+        }
+        return read;
+    }
+
+    // Only rewinding is supported, by rewinding the source
+    int64 doSetOffset(int64 position) override {
+        if (position != 0 || !source_->reset()) {
+            return DataReader::doSetOffset(position);
+        }
+        num_pending_ = 0;
+        num_consumed_ = 0;
+        decoded_begin_ = 0;
+        decoded_end_ = 0;
+        finished_ = false;
+        return 0;
+    }
+
+  private:
+    DataReader* source_;
+    // Characters of the next chunk, preceded by up to three characters of an
+    // incomplete group left over by the previous chunk
+    std::vector<char> encoded_;
+    int64 num_pending_ = 0;
+    // Characters decoded so far, without whitespace
+    int64 num_consumed_ = 0;
+    std::vector<char> decoded_;
+    int64 decoded_begin_ = 0;
+    int64 decoded_end_ = 0;
+    bool finished_ = false;
+
+    // Decodes the next chunk of the source into |decoded_|
+    void refill() {
+        const int64 read = source_->readIntoBuffer(kChunkSize, &encoded_[num_pending_]);
+        if (source_->error()) {
+            setStatus(source_->status());
+            return;
+        }
+
+        // Drops whitespace such as line breaks in place, by moving the runs
+        // of characters in between
+        const char* const end = encoded_.data() + num_pending_ + read;
+        const char* run = encoded_.data() + num_pending_;
+        char* compacted = encoded_.data() + num_pending_;
+        while (run != end) {
+            const char* run_end = FindWhitespace(run, end);
+            if (compacted != run) {
+                std::memmove(compacted, run, run_end - run);
+            }
+            compacted += run_end - run;
+            for (run = run_end; run != end && IsWhitespace(*run); ++run) {}
+        }
+        const int64 size = compacted - encoded_.data();
+
+        const auto consumed = static_cast<int64>(utils::Base64DecodeGroups(
+            encoded_.data(), size, reinterpret_cast<uint8*>(decoded_.data())));
+        num_consumed_ += consumed;
+        decoded_begin_ = 0;
+        decoded_end_ = consumed / 4 * 3;
+        const int64 remaining = size - consumed;
+        if (remaining >= 4 || (source_->isDone() && remaining > 0)) {
+            decodeLastGroup(&encoded_[consumed], std::min<int64>(remaining, 4));
+            return;
+        }
+        std::memmove(encoded_.data(), encoded_.data() + consumed, remaining);
+        num_pending_ = remaining;
+        finished_ = source_->isDone();
+    }
+
+    // Decodes the group which stopped Base64DecodeGroups(). Only the last
+    // group may be padded, or incomplete without padding
+    void decodeLastGroup(const char* group, int64 size) {
+        int64 num_chars = 0;
+        while (num_chars < size && IsBase64Char(group[num_chars])) {
+            ++num_chars;
+        }
+        int64 num_padding = 0;
+        while (num_chars + num_padding < size && group[num_chars + num_padding] == '=') {
+            ++num_padding;
+        }
+        const bool complete = size == 4 ? num_padding == 4 - num_chars : num_padding == 0;
+        if (num_chars < 2 || num_chars + num_padding < size || !complete) {
+            setStatus(base::Status(base::error::INVALID_ARGUMENT,
+                                   "Invalid base64 data after " +
+                                       std::to_string(num_consumed_ + num_chars) + " characters"));
+            return;
+        }
+        const std::string bytes = utils::Base64Decode(std::string(group, num_chars));
+        std::memcpy(decoded_.data() + decoded_end_, bytes.data(), bytes.size());
+        decoded_end_ += static_cast<int64>(bytes.size());
+        finished_ = true;
+    }
+};
+
+DataReader* CreateManagedBase64DecodingDataReader(DataReader* source, Callback* delete_cb) {
+    return new Base64DecodingDataReader(source, delete_cb);
+}
+
+DataReader* CreateUnmanagedBase64DecodingDataReader(DataReader* source) {
+    return new Base64DecodingDataReader(source, nullptr);
+}
+
+}  // namespace serialization
+}  // namespace kwc
@@ -0,0 +1,130 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/status.h"
+#include "kwctoolkit/serialization/data_reader.h"
+#include "kwctoolkit/serialization/data_writer.h"
+#include "kwctoolkit/utils/base64.h"
+#include "tests/random_data.h"
+
+using namespace kwc;
+using namespace kwc::serialization;
+
+namespace {
+std::string MakeData(std::size_t size) {
+    return test::RandomBytes(size, 0x9e3779b9);
+}
+
+std::string Encode(const std::string& data) {
+    return utils::Base64Encode(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+}
+
+// Reads all of |reader| in reads of at most |read_size| bytes
+std::string ReadAll(DataReader* reader, int64 read_size) {
+    std::string result;
+    std::string buffer(static_cast<std::size_t>(read_size), '\0');
+    while (!reader->isDone()) {
+        const int64 read = reader->readIntoBuffer(read_size, &buffer[0]);
+        result.append(buffer, 0, static_cast<std::size_t>(read));
+    }
+    return result;
+}
+}  // namespace
+
+TEST(Base64DataTest, WriterEncodesAcrossWrites) {
+    const std::string data = MakeData(100000);
+    for (const std::size_t write_size : {1, 2, 5, 4096, 100000}) {
+        SCOPED_TRACE(write_size);
+        std::string encoded;
+        std::unique_ptr<DataWriter> destination(CreateStringDataWriter(&encoded));
+        std::unique_ptr<DataWriter> writer(CreateBase64EncodingDataWriter(destination.get()));
+        for (std::size_t offset = 0; offset < data.size(); offset += write_size) {
+            const std::size_t size = std::min(write_size, data.size() - offset);
+            ASSERT_TRUE(writer->writeData(size, data.data() + offset).ok());
+        }
+        writer->end();
+        EXPECT_TRUE(writer->ok());
+        EXPECT_EQ(static_cast<int64>(data.size()), writer->getSize());
+        EXPECT_EQ(Encode(data), encoded);
+    }
+}
+
+TEST(Base64DataTest, ReaderDecodesAcrossReads) {
+    for (const std::size_t size : {0, 1, 2, 3, 4, 100, 50000}) {
+        SCOPED_TRACE(size);
+        const std::string data = MakeData(size);
+        const std::string encoded = Encode(data);
+        for (const int64 read_size : {1, 7, 8192}) {
+            std::unique_ptr<DataReader> source(CreateUnmanagedInMemoryDataReader(encoded));
+            std::unique_ptr<DataReader> reader(
+                CreateUnmanagedBase64DecodingDataReader(source.get()));
+            EXPECT_EQ(data, ReadAll(reader.get(), read_size));
+            EXPECT_TRUE(reader->ok());
+            EXPECT_EQ(static_cast<int64>(size), reader->getOffset());
+        }
+    }
+}
+
+TEST(Base64DataTest, ReaderSkipsLineBreaksAndAcceptsMissingPadding) {
+    const std::string data = MakeData(1000);
+    const std::string encoded = Encode(data);
+    // Lines of 76 characters as in MIME
+    std::string lines;
+    for (std::size_t offset = 0; offset < encoded.size(); offset += 76) {
+        lines += encoded.substr(offset, 76) + "\r\n";
+    }
+    DataReader* lines_reader = CreateUnmanagedInMemoryDataReader(lines);
+    std::unique_ptr<DataReader> reader(
+        CreateManagedBase64DecodingDataReader(lines_reader, DeletePointerCallback(lines_reader)));
+    EXPECT_EQ(data, ReadAll(reader.get(), 100));
+    EXPECT_TRUE(reader->ok());
+
+    const std::string unpadded = encoded.substr(0, encoded.find('='));
+    std::unique_ptr<DataReader> source(CreateUnmanagedInMemoryDataReader(unpadded));
+    reader.reset(CreateUnmanagedBase64DecodingDataReader(source.get()));
+    EXPECT_EQ(data, ReadAll(reader.get(), 100));
+    EXPECT_TRUE(reader->ok());
+}
+
+TEST(Base64DataTest, ReaderFailsOnInvalidCharacters) {
+    const std::string encoded = Encode(MakeData(30000));
+    for (const std::size_t pos : {0, 5, 20001, 39998}) {
+        SCOPED_TRACE(pos);
+        std::string corrupted = encoded;
+        corrupted[pos] = '*';
+        std::unique_ptr<DataReader> source(CreateUnmanagedInMemoryDataReader(corrupted));
+        std::unique_ptr<DataReader> reader(CreateUnmanagedBase64DecodingDataReader(source.get()));
+        const std::string decoded = ReadAll(reader.get(), 4096);
+        EXPECT_TRUE(reader->error());
+        EXPECT_EQ(base::error::INVALID_ARGUMENT, reader->status().errorCode());
+        EXPECT_LE(decoded.size(), pos / 4 * 3);
+    }
+    for (const char* invalid : {"Z", "Zg=", "Z===", "Zm9v!", "Zm9vY*=="}) {
+        SCOPED_TRACE(invalid);
+        std::unique_ptr<DataReader> source(CreateUnmanagedInMemoryDataReader(invalid));
+        std::unique_ptr<DataReader> reader(CreateUnmanagedBase64DecodingDataReader(source.get()));
+        ReadAll(reader.get(), 16);
+        EXPECT_TRUE(reader->error());
+    }
+}
+
+TEST(Base64DataTest, WriterReaderDecodesWrittenData) {
+    const std::string data = MakeData(12345);
+    std::unique_ptr<DataWriter> destination(CreateStringDataWriter());
+    std::unique_ptr<DataWriter> writer(CreateBase64EncodingDataWriter(destination.get()));
+    writer->writeData(data);
+    writer->end();
+    std::unique_ptr<DataReader> reader(writer->createUnmanagedDataReader());
+    EXPECT_EQ(data, reader->readRemainingToString());
+    EXPECT_TRUE(reader->reset());
+    EXPECT_EQ(data, ReadAll(reader.get(), 1000));
+}
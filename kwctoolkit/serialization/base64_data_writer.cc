@@ -0,0 +1,118 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/status.h"
+#include "kwctoolkit/serialization/data_reader.h"
+#include "kwctoolkit/serialization/data_writer.h"
+#include "kwctoolkit/utils/base64.h"
+
+namespace kwc {
+namespace serialization {
+namespace {
+// Bytes encoded per write to the destination, a multiple of three
+const int64 kChunkSize = 3 << 12;
+
+void DeleteReader(DataReader* reader, Callback* delete_cb) {
+    delete reader;
+    if (delete_cb != nullptr) {
+        delete_cb->run();
+    }
+}
+}  // namespace
+
+class Base64EncodingDataWriter : public DataWriter {
+  public:
+    explicit Base64EncodingDataWriter(DataWriter* destination)
+        : destination_(destination), encoded_(utils::Base64EncodedSize(kChunkSize)) {}
+    ~Base64EncodingDataWriter() override = default;
+
+    Status doBegin() override {
+        num_pending_ = 0;
+        destination_->begin();
+        return destination_->status();
+    }
+
+    Status doWrite(int64 bytes, const char* data) override {
+        const auto* source = reinterpret_cast<const uint8*>(data);
+        // Completes the group left over by the previous write
+        if (num_pending_ > 0) {
+            const int64 count = std::min<int64>(3 - num_pending_, bytes);
+            std::memcpy(pending_ + num_pending_, source, count);
+            num_pending_ += static_cast<int>(count);
+            source += count;
+            bytes -= count;
+            if (num_pending_ < 3) {
+                return {};
+            }
+            num_pending_ = 0;
+            const Status status = writeEncoded(pending_, 3);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+
+        while (bytes >= 3) {
+            const int64 count = std::min(bytes / 3 * 3, kChunkSize);
+            const Status status = writeEncoded(source, count);
+            if (!status.ok()) {
+                return status;
+            }
+            source += count;
+            bytes -= count;
+        }
+
+        std::memcpy(pending_, source, bytes);
+        num_pending_ = static_cast<int>(bytes);
+        return {};
+    }
+
+    Status doEnd() override {
+        if (num_pending_ > 0) {
+            const Status status = writeEncoded(pending_, num_pending_);
+            num_pending_ = 0;
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        destination_->end();
+        return destination_->status();
+    }
+
+    Status doClear() override {
+        num_pending_ = 0;
+        destination_->clear();
+        return destination_->status();
+    }
+
+    DataReader* doCreateDataReader(Callback* delete_cb) override {
+        DataReader* encoded = destination_->createUnmanagedDataReader();
+        return CreateManagedBase64DecodingDataReader(
+            encoded, MakeCallback(&DeleteReader, encoded, delete_cb));
+    }
+
+  private:
+    DataWriter* destination_;
+    std::vector<char> encoded_;
+    // Up to two bytes of an incomplete group between writes
+    uint8 pending_[3];
+    int num_pending_ = 0;
+
+    Status writeEncoded(const uint8* source, int64 bytes) {
+        utils::Base64Encode(source, bytes, encoded_.data());
+        return destination_->writeData(utils::Base64EncodedSize(bytes), encoded_.data());
+    }
+};
+
+DataWriter* CreateBase64EncodingDataWriter(DataWriter* destination) {
+    return new Base64EncodingDataWriter(destination);
+}
+
+}  // namespace serialization
+}  // namespace kwc
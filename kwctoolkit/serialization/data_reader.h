@@ -102,6 +102,13 @@ DataReader* CreateUnmanagedIstreamDataReader(std::istream* stream);
 
 DataReader* CreateUnmanagedIstreamDataReader(std::istream* stream, int64 length);
 
+// Decodes base64 read in chunks from |source|, which isn't owned. Whitespace
+// such as line breaks is skipped and padding ends the data. Any other
+// character outside of the alphabet fails with INVALID_ARGUMENT
+DataReader* CreateManagedBase64DecodingDataReader(DataReader* source, Callback* delete_cb);
+
+DataReader* CreateUnmanagedBase64DecodingDataReader(DataReader* source);
+
 }  // namespace serialization
 }  // namespace kwc
 
@@ -0,0 +1,50 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <memory>
+#include <string>
+
+#include "kwctoolkit/serialization/data_reader.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// HTTP response head with |num_headers| header lines, terminated by an
+// empty line
+std::string MakeResponseHead(kwc::int64 num_headers) {
+    std::string head = "HTTP/1.1 200 OK\r\n";
+    for (kwc::int64 idx = 0; idx < num_headers; ++idx) {
+        head += "X-Header-" + std::to_string(idx) + ": some value\r\n";
+    }
+    return head + "\r\n";
+}
+}  // namespace
+
+// Reading a response head up to the empty line, the way HTTP transports do
+BENCHMARK(DataReaderReadUntil) {
+    const std::string head = MakeResponseHead(context.arg());
+    std::unique_ptr<kwc::serialization::DataReader> reader(
+        kwc::serialization::CreateUnmanagedInMemoryDataReader(head));
+    std::string consumed;
+    while (context.running()) {
+        reader->reset();
+        reader->readUntil("\r\n\r\n", &consumed);
+        kwc::utils::DoNotOptimize(consumed);
+    }
+    context.setBytesProcessed(context.iterations() * static_cast<kwc::int64>(head.size()));
+}
+BENCHMARK_CONFIGURE(DataReaderReadUntil)->range(1, 64);
+
+BENCHMARK(DataReaderReadIntoBuffer) {
+    const std::string head = MakeResponseHead(context.arg());
+    std::unique_ptr<kwc::serialization::DataReader> reader(
+        kwc::serialization::CreateUnmanagedInMemoryDataReader(head));
+    std::string buffer(head.size(), '\0');
+    while (context.running()) {
+        reader->reset();
+        reader->readIntoBuffer(static_cast<kwc::int64>(buffer.size()), &buffer[0]);
+        kwc::utils::DoNotOptimize(buffer);
+    }
+    context.setBytesProcessed(context.iterations() * static_cast<kwc::int64>(head.size()));
+}
+BENCHMARK_CONFIGURE(DataReaderReadIntoBuffer)->range(1, 64);
@@ -73,6 +73,12 @@ DataWriter* CreateStringDataWriter();
 
 DataWriter* CreateFileDataWriter(const std::string& path);
 
+// Encodes the written data as base64 with padding to |destination|, which
+// isn't owned. Up to two bytes of an incomplete group are kept between writes
+// and end() writes the padded last group. Hence the writer streams data of
+// any size in constant memory. Its readers decode the data of |destination|
+DataWriter* CreateBase64EncodingDataWriter(DataWriter* destination);
+
 }  // namespace serialization
 }  // namespace kwc
 
@@ -0,0 +1,43 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <string>
+
+#include "kwctoolkit/strings/string_split.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// Comma separated list of |num_fields| short fields with surrounding
+// whitespace, similar to an HTTP header value
+std::string MakeFieldList(kwc::int64 num_fields) {
+    std::string input;
+    for (kwc::int64 idx = 0; idx < num_fields; ++idx) {
+        input += " field" + std::to_string(idx) + " ,";
+    }
+    return input;
+}
+}  // namespace
+
+BENCHMARK(SplitString) {
+    const std::string input = MakeFieldList(context.arg());
+    while (context.running()) {
+        auto fields = kwc::strings::SplitString(input, ",");
+        kwc::utils::DoNotOptimize(fields);
+    }
+    context.setBytesProcessed(context.iterations() * static_cast<kwc::int64>(input.size()));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(SplitString)->range(8, 4096);
+
+BENCHMARK(SplitStringKeepWhitespace) {
+    const std::string input = MakeFieldList(context.arg());
+    while (context.running()) {
+        auto fields = kwc::strings::SplitString(input, ",", kwc::strings::WHITESPACE_KEEP,
+                                                kwc::strings::SPLIT_WANT_ALL);
+        kwc::utils::DoNotOptimize(fields);
+    }
+    context.setBytesProcessed(context.iterations() * static_cast<kwc::int64>(input.size()));
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(SplitStringKeepWhitespace)->range(8, 4096);
@@ -0,0 +1,105 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/system/arena.h"
+
+#include "kwctoolkit/system/aligned_alloc.h"
+
+namespace kwc {
+namespace system {
+namespace {
+// The slab header occupies a whole cache line, so that the payload of every
+// slab starts cache line aligned as well
+constexpr std::size_t kSlabHeaderSize = kMinBlockAlignment;
+
+char* Payload(void* slab) {
+    return static_cast<char*>(slab) + kSlabHeaderSize;
+}
+}  // namespace
+
+constexpr std::size_t Arena::kDefaultSlabSize;
+
+Arena::Arena(std::size_t slab_size) : slab_size_(slab_size) {
+    static_assert(sizeof(Slab) <= kSlabHeaderSize, "Slab header exceeds its reserved space");
+    KWC_ASSERT(slab_size_ >= kSlabHeaderSize);
+}
+
+Arena::~Arena() {
+    while (slabs_ != nullptr) {
+        Slab* next = slabs_->next;
+        AlignedFree(slabs_);
+        slabs_ = next;
+    }
+}
+
+void Arena::reset() {
+    high_water_mark_ = highWaterMark();
+
+    Slab* keep = nullptr;
+    for (Slab* slab = slabs_; slab != nullptr;) {
+        Slab* next = slab->next;
+        if (keep == nullptr && slab->size == slab_size_) {
+            keep = slab;
+            keep->next = nullptr;
+        } else {
+            AlignedFree(slab);
+        }
+        slab = next;
+    }
+
+    slabs_ = keep;
+    bytes_used_ = 0;
+    if (keep != nullptr) {
+        cursor_ = Payload(keep);
+        end_ = cursor_ + keep->size;
+        num_slabs_ = 1;
+        bytes_reserved_ = kSlabHeaderSize + keep->size;
+    } else {
+        cursor_ = end_ = nullptr;
+        num_slabs_ = 0;
+        bytes_reserved_ = 0;
+    }
+}
+
+void* Arena::allocateSlow(std::size_t num_bytes, std::size_t alignment) {
+    const std::size_t padded_size = num_bytes + alignment - 1;
+    if (padded_size > slab_size_ / 4) {
+        // Dedicated slab. Link it behind the current slab, so that subsequent
+        // small allocations keep filling the current one
+        Slab* slab = newSlab(padded_size);
+        if (slabs_ != nullptr) {
+            slab->next = slabs_->next;
+            slabs_->next = slab;
+        } else {
+            slabs_ = slab;
+        }
+        bytes_used_ += num_bytes;
+        const auto payload = reinterpret_cast<std::uintptr_t>(Payload(slab));
+        return reinterpret_cast<void*>((payload + alignment - 1) & ~(alignment - 1));
+    }
+
+    Slab* slab = newSlab(slab_size_);
+    slab->next = slabs_;
+    slabs_ = slab;
+    cursor_ = Payload(slab);
+    end_ = cursor_ + slab->size;
+    return allocate(num_bytes, alignment);
+}
+
+Arena::Slab* Arena::newSlab(std::size_t size) {
+    void* memory = AlignedAlloc(static_cast<std::ptrdiff_t>(kSlabHeaderSize + size));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    auto* slab = new (memory) Slab();
+    slab->next = nullptr;
+    slab->size = size;
+    ++num_slabs_;
+    bytes_reserved_ += kSlabHeaderSize + size;
+    return slab;
+}
+
+}  // namespace system
+}  // namespace kwc
@@ -0,0 +1,193 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_SYSTEM_ARENA_H_
+#define KWCTOOLKIT_SYSTEM_ARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "kwctoolkit/base/assert.h"
+#include "kwctoolkit/base/compiler.h"
+#include "kwctoolkit/base/macros.h"
+
+#if defined(__has_include)
+    #if __cplusplus >= 201703L && __has_include(<memory_resource>)
+        #include <memory_resource>
+        #define KWC_HAS_MEMORY_RESOURCE 1
+    #endif
+#endif
+
+namespace kwc {
+namespace system {
+
+// Monotonic bump allocator for memory that dies all at once
+//
+// The arena requests large slabs through AlignedAlloc() and hands out memory
+// by advancing a pointer within the current slab. Individual allocations are
+// never freed, instead |reset()| releases everything at once and keeps a
+// single slab around for reuse. This makes it a good fit for request-scoped
+// scratch memory with many tiny allocations, like parsed header fields or
+// decoder buffers.
+//
+// Requests larger than a quarter of the slab size get a dedicated slab, so
+// that they don't waste the remainder of the current one.
+//
+// Example:
+//
+//     Arena arena;
+//     auto* buffer = arena.allocateArray<uint8>(1024);
+//     std::vector<int, ArenaAllocator<int>> values{ArenaAllocator<int>(&arena)};
+//     ...
+//     arena.reset();  // invalidates |buffer| and |values|' memory
+//
+// Destructors of objects placed in the arena are never run. An arena is not
+// thread-safe, use one arena per thread or per request.
+class Arena {
+  public:
+    static constexpr std::size_t kDefaultSlabSize = 64 * 1024;
+
+    explicit Arena(std::size_t slab_size = kDefaultSlabSize);
+    ~Arena();
+
+    // Returns |num_bytes| of uninitialized memory aligned to |alignment|,
+    // which must be a power of two. Never returns nullptr
+    void* allocate(std::size_t num_bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        KWC_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        num_bytes = std::max<std::size_t>(num_bytes, 1);
+        const auto current = reinterpret_cast<std::uintptr_t>(cursor_);
+        const auto aligned = (current + alignment - 1) & ~(alignment - 1);
+        if (KWC_UNLIKELY(cursor_ == nullptr ||
+                         aligned + num_bytes > reinterpret_cast<std::uintptr_t>(end_))) {
+            return allocateSlow(num_bytes, alignment);
+        }
+        cursor_ = reinterpret_cast<char*>(aligned + num_bytes);
+        bytes_used_ += num_bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Uninitialized storage for |count| objects of type T
+    template <typename T>
+    T* allocateArray(std::size_t count) {
+        KWC_ASSERT(count <= static_cast<std::size_t>(-1) / sizeof(T));
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Constructs a T inside the arena. As the destructor will never run, T
+    // must be trivially destructible
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena never runs destructors, T must be trivially destructible");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Releases all allocations at once. One regular slab is kept for
+    // subsequent allocations, all other slabs are returned to the system
+    void reset();
+
+    // Bytes handed out since the last reset(), excluding alignment padding
+    std::size_t bytesUsed() const { return bytes_used_; }
+
+    // Bytes currently held in slabs, including slab headers
+    std::size_t bytesReserved() const { return bytes_reserved_; }
+
+    std::size_t numSlabs() const { return num_slabs_; }
+
+    // Largest value bytesUsed() ever reached during the lifetime of the arena
+    std::size_t highWaterMark() const { return std::max(high_water_mark_, bytes_used_); }
+
+    std::size_t slabSize() const { return slab_size_; }
+
+  private:
+    struct Slab {
+        Slab* next;
+        std::size_t size;
+    };
+
+    void* allocateSlow(std::size_t num_bytes, std::size_t alignment);
+    Slab* newSlab(std::size_t size);
+
+    const std::size_t slab_size_;
+    // Most recently allocated slab first
+    Slab* slabs_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+
+    std::size_t bytes_used_ = 0;
+    std::size_t bytes_reserved_ = 0;
+    std::size_t num_slabs_ = 0;
+    std::size_t high_water_mark_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+// Standard allocator handing out memory from an Arena, e.g. for containers
+// in C++14 code. Deallocation is a no-op, the memory is reclaimed by
+// Arena::reset()
+template <typename T>
+class ArenaAllocator {
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+    T* allocate(std::size_t count) { return arena_->allocateArray<T>(count); }
+
+    void deallocate(T* /*ptr*/, std::size_t /*count*/) {}
+
+    Arena* arena() const { return arena_; }
+
+  private:
+    Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+#if defined(KWC_HAS_MEMORY_RESOURCE)
+// Adapter for using an Arena with std::pmr containers, e.g.
+//
+//     ArenaMemoryResource resource(&arena);
+//     std::pmr::string text("...", &resource);
+class ArenaMemoryResource : public std::pmr::memory_resource {
+  public:
+    explicit ArenaMemoryResource(Arena* arena) : arena_(arena) {}
+
+    Arena* arena() const { return arena_; }
+
+  private:
+    void* do_allocate(std::size_t num_bytes, std::size_t alignment) override {
+        return arena_->allocate(num_bytes, alignment);
+    }
+
+    void do_deallocate(void* /*ptr*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        const auto* resource = dynamic_cast<const ArenaMemoryResource*>(&other);
+        return resource != nullptr && resource->arena_ == arena_;
+    }
+
+    Arena* arena_;
+};
+#endif
+
+}  // namespace system
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_SYSTEM_ARENA_H_
@@ -0,0 +1,90 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cstdlib>
+#include <vector>
+
+#include "kwctoolkit/system/arena.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// Number of small allocations per iteration, roughly resembling the number of
+// fields of a parsed HTTP response
+constexpr int kNumAllocations = 256;
+
+// Allocation sizes cycled through, all of them small
+constexpr std::size_t kSizes[] = {8, 24, 16, 40, 64, 12, 32, 100};
+
+std::size_t AllocationSize(int idx) {
+    return kSizes[idx % (sizeof(kSizes) / sizeof(kSizes[0]))];
+}
+
+// Keeps the compiler from optimizing allocations away
+void Touch(void* ptr) {
+    *static_cast<volatile char*>(ptr) = 0;
+}
+}  // namespace
+
+BENCHMARK(SmallAllocationsMalloc) {
+    std::vector<void*> blocks(kNumAllocations);
+    while (context.running()) {
+        for (int idx = 0; idx < kNumAllocations; ++idx) {
+            blocks[idx] = std::malloc(AllocationSize(idx));
+            Touch(blocks[idx]);
+        }
+        for (auto* block : blocks) {
+            std::free(block);
+        }
+    }    context.setItemsProcessed(context.iterations() * kNumAllocations);
+}
+
+BENCHMARK(SmallAllocationsArena) {
+    kwc::system::Arena arena;
+    while (context.running()) {
+        for (int idx = 0; idx < kNumAllocations; ++idx) {
+            Touch(arena.allocate(AllocationSize(idx)));
+        }
+        arena.reset();
+    }
+    context.setItemsProcessed(context.iterations() * kNumAllocations);
+}
+
+BENCHMARK(VectorGrowthStdAllocator) {
+    while (context.running()) {
+        std::vector<int> values;
+        for (int idx = 0; idx < kNumAllocations; ++idx) {
+            values.push_back(idx);
+        }
+        Touch(values.data());
+    }
+}
+
+BENCHMARK(VectorGrowthArenaAllocator) {
+    kwc::system::Arena arena;
+    while (context.running()) {
+        {
+            std::vector<int, kwc::system::ArenaAllocator<int>> values{
+                kwc::system::ArenaAllocator<int>(&arena)};
+            for (int idx = 0; idx < kNumAllocations; ++idx) {
+                values.push_back(idx);
+            }
+            Touch(values.data());
+        }
+        arena.reset();
+    }
+}
+
+// Allocation sizes beyond a quarter of the slab size get a dedicated slab
+BENCHMARK(AllocationSizeSweepArena) {
+    const auto size = static_cast<std::size_t>(context.arg());
+    kwc::system::Arena arena;
+    while (context.running()) {
+        for (int idx = 0; idx < 16; ++idx) {
+            Touch(arena.allocate(size));
+        }
+        arena.reset();
+    }
+    context.setItemsProcessed(context.iterations() * 16);
+}
+BENCHMARK_CONFIGURE(AllocationSizeSweepArena)->rangeMultiplier(4)->range(64, 256 * 1024);
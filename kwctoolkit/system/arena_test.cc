@@ -0,0 +1,141 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/system/arena.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace kwc::system;
+
+namespace {
+bool IsAligned(const void* ptr, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+}  // namespace
+
+TEST(ArenaTest, StartsEmpty) {
+    Arena arena;
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+    EXPECT_EQ(arena.numSlabs(), 0u);
+    EXPECT_EQ(arena.highWaterMark(), 0u);
+}
+
+TEST(ArenaTest, AllocationsAreAlignedAndDisjoint) {
+    Arena arena(1024);
+    std::vector<char*> blocks;
+    for (std::size_t alignment = 1; alignment <= 128; alignment *= 2) {
+        auto* block = static_cast<char*>(arena.allocate(13, alignment));
+        ASSERT_TRUE(IsAligned(block, alignment));
+        std::memset(block, static_cast<int>(alignment), 13);
+        blocks.push_back(block);
+    }
+
+    std::size_t alignment = 1;
+    for (auto* block : blocks) {
+        for (int idx = 0; idx < 13; ++idx) {
+            ASSERT_EQ(block[idx], static_cast<char>(alignment));
+        }
+        alignment *= 2;
+    }
+    EXPECT_EQ(arena.bytesUsed(), 13u * blocks.size());
+}
+
+TEST(ArenaTest, FirstAllocationIsCacheLineAligned) {
+    Arena arena;
+    EXPECT_TRUE(IsAligned(arena.allocate(1, 1), KWC_CACHELINE_SIZE));
+}
+
+TEST(ArenaTest, GrowsBySlabs) {
+    Arena arena(256);
+    for (int idx = 0; idx < 100; ++idx) {
+        arena.allocate(32, 8);
+    }
+    EXPECT_EQ(arena.bytesUsed(), 3200u);
+    EXPECT_GE(arena.numSlabs(), 3200u / 256);
+    EXPECT_GE(arena.bytesReserved(), 3200u);
+}
+
+TEST(ArenaTest, LargeAllocationsDontWasteTheCurrentSlab) {
+    Arena arena(1024);
+    auto* small = static_cast<char*>(arena.allocate(16, 1));
+    auto* large = arena.allocate(4096, 64);
+    EXPECT_TRUE(IsAligned(large, 64));
+    EXPECT_EQ(arena.numSlabs(), 2u);
+
+    // The next small allocation continues right behind the first one
+    auto* next = static_cast<char*>(arena.allocate(16, 1));
+    EXPECT_EQ(next, small + 16);
+}
+
+TEST(ArenaTest, ResetKeepsOneSlabAndTracksHighWaterMark) {
+    Arena arena(512);
+    for (int idx = 0; idx < 10; ++idx) {
+        arena.allocate(100);
+    }
+    arena.allocate(2048);
+    EXPECT_EQ(arena.bytesUsed(), 3048u);
+    EXPECT_GT(arena.numSlabs(), 1u);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(arena.numSlabs(), 1u);
+    EXPECT_EQ(arena.highWaterMark(), 3048u);
+
+    arena.allocate(10);
+    EXPECT_EQ(arena.numSlabs(), 1u);
+    EXPECT_EQ(arena.highWaterMark(), 3048u);
+}
+
+TEST(ArenaTest, CreatesObjects) {
+    struct Point {
+        Point(int x_value, int y_value) : x(x_value), y(y_value) {}
+        int x;
+        int y;
+    };
+
+    Arena arena;
+    auto* point = arena.create<Point>(3, 4);
+    EXPECT_EQ(point->x, 3);
+    EXPECT_EQ(point->y, 4);
+}
+
+TEST(ArenaTest, AllocatorWorksWithContainers) {
+    Arena arena(4096);
+    std::vector<int, ArenaAllocator<int>> values{ArenaAllocator<int>(&arena)};
+    for (int idx = 0; idx < 1000; ++idx) {
+        values.push_back(idx);
+    }
+    for (int idx = 0; idx < 1000; ++idx) {
+        ASSERT_EQ(values[idx], idx);
+    }
+    EXPECT_GE(arena.bytesUsed(), 1000 * sizeof(int));
+
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+    ArenaString text("a string that does not fit into the small buffer",
+                     ArenaAllocator<char>(&arena));
+    EXPECT_EQ(text.size(), 48u);
+    EXPECT_EQ(ArenaAllocator<char>(&arena), ArenaAllocator<int>(&arena));
+}
+
+#if defined(KWC_REQUIRE_MEMORY_RESOURCE) && !defined(KWC_HAS_MEMORY_RESOURCE)
+    #error "ArenaMemoryResource is not available, which needs C++17 and <memory_resource>"
+#endif
+
+#if defined(KWC_HAS_MEMORY_RESOURCE)
+TEST(ArenaTest, MemoryResourceWorksWithPmrContainers) {
+    Arena arena;
+    ArenaMemoryResource resource(&arena);
+    std::pmr::vector<std::pmr::string> lines(&resource);
+    lines.emplace_back("a string that does not fit into the small buffer");
+    EXPECT_EQ(lines.front().get_allocator().resource(), &resource);
+    EXPECT_GT(arena.bytesUsed(), 48u);
+    EXPECT_TRUE(resource.is_equal(ArenaMemoryResource(&arena)));
+}
+#endif
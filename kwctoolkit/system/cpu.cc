@@ -62,6 +62,11 @@ CPU::CPU() : cpu_vendor_("unknown") {
     initialize();
 }
 
+const CPU& CPU::getInstance() {
+    static const CPU cpu;
+    return cpu;
+}
+
 void CPU::initialize() {
     int cpu_info[4] = {-1};
 
@@ -102,6 +107,7 @@ void CPU::initialize() {
         has_sse_ = (cpu_info[3] & 0x02000000) != 0;
         has_sse2_ = (cpu_info[3] & 0x04000000) != 0;
         has_sse3_ = (cpu_info[2] & 0x00000001) != 0;
+        has_ssse3_ = (cpu_info[2] & 0x00000200) != 0;
         has_sse41_ = (cpu_info[2] & 0x00080000) != 0;
         has_sse42_ = (cpu_info[2] & 0x00100000) != 0;
 
@@ -208,6 +214,10 @@ bool CPU::hasSse3() const {
     return has_sse3_;
 }
 
+bool CPU::hasSsse3() const {
+    return has_ssse3_;
+}
+
 bool CPU::hasSse41() const {
     return has_sse41_;
 }
@@ -14,6 +14,10 @@ class CPU final {
   public:
     CPU();
 
+    // Shared instance, which queries the processor only once. Meant for
+    // selecting an implementation at runtime
+    static const CPU& getInstance();
+
     enum IntelMicroArchitecture {
         PENTIUM,
         SSE,
@@ -40,6 +44,7 @@ class CPU final {
     bool hasSse() const;
     bool hasSse2() const;
     bool hasSse3() const;
+    bool hasSsse3() const;
     bool hasSse41() const;
     bool hasSse42() const;
     bool hasAvx() const;
@@ -65,6 +70,7 @@ class CPU final {
     bool has_sse_{false};
     bool has_sse2_{false};
     bool has_sse3_{false};
+    bool has_ssse3_{false};
     bool has_sse41_{false};
     bool has_sse42_{false};
     bool has_avx_{false};
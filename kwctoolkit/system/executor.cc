@@ -4,19 +4,22 @@
 
 #include "kwctoolkit/system/executor.h"
 
+#include <atomic>
 #include <mutex>
+#include <utility>
 
 #include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/base/callback_pool.h"
 
 namespace kwc {
 namespace {
 using system::Executor;
 
-Executor* default_executor = nullptr;
+// Read on every defaultExecutor() call, thus kept lock-free
+std::atomic<Executor*> default_executor{nullptr};
 Executor* global_inline_executor = nullptr;
 
 std::once_flag module_init;
-std::mutex g_mutex;
 
 // Simple executor without queueing.
 //
@@ -29,25 +32,44 @@ class InlineExecutor : public Executor {
     ~InlineExecutor() override = default;
 
     void add(Callback* callback) override { callback->run(); }
+
+    void add(UniqueFunction<void()> task) override { task(); }
+};
+
+// Adapter for running a UniqueFunction through the Callback based interface
+class TaskCallback : public Callback {
+  public:
+    explicit TaskCallback(UniqueFunction<void()> task) : task_(std::move(task)) {}
+
+    void run() override {
+        task_();
+        delete this;
+    }
+
+  private:
+    UniqueFunction<void()> task_;
 };
 
 void InitModule() {
     global_inline_executor = new InlineExecutor;
-    default_executor = global_inline_executor;
+    default_executor.store(global_inline_executor, std::memory_order_release);
 }
 }  // namespace
 
 namespace system {
 
+void Executor::add(UniqueFunction<void()> task) {
+    add(new internal::PooledCallback<TaskCallback>(std::move(task)));
+}
+
 Executor* Executor::defaultExecutor() {
     std::call_once(module_init, InitModule);
-    return default_executor;
+    return default_executor.load(std::memory_order_acquire);
 }
 
 void Executor::setDefaultExecutor(Executor* executor) {
     std::call_once(module_init, InitModule);
-    std::lock_guard<std::mutex> guard(g_mutex);
-    default_executor = executor;
+    default_executor.store(executor, std::memory_order_release);
 }
 
 Executor* MakeInlineExecutor() {
@@ -6,6 +6,7 @@
 #define KWCTOOLKIT_SYSTEM_EXECUTOR_H_
 
 #include "kwctoolkit/base/macros.h"
+#include "kwctoolkit/base/unique_function.h"
 
 namespace kwc {
 class Callback;
@@ -22,11 +23,13 @@ namespace system {
 // such as |thread_pool| taking new threads out of a thread pool,
 // |serial_executor| which processes one task after another or
 // |inline_executor|, which is implemented here. The latter calls the callback
-// function just right away on the calling thread.
+// function just right away on the calling thread. A work-stealing thread pool
+// is provided by ThreadPoolExecutor in thread_pool_executor.h.
 //
 // Note that we deliberately choose not to use templates and just pure
 // functions as callbacks which don't return anything in favor of a simple
-// interface.
+// interface. Besides Callback objects, executors accept a UniqueFunction,
+// which keeps small closures inline instead of allocating them.
 class Executor {
   public:
     Executor() = default;
@@ -35,6 +38,11 @@ class Executor {
     // Schedule the specified callback for execution in this executor.
     virtual void add(Callback* callback) = 0;
 
+    // Schedule |task| for execution in this executor. The default
+    // implementation wraps |task| into a self-deleting callback, whose
+    // storage is recycled by the callback pool (see callback_pool.h)
+    virtual void add(UniqueFunction<void()> task);
+
     // Caller retains ownership
     static void setDefaultExecutor(Executor* executor);
     static Executor* defaultExecutor();
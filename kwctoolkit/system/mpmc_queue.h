@@ -0,0 +1,166 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_SYSTEM_MPMC_QUEUE_H_
+#define KWCTOOLKIT_SYSTEM_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "kwctoolkit/base/assert.h"
+#include "kwctoolkit/base/compiler.h"
+#include "kwctoolkit/base/macros.h"
+#include "kwctoolkit/system/aligned_alloc.h"
+
+namespace kwc {
+namespace system {
+
+// Lock-free bounded multi-producer/multi-consumer queue
+//
+// This is Dmitry Vyukov's bounded MPMC queue: A ring buffer of cells where
+// every cell carries a sequence number that tells producers and consumers
+// whether the cell is ready to be written or read. Producers and consumers
+// only contend on a single CAS on the enqueue or dequeue position
+// respectively and never block each other otherwise.
+//
+// Both positions live on their own cache line (see KWC_CACHELINE_SIZE) and
+// the cell buffer is allocated cache line aligned through AlignedAlloc().
+//
+// The capacity is rounded up to the next power of two. |tryPush()| fails if
+// the queue is full and |tryPop()| fails if it is empty, neither of them
+// blocks. Items are handed over in FIFO order per producer.
+template <typename T>
+class BoundedMpmcQueue {
+  public:
+    explicit BoundedMpmcQueue(std::size_t capacity)
+        : capacity_(RoundUpToPowerOfTwo(capacity)),
+          mask_(capacity_ - 1),
+          cells_(static_cast<Cell*>(
+              AlignedAlloc(static_cast<std::ptrdiff_t>(capacity_ * sizeof(Cell))))) {
+        KWC_ASSERT(cells_ != nullptr);
+        for (std::size_t idx = 0; idx < capacity_; ++idx) {
+            new (&cells_[idx]) Cell();
+            cells_[idx].sequence.store(idx, std::memory_order_relaxed);
+        }
+        enqueue_pos_.store(0, std::memory_order_relaxed);
+        dequeue_pos_.store(0, std::memory_order_relaxed);
+    }
+
+    ~BoundedMpmcQueue() {
+        // No concurrent access anymore, destroy the items that are left
+        const std::size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        for (auto pos = dequeue_pos_.load(std::memory_order_acquire); pos != enqueue_pos; ++pos) {
+            cells_[pos & mask_].storage()->~T();
+        }
+        for (std::size_t idx = 0; idx < capacity_; ++idx) {
+            cells_[idx].~Cell();
+        }
+        AlignedFree(cells_);
+    }
+
+    bool tryPush(const T& item) { return tryEmplace(item); }
+
+    bool tryPush(T&& item) { return tryEmplace(std::move(item)); }
+
+    template <typename... Args>
+    bool tryEmplace(Args&&... args) {
+        Cell* cell;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Cell still holds an item from the previous round: full
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->storage()) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T* item) {
+        Cell* cell;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Cell has not been written in this round: empty
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* stored = cell->storage();
+        *item = std::move(*stored);
+        stored->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+    // Approximate number of items, may be stale by the time it returns
+    std::size_t size() const {
+        const std::size_t enqueue_pos = enqueue_pos_.load(std::memory_order_relaxed);
+        const std::size_t dequeue_pos = dequeue_pos_.load(std::memory_order_relaxed);
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+  private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+
+        T* storage() { return reinterpret_cast<T*>(&data); }
+    };
+
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    using Padding = char[KWC_CACHELINE_SIZE];
+
+    Padding front_padding_;
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    Cell* const cells_;
+    Padding cells_padding_;
+    std::atomic<std::size_t> enqueue_pos_;
+    char enqueue_padding_[KWC_CACHELINE_SIZE - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> dequeue_pos_;
+    char dequeue_padding_[KWC_CACHELINE_SIZE - sizeof(std::atomic<std::size_t>)];
+
+    DISALLOW_COPY_AND_ASSIGN(BoundedMpmcQueue);
+};
+
+}  // namespace system
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_SYSTEM_MPMC_QUEUE_H_
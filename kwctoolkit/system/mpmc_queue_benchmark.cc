@@ -0,0 +1,119 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "kwctoolkit/system/mpmc_queue.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// Number of items handed from producers to consumers per benchmark iteration
+constexpr int kNumItems = 1 << 16;
+
+// Reference implementation the lock-free queue is compared against
+class LockedQueue {
+  public:
+    bool tryPush(int item) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        queue_.push_back(item);
+        return true;
+    }
+
+    bool tryPop(int* item) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        *item = queue_.front();
+        queue_.pop_front();
+        return true;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::deque<int> queue_;
+};
+
+// Moves |kNumItems| through |queue| using the given number of producer and
+// consumer threads
+template <typename Queue>
+void Transfer(Queue* queue, int num_producers, int num_consumers) {
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < num_producers; ++producer) {
+        const int chunk = kNumItems / num_producers;
+        const int begin = chunk * producer;
+        const int end = producer + 1 == num_producers ? kNumItems : begin + chunk;
+        threads.emplace_back([queue, begin, end] {
+            for (int idx = begin; idx < end; ++idx) {
+                while (!queue->tryPush(idx)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int consumer = 0; consumer < num_consumers; ++consumer) {
+        threads.emplace_back([queue, &consumed] {
+            int item;
+            while (consumed.load(std::memory_order_relaxed) < kNumItems) {
+                if (queue->tryPop(&item)) {
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template <typename Queue>
+void RunTransfer(kwc::utils::Context& context, Queue* queue, int producers, int consumers) {
+    while (context.running()) {
+        Transfer(queue, producers, consumers);
+    }
+}
+}  // namespace
+
+#define MPMC_QUEUE_BENCHMARK(PRODUCERS, CONSUMERS)          \
+    BENCHMARK(MpmcQueue_##PRODUCERS##P##CONSUMERS##C) {     \
+        kwc::system::BoundedMpmcQueue<int> queue(1024);     \
+        RunTransfer(context, &queue, PRODUCERS, CONSUMERS); \
+    }                                                       \
+    BENCHMARK(LockedQueue_##PRODUCERS##P##CONSUMERS##C) {   \
+        LockedQueue queue;                                  \
+        RunTransfer(context, &queue, PRODUCERS, CONSUMERS); \
+    }
+
+MPMC_QUEUE_BENCHMARK(1, 1)
+MPMC_QUEUE_BENCHMARK(1, 4)
+MPMC_QUEUE_BENCHMARK(4, 1)
+MPMC_QUEUE_BENCHMARK(2, 2)
+MPMC_QUEUE_BENCHMARK(4, 4)
+MPMC_QUEUE_BENCHMARK(8, 8)
+
+// Every thread alternately pushes and pops on a shared queue
+BENCHMARK_THREADS(MpmcQueuePushPop, 0) {
+    static kwc::system::BoundedMpmcQueue<int> queue(1024);
+    int item;
+    while (context.running()) {
+        queue.tryPush(context.threadIndex());
+        queue.tryPop(&item);
+    }
+}
+
+BENCHMARK_THREADS(LockedQueuePushPop, 0) {
+    static LockedQueue queue;
+    int item;
+    while (context.running()) {
+        queue.tryPush(context.threadIndex());
+        queue.tryPop(&item);
+    }
+}
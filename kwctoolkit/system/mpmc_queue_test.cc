@@ -0,0 +1,101 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/system/mpmc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kwc::system;
+
+TEST(BoundedMpmcQueueTest, CapacityIsRoundedUpToPowerOfTwo) {
+    BoundedMpmcQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BoundedMpmcQueueTest, PushAndPopInFifoOrder) {
+    BoundedMpmcQueue<int> queue(4);
+    for (int idx = 0; idx < 4; ++idx) {
+        EXPECT_TRUE(queue.tryPush(idx));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_EQ(queue.size(), 4u);
+
+    int value = -1;
+    for (int idx = 0; idx < 4; ++idx) {
+        ASSERT_TRUE(queue.tryPop(&value));
+        EXPECT_EQ(value, idx);
+    }
+    EXPECT_FALSE(queue.tryPop(&value));
+}
+
+TEST(BoundedMpmcQueueTest, WrapsAroundManyTimes) {
+    BoundedMpmcQueue<int> queue(2);
+    int value = 0;
+    for (int idx = 0; idx < 1000; ++idx) {
+        ASSERT_TRUE(queue.tryPush(idx));
+        ASSERT_TRUE(queue.tryPop(&value));
+        ASSERT_EQ(value, idx);
+    }
+}
+
+TEST(BoundedMpmcQueueTest, SupportsMoveOnlyTypes) {
+    BoundedMpmcQueue<std::unique_ptr<std::string>> queue(4);
+    EXPECT_TRUE(queue.tryPush(std::make_unique<std::string>("foo")));
+    EXPECT_TRUE(queue.tryEmplace(new std::string("bar")));
+
+    std::unique_ptr<std::string> value;
+    ASSERT_TRUE(queue.tryPop(&value));
+    EXPECT_EQ(*value, "foo");
+    // The remaining item is released by the destructor
+}
+
+TEST(BoundedMpmcQueueTest, HandsOverEveryItemExactlyOnce) {
+    constexpr int kNumProducers = 4;
+    constexpr int kNumConsumers = 4;
+    constexpr int kItemsPerProducer = 25000;
+    BoundedMpmcQueue<int> queue(64);
+    std::vector<std::atomic<int>> seen(kNumProducers * kItemsPerProducer);
+    for (auto& count : seen) {
+        count = 0;
+    }
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < kNumProducers; ++producer) {
+        threads.emplace_back([&, producer] {
+            for (int idx = 0; idx < kItemsPerProducer; ++idx) {
+                while (!queue.tryPush(producer * kItemsPerProducer + idx)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int consumer = 0; consumer < kNumConsumers; ++consumer) {
+        threads.emplace_back([&] {
+            int value;
+            while (consumed.load() < kNumProducers * kItemsPerProducer) {
+                if (queue.tryPop(&value)) {
+                    seen[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& count : seen) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
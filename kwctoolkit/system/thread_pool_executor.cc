@@ -0,0 +1,248 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/system/thread_pool_executor.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "kwctoolkit/base/assert.h"
+#include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/system/system_info.h"
+#include "kwctoolkit/system/thread.h"
+#include "kwctoolkit/system/work_stealing_deque.h"
+
+namespace kwc {
+namespace system {
+namespace {
+// Number of unsuccessful work lookups before an idle worker goes to sleep
+constexpr int kSpinCount = 64;
+
+// Capacity of the lock-free injection queue for callbacks added from
+// non-worker threads
+constexpr std::size_t kInjectionQueueCapacity = 4096;
+
+// Simple xorshift generator for picking steal victims. We don't need any
+// statistical quality here, just something cheap and thread-local
+uint64 NextRandom(uint64* state) {
+    uint64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+}  // namespace
+
+struct ThreadPoolExecutor::Worker {
+    Worker(ThreadPoolExecutor* owner, int worker_index)
+        : pool(owner),
+          index(worker_index),
+          random_state(0x9E3779B97F4A7C15ULL * (worker_index + 1)),
+          thread(&ThreadPoolExecutor::WorkerMain,
+                 this,
+                 ("kwc_worker_" + std::to_string(worker_index)).c_str()) {}
+
+    ThreadPoolExecutor* const pool;
+    const int index;
+    uint64 random_state;
+    WorkStealingDeque<Callback> deque;
+    Thread thread;
+};
+
+// The worker the current thread is running, if any
+thread_local ThreadPoolExecutor::Worker* ThreadPoolExecutor::current_worker_ = nullptr;
+
+ThreadPoolExecutor::ThreadPoolExecutor(int num_threads)
+    : injection_queue_(kInjectionQueueCapacity) {
+    if (num_threads <= 0) {
+        num_threads = std::max(1, SystemInfo::getNumberOfCPUs());
+    }
+
+    workers_.reserve(num_threads);
+    for (int idx = 0; idx < num_threads; ++idx) {
+        workers_.emplace_back(new Worker(this, idx));
+    }
+
+    // Start threads only after all workers exist, as they immediately start
+    // looking for victims to steal from
+    for (auto& worker : workers_) {
+        worker->thread.start();
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+    shutdown();
+}
+
+void ThreadPoolExecutor::add(Callback* callback) {
+    // shutdown() sets |stopping_| before it waits for |num_adding_| to drop
+    // to zero, whereas we increment |num_adding_| before we check
+    // |stopping_|. Hence, either we run the callback inline or shutdown()
+    // waits until it has been queued
+    num_adding_.fetch_add(1, std::memory_order_seq_cst);
+    if (stopping_.load(std::memory_order_seq_cst)) {
+        num_adding_.fetch_sub(1, std::memory_order_seq_cst);
+        callback->run();
+        return;
+    }
+
+    num_outstanding_.fetch_add(1, std::memory_order_acq_rel);
+    Worker* worker = current_worker_;
+    if (worker != nullptr && worker->pool == this) {
+        worker->deque.push(callback);
+    } else if (!injection_queue_.tryPush(callback)) {
+        std::lock_guard<std::mutex> guard(overflow_mutex_);
+        overflow_queue_.push_back(callback);
+        num_overflowed_.fetch_add(1, std::memory_order_release);
+    }
+    num_queued_.fetch_add(1, std::memory_order_seq_cst);
+    num_adding_.fetch_sub(1, std::memory_order_seq_cst);
+    notifyWorker();
+}
+
+void ThreadPoolExecutor::drain() {
+    KWC_ASSERT(current_worker_ == nullptr || current_worker_->pool != this);
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    drain_cv_.wait(lock, [this] { return num_outstanding_.load(std::memory_order_acquire) == 0; });
+}
+
+void ThreadPoolExecutor::shutdown() {
+    if (shut_down_.exchange(true)) {
+        return;
+    }
+
+    drain();
+    {
+        std::lock_guard<std::mutex> guard(sleep_mutex_);
+        stopping_.store(true, std::memory_order_seq_cst);
+    }
+    // Callbacks added concurrently with the above are either run inline or
+    // queued once no add() is in flight anymore
+    while (num_adding_.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    sleep_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker->thread.stop();
+    }
+
+    // Workers may have exited before the last callbacks were queued
+    for (Callback* task = popInjected(); task != nullptr; task = popInjected()) {
+        num_queued_.fetch_sub(1, std::memory_order_acq_rel);
+        runTask(task);
+    }
+}
+
+void ThreadPoolExecutor::WorkerMain(void* obj) {
+    auto* worker = static_cast<Worker*>(obj);
+    worker->pool->workerLoop(worker);
+}
+
+void ThreadPoolExecutor::workerLoop(Worker* worker) {
+    current_worker_ = worker;
+
+    while (true) {
+        Callback* task = nullptr;
+        for (int spin = 0; spin < kSpinCount && task == nullptr; ++spin) {
+            task = findWork(worker);
+            if (task == nullptr) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (task != nullptr) {
+            runTask(task);
+            continue;
+        }
+
+        // Going to sleep. |add()| increments |num_queued_| before it checks
+        // |num_sleeping_|, whereas we increment |num_sleeping_| before we check
+        // |num_queued_|. Hence, at least one side observes the other and no
+        // wakeup gets lost
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        num_sleeping_.fetch_add(1, std::memory_order_seq_cst);
+        sleep_cv_.wait(lock, [this] {
+            return num_queued_.load(std::memory_order_seq_cst) > 0 ||
+                   stopping_.load(std::memory_order_acquire);
+        });
+        num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+
+        if (stopping_.load(std::memory_order_acquire) &&
+            num_queued_.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+    }
+
+    current_worker_ = nullptr;
+}
+
+Callback* ThreadPoolExecutor::findWork(Worker* worker) {
+    Callback* task = worker->deque.pop();
+    if (task != nullptr) {
+        num_queued_.fetch_sub(1, std::memory_order_acq_rel);
+        return task;
+    }
+
+    // Nothing queued anywhere, don't bother other workers
+    if (num_queued_.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    task = popInjected();
+
+    const auto num_workers = static_cast<uint64>(workers_.size());
+    for (uint64 attempt = 0; task == nullptr && num_workers > 1 && attempt < num_workers;
+         ++attempt) {
+        auto victim = NextRandom(&worker->random_state) % num_workers;
+        if (static_cast<int>(victim) == worker->index) {
+            continue;
+        }
+        task = workers_[victim]->deque.steal();
+    }
+
+    if (task != nullptr) {
+        num_queued_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return task;
+}
+
+Callback* ThreadPoolExecutor::popInjected() {
+    Callback* task = nullptr;
+    if (injection_queue_.tryPop(&task)) {
+        return task;
+    }
+
+    if (num_overflowed_.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> guard(overflow_mutex_);
+    if (overflow_queue_.empty()) {
+        return nullptr;
+    }
+    task = overflow_queue_.front();
+    overflow_queue_.pop_front();
+    num_overflowed_.fetch_sub(1, std::memory_order_release);
+    return task;
+}
+
+void ThreadPoolExecutor::runTask(Callback* callback) {
+    callback->run();
+    if (num_outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> guard(drain_mutex_);
+        drain_cv_.notify_all();
+    }
+}
+
+void ThreadPoolExecutor::notifyWorker() {
+    if (num_sleeping_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> guard(sleep_mutex_);
+        sleep_cv_.notify_one();
+    }
+}
+
+}  // namespace system
+}  // namespace kwc
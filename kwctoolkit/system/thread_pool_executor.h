@@ -0,0 +1,115 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_SYSTEM_THREAD_POOL_EXECUTOR_H_
+#define KWCTOOLKIT_SYSTEM_THREAD_POOL_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/macros.h"
+#include "kwctoolkit/system/executor.h"
+#include "kwctoolkit/system/mpmc_queue.h"
+
+namespace kwc {
+class Callback;
+
+namespace system {
+
+// Executor running callbacks concurrently on a fixed set of worker threads
+//
+// Every worker owns a work-stealing deque. Callbacks added from within a
+// worker (i.e. tasks spawning tasks) are pushed onto the worker's own deque
+// and are popped in LIFO order for cache locality. Callbacks added from any
+// other thread are placed into a shared lock-free injection queue, which only
+// falls back to a mutex protected overflow list once full. Idle workers first
+// drain their own deque, then the injection queue and finally try to steal
+// from randomly chosen victims before going to sleep.
+//
+// Example:
+//
+//     ThreadPoolExecutor executor;  // one worker per logical CPU
+//     executor.add(MakeCallback(&Work, data));
+//     executor.drain();             // wait until all work has been executed
+//
+// Callbacks are run exactly once and must not throw. The executor does not
+// take ownership of permanent callbacks, self-deleting callbacks delete
+// themselves as usual after |run()|.
+class ThreadPoolExecutor : public Executor {
+  public:
+    // Creates a pool with |num_threads| workers. A value <= 0 sizes the pool
+    // according to SystemInfo::getNumberOfCPUs()
+    explicit ThreadPoolExecutor(int num_threads = 0);
+
+    // Implicitly calls shutdown()
+    ~ThreadPoolExecutor() override;
+
+    using Executor::add;
+
+    // Schedules |callback| for execution on one of the worker threads. After
+    // shutdown() has been called, callbacks are run on the calling thread
+    void add(Callback* callback) override;
+
+    // Blocks until every callback added so far (including those added by
+    // running callbacks) has finished. Must not be called from a worker
+    void drain();
+
+    // Drains all pending work, then stops and joins all worker threads.
+    // Calling shutdown() more than once is harmless
+    void shutdown();
+
+    int numThreads() const { return static_cast<int>(workers_.size()); }
+
+    // Number of callbacks added but not yet finished
+    int64 numPendingTasks() const { return num_outstanding_.load(std::memory_order_acquire); }
+
+  private:
+    struct Worker;
+
+    static void WorkerMain(void* obj);
+
+    void workerLoop(Worker* worker);
+    Callback* findWork(Worker* worker);
+    Callback* popInjected();
+    void runTask(Callback* callback);
+    void notifyWorker();
+
+    static thread_local Worker* current_worker_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // Callbacks added from non-worker threads
+    BoundedMpmcQueue<Callback*> injection_queue_;
+    std::mutex overflow_mutex_;
+    std::deque<Callback*> overflow_queue_;
+    std::atomic<int64> num_overflowed_{0};
+
+    // Sleeping workers wait for |num_queued_| to become non-zero
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::atomic<int64> num_queued_{0};
+    std::atomic<int> num_sleeping_{0};
+
+    // drain() waits for |num_outstanding_| to become zero
+    std::mutex drain_mutex_;
+    std::condition_variable drain_cv_;
+    std::atomic<int64> num_outstanding_{0};
+
+    // Number of add() calls between checking |stopping_| and queueing
+    std::atomic<int> num_adding_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> shut_down_{false};
+
+    DISALLOW_COPY_AND_ASSIGN(ThreadPoolExecutor);
+};
+
+}  // namespace system
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_SYSTEM_THREAD_POOL_EXECUTOR_H_
@@ -0,0 +1,61 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <atomic>
+#include <memory>
+
+#include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/system/executor.h"
+#include "kwctoolkit/system/thread_pool_executor.h"
+#include "kwctoolkit/utils/benchmark.h"
+
+namespace {
+// Number of callbacks scheduled per benchmark iteration
+constexpr int kNumTasks = 256;
+
+// Roughly a microsecond worth of arithmetic, enough to make the scheduling
+// overhead visible without drowning it
+void SpinWork(std::atomic<kwc::uint64>* sink) {
+    kwc::uint64 x = 88172645463325252ULL;
+    for (int idx = 0; idx < 512; ++idx) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    sink->fetch_add(x, std::memory_order_relaxed);
+}
+
+void RunTasks(kwc::system::Executor* executor, std::atomic<kwc::uint64>* sink) {
+    for (int idx = 0; idx < kNumTasks; ++idx) {
+        executor->add(kwc::MakeCallback(&SpinWork, sink));
+    }
+}
+}  // namespace
+
+BENCHMARK(ExecutorInline) {
+    std::atomic<kwc::uint64> sink{0};
+    std::unique_ptr<kwc::system::Executor> executor(kwc::system::MakeInlineExecutor());
+    while (context.running()) {
+        RunTasks(executor.get(), &sink);
+    }
+}
+
+BENCHMARK(ExecutorThreadPool) {
+    std::atomic<kwc::uint64> sink{0};
+    kwc::system::ThreadPoolExecutor executor;
+    while (context.running()) {
+        RunTasks(&executor, &sink);
+        executor.drain();
+    }
+}
+
+BENCHMARK(ExecutorThreadPoolSingleWorker) {
+    std::atomic<kwc::uint64> sink{0};
+    kwc::system::ThreadPoolExecutor executor(1);
+    while (context.running()) {
+        RunTasks(&executor, &sink);
+        executor.drain();
+    }
+}
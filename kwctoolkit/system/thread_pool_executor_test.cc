@@ -0,0 +1,160 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/system/thread_pool_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "kwctoolkit/base/callback.h"
+#include "kwctoolkit/system/system_info.h"
+
+using namespace kwc;
+using namespace kwc::system;
+
+namespace {
+void Increment(std::atomic<int>* counter) {
+    counter->fetch_add(1);
+}
+
+struct Spawner {
+    void spawn(int depth) {
+        counter.fetch_add(1);
+        if (depth > 0) {
+            executor->add(MakeCallback(this, &Spawner::spawn, depth - 1));
+            executor->add(MakeCallback(this, &Spawner::spawn, depth - 1));
+        }
+    }
+
+    Executor* executor;
+    std::atomic<int> counter{0};
+};
+
+struct ThreadRecorder {
+    void record() {
+        std::lock_guard<std::mutex> guard(mutex);
+        threads.insert(std::this_thread::get_id());
+    }
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+};
+}  // namespace
+
+TEST(ThreadPoolExecutorTest, DefaultsToNumberOfCPUs) {
+    ThreadPoolExecutor executor;
+    EXPECT_EQ(executor.numThreads(), SystemInfo::getNumberOfCPUs());
+}
+
+TEST(ThreadPoolExecutorTest, RunsAllCallbacks) {
+    std::atomic<int> counter{0};
+    ThreadPoolExecutor executor(4);
+    for (int idx = 0; idx < 10000; ++idx) {
+        executor.add(MakeCallback(&Increment, &counter));
+    }
+    executor.drain();
+    EXPECT_EQ(counter.load(), 10000);
+    EXPECT_EQ(executor.numPendingTasks(), 0);
+}
+
+TEST(ThreadPoolExecutorTest, RunsCallbacksAddedFromWorkers) {
+    ThreadPoolExecutor executor(4);
+    Spawner spawner;
+    spawner.executor = &executor;
+    executor.add(MakeCallback(&spawner, &Spawner::spawn, 12));
+    executor.drain();
+    EXPECT_EQ(spawner.counter.load(), (1 << 13) - 1);
+}
+
+TEST(ThreadPoolExecutorTest, RunsCallbacksOffTheCallingThread) {
+    ThreadRecorder recorder;
+    ThreadPoolExecutor executor(2);
+    for (int idx = 0; idx < 100; ++idx) {
+        executor.add(MakeCallback(&recorder, &ThreadRecorder::record));
+    }
+    executor.drain();
+    EXPECT_EQ(recorder.threads.count(std::this_thread::get_id()), 0u);
+}
+
+TEST(ThreadPoolExecutorTest, ShutdownDrainsPendingWork) {
+    std::atomic<int> counter{0};
+    ThreadPoolExecutor executor(3);
+    for (int idx = 0; idx < 1000; ++idx) {
+        executor.add(MakeCallback(&Increment, &counter));
+    }
+    executor.shutdown();
+    EXPECT_EQ(counter.load(), 1000);
+
+    // After shutdown, callbacks are run inline
+    executor.add(MakeCallback(&Increment, &counter));
+    EXPECT_EQ(counter.load(), 1001);
+    executor.shutdown();
+}
+
+TEST(ThreadPoolExecutorTest, ShutdownRunsCallbacksAddedConcurrently) {
+    for (int round = 0; round < 50; ++round) {
+        std::atomic<int> counter{0};
+        ThreadPoolExecutor executor(2);
+        std::atomic<bool> go{false};
+        std::vector<std::thread> producers;
+        for (int idx = 0; idx < 4; ++idx) {
+            producers.emplace_back([&] {
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                for (int n = 0; n < 500; ++n) {
+                    executor.add(MakeCallback(&Increment, &counter));
+                }
+            });
+        }
+        go.store(true);
+        executor.shutdown();
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        EXPECT_EQ(counter.load(), 2000);
+        EXPECT_EQ(executor.numPendingTasks(), 0);
+    }
+}
+
+TEST(ThreadPoolExecutorTest, AcceptsWorkFromManyThreads) {
+    std::atomic<int> counter{0};
+    ThreadPoolExecutor executor(4);
+    std::vector<std::thread> producers;
+    for (int idx = 0; idx < 4; ++idx) {
+        producers.emplace_back([&] {
+            for (int n = 0; n < 2500; ++n) {
+                executor.add(MakeCallback(&Increment, &counter));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    executor.drain();
+    EXPECT_EQ(counter.load(), 10000);
+}
+
+TEST(ThreadPoolExecutorTest, RunsUniqueFunctions) {
+    std::atomic<int> counter{0};
+    ThreadPoolExecutor executor(2);
+    for (int idx = 0; idx < 100; ++idx) {
+        auto value = std::make_unique<int>(idx);
+        executor.add([&counter, value = std::move(value)] { counter.fetch_add(*value); });
+    }
+    executor.drain();
+    EXPECT_EQ(counter.load(), 4950);
+
+    // The inline executor runs them right away
+    std::unique_ptr<Executor> inline_executor(MakeInlineExecutor());
+    inline_executor->add([&counter] { counter.fetch_add(1); });
+    EXPECT_EQ(counter.load(), 4951);
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_SYSTEM_WORK_STEALING_DEQUE_H_
+#define KWCTOOLKIT_SYSTEM_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "kwctoolkit/base/compiler.h"
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/macros.h"
+
+namespace kwc {
+namespace system {
+
+// Lock-free single-owner, multi-thief deque of pointers
+//
+// This is the dynamic circular work-stealing deque by Chase and Lev (SPAA '05)
+// using the C11 memory model mapping from Le et al. "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (PPoPP '13).
+//
+// Only the owning thread may call |push()| and |pop()|, which operate on the
+// bottom end in LIFO order. Any other thread may call |steal()|, which takes
+// elements from the top end in FIFO order. The deque never blocks and grows
+// on demand. Retired buffers are kept alive until the deque is destroyed, as
+// concurrent thieves may still read from them.
+template <typename T>
+class WorkStealingDeque {
+  public:
+    explicit WorkStealingDeque(int64 initial_capacity = 256)
+        : top_(0), bottom_(0), buffer_(new Buffer(RoundUpToPowerOfTwo(initial_capacity))) {
+        retired_.emplace_back(buffer_.load(std::memory_order_relaxed));
+    }
+
+    ~WorkStealingDeque() = default;
+
+    // Owner only. Pushes |item| to the bottom end of the deque
+    void push(T* item) {
+        const int64 bottom = bottom_.load(std::memory_order_relaxed);
+        const int64 top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->capacity() - 1) {
+            buffer = grow(buffer, bottom, top);
+        }
+        buffer->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only. Pops the most recently pushed item or returns nullptr
+    T* pop() {
+        const int64 bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64 top = top_.load(std::memory_order_relaxed);
+
+        T* item = nullptr;
+        if (top <= bottom) {
+            item = buffer->get(bottom);
+            if (top == bottom) {
+                // Last element, race against concurrent thieves
+                if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread. Steals the least recently pushed item or returns nullptr if
+    // the deque is empty or the steal lost a race against another thread
+    T* steal() {
+        int64 top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64 bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top < bottom) {
+            Buffer* buffer = buffer_.load(std::memory_order_acquire);
+            T* item = buffer->get(top);
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return item;
+        }
+        return nullptr;
+    }
+
+    // Approximate number of queued items. Only exact if called by the owner
+    // while no thief is active
+    int64 size() const {
+        const int64 bottom = bottom_.load(std::memory_order_relaxed);
+        const int64 top = top_.load(std::memory_order_relaxed);
+        return bottom >= top ? bottom - top : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+  private:
+    class Buffer {
+      public:
+        explicit Buffer(int64 capacity)
+            : capacity_(capacity), mask_(capacity - 1), items_(new std::atomic<T*>[capacity]) {}
+
+        int64 capacity() const { return capacity_; }
+
+        T* get(int64 index) const {
+            return items_[index & mask_].load(std::memory_order_relaxed);
+        }
+
+        void put(int64 index, T* item) {
+            items_[index & mask_].store(item, std::memory_order_relaxed);
+        }
+
+      private:
+        const int64 capacity_;
+        const int64 mask_;
+        std::unique_ptr<std::atomic<T*>[]> items_;
+    };
+
+    static int64 RoundUpToPowerOfTwo(int64 value) {
+        int64 result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    Buffer* grow(Buffer* old_buffer, int64 bottom, int64 top) {
+        auto* buffer = new Buffer(old_buffer->capacity() * 2);
+        for (int64 idx = top; idx < bottom; ++idx) {
+            buffer->put(idx, old_buffer->get(idx));
+        }
+        retired_.emplace_back(buffer);
+        buffer_.store(buffer, std::memory_order_release);
+        return buffer;
+    }
+
+    // |top_| is hammered by thieves whereas |bottom_| is mostly touched by the
+    // owner. Keep both on separate cache lines to avoid false sharing
+    std::atomic<int64> top_;
+    char top_padding_[KWC_CACHELINE_SIZE - sizeof(std::atomic<int64>)];
+    std::atomic<int64> bottom_;
+    char bottom_padding_[KWC_CACHELINE_SIZE - sizeof(std::atomic<int64>)];
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> retired_;
+
+    DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace system
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_SYSTEM_WORK_STEALING_DEQUE_H_
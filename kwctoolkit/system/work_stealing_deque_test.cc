@@ -0,0 +1,90 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/system/work_stealing_deque.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace kwc::system;
+
+TEST(WorkStealingDequeTest, EmptyDequeReturnsNull) {
+    WorkStealingDeque<int> deque;
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, OwnerPopsLifoThiefStealsFifo) {
+    int values[3] = {0, 1, 2};
+    WorkStealingDeque<int> deque;
+    for (auto& value : values) {
+        deque.push(&value);
+    }
+    EXPECT_EQ(deque.size(), 3);
+    EXPECT_EQ(deque.pop(), &values[2]);
+    EXPECT_EQ(deque.steal(), &values[0]);
+    EXPECT_EQ(deque.pop(), &values[1]);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, GrowsBeyondInitialCapacity) {
+    std::vector<int> values(1000);
+    WorkStealingDeque<int> deque(4);
+    for (auto& value : values) {
+        deque.push(&value);
+    }
+    for (auto it = values.rbegin(); it != values.rend(); ++it) {
+        ASSERT_EQ(deque.pop(), &*it);
+    }
+    EXPECT_EQ(deque.pop(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnce) {
+    constexpr int kNumItems = 100000;
+    constexpr int kNumThieves = 3;
+    std::vector<int> values(kNumItems);
+    std::vector<std::atomic<int>> taken(kNumItems);
+    for (auto& count : taken) {
+        count = 0;
+    }
+
+    WorkStealingDeque<int> deque(16);
+    std::atomic<bool> done{false};
+    auto take = [&](int* item) { taken[item - values.data()].fetch_add(1); };
+
+    std::vector<std::thread> thieves;
+    for (int idx = 0; idx < kNumThieves; ++idx) {
+        thieves.emplace_back([&] {
+            while (!done.load()) {
+                if (auto* item = deque.steal()) {
+                    take(item);
+                }
+            }
+        });
+    }
+
+    for (int idx = 0; idx < kNumItems; ++idx) {
+        deque.push(&values[idx]);
+        if (idx % 3 == 0) {
+            if (auto* item = deque.pop()) {
+                take(item);
+            }
+        }
+    }
+    while (auto* item = deque.pop()) {
+        take(item);
+    }
+    done = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (const auto& count : taken) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
@@ -96,10 +96,22 @@ void HttpRequest::setCallback(HttpRequestCallback* callback) {
     getModifiableRequestState()->setCallback(this, callback);
 }
 
+void HttpRequest::setCallback(HttpRequestFunction callback) {
+    getModifiableRequestState()->setCallback(this, std::move(callback));
+}
+
 void HttpRequestState::setCallback(HttpRequest* request, HttpRequestCallback* callback) {
+    if (callback == nullptr) {
+        setCallback(request, HttpRequestFunction());
+        return;
+    }
+    setCallback(request, [callback](HttpRequest* req) { callback->run(req); });
+}
+
+void HttpRequestState::setCallback(HttpRequest* request, HttpRequestFunction callback) {
     std::lock_guard<std::mutex> guard(mutex_);
     request_ = request;
-    callback_ = callback;
+    callback_ = std::move(callback);
 }
 
 base::Status HttpRequest::execute() {
@@ -123,5 +135,14 @@ void HttpRequest::executeAsync(HttpRequestCallback* callback) {
     }
 }
 
+void HttpRequest::executeAsync(HttpRequestFunction callback) {
+    auto* state = getResponse()->getModifiableRequestState();
+    KWC_CHECK_EQ(HttpRequestState::UNSENT, state->getStateCode())
+        << "Must call clear() before reusing";
+    if (callback) {
+        setCallback(std::move(callback));
+    }
+}
+
 }  // namespace transport
 }  // namespace kwc
\ No newline at end of file
@@ -71,6 +71,8 @@ class HttpRequest {
 
     void setCallback(HttpRequestCallback* callback);
 
+    void setCallback(HttpRequestFunction callback);
+
     void addHeader(const std::string& name, const std::string& value);
 
     void removeHeader(const std::string& name);
@@ -83,6 +85,8 @@ class HttpRequest {
 
     void executeAsync(HttpRequestCallback* callback);
 
+    void executeAsync(HttpRequestFunction callback);
+
   protected:
     friend class HttpRequestProcessor;
     HttpRequest(HttpMethod method, HttpTransaction* transaction);
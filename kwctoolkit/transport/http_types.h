@@ -14,6 +14,7 @@
 #include "kwctoolkit/base/integral_types.h"
 #include "kwctoolkit/base/macros.h"
 #include "kwctoolkit/base/status.h"
+#include "kwctoolkit/base/unique_function.h"
 
 namespace kwc {
 namespace transport {
@@ -27,6 +28,9 @@ using HttpHeaderMap = std::map<std::string, std::string>;
 // Used for notification on asynchronous requests.
 using HttpRequestCallback = Callback1<HttpRequest*>;
 
+// Allocation-free alternative to HttpRequestCallback for small closures
+using HttpRequestFunction = UniqueFunction<void(HttpRequest*)>;
+
 class HttpStatusCode {
   public:
     // Symbolic names for common HTTP status codes.
@@ -147,14 +151,15 @@ class HttpRequestState {
   private:
     bool hasCallback() {
         std::lock_guard<std::mutex> guard(mutex_);
-        return callback_ != nullptr;
+        return static_cast<bool>(callback_);
     }
 
     void setCallback(HttpRequest* request, HttpRequestCallback* callback);
+    void setCallback(HttpRequest* request, HttpRequestFunction callback);
 
   private:
     friend class HttpRequest;
-    HttpRequestCallback* callback_;
+    HttpRequestFunction callback_;
     mutable std::mutex mutex_;
     StateCode state_code_{UNSENT};
     base::Status transaction_status_;
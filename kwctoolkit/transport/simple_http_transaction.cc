@@ -443,7 +443,7 @@ void SimpleHttpRequest::doExecute(HttpResponse* response) {
 }
 
 SimpleHttpTransaction::SimpleHttpTransaction(const HttpTransactionOptions& options)
-    : HttpTransaction(options) {
+    : HttpTransaction(options), processors_(kMaxIdleProcessors) {
     setId(kTransactionIdentifier);
 }
 
@@ -462,26 +462,25 @@ std::unique_ptr<HttpTransaction> SimpleHttpTransactionFactory::alloc(
 }
 
 SimpleHttpTransaction::~SimpleHttpTransaction() {
-    for (SimpleHttpProcessor* processor : processors_) {
+    SimpleHttpProcessor* processor = nullptr;
+    while (processors_.tryPop(&processor)) {
         delete processor;
     }
 }
 
 SimpleHttpProcessor* SimpleHttpTransaction::acquireProcessor() {
-    {
-        std::lock_guard<std::mutex> guard(mutex_);
-        if (!processors_.empty()) {
-            SimpleHttpProcessor* processor = processors_.back();
-            processors_.pop_back();
-            return processor;
-        }
+    SimpleHttpProcessor* processor = nullptr;
+    if (processors_.tryPop(&processor)) {
+        return processor;
     }
     return new SimpleHttpProcessor(this);
 }
 
 void SimpleHttpTransaction::releaseProcessor(SimpleHttpProcessor* processor) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    processors_.push_back(processor);
+    // Only keep a bounded number of idle processors around
+    if (!processors_.tryPush(processor)) {
+        delete processor;
+    }
 }
 
 }  // namespace transport
@@ -5,10 +5,11 @@
 #ifndef KWCTOOLKIT_TRANSPORT_SIMPLE_HTTP_TRANSACTION_H_
 #define KWCTOOLKIT_TRANSPORT_SIMPLE_HTTP_TRANSACTION_H_
 
+#include <cstddef>
 #include <memory>
-#include <vector>
 
 #include "kwctoolkit/base/macros.h"
+#include "kwctoolkit/system/mpmc_queue.h"
 #include "kwctoolkit/transport/http_transaction.h"
 
 namespace kwc {
@@ -45,8 +46,10 @@ class SimpleHttpTransaction : public HttpTransaction {
     // |releaseProcessor()| is called.
     SimpleHttpProcessor* acquireProcessor();
     void releaseProcessor(SimpleHttpProcessor* processor);
-    std::mutex mutex_;
-    std::vector<SimpleHttpProcessor*> processors_;
+
+    // Maximum number of idle processors kept for reuse
+    static constexpr std::size_t kMaxIdleProcessors = 16;
+    system::BoundedMpmcQueue<SimpleHttpProcessor*> processors_;
 
     friend class SimpleHttpRequest;
     DISALLOW_COPY_AND_ASSIGN(SimpleHttpTransaction);
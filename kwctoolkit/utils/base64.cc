@@ -4,103 +4,458 @@
 
 #include "kwctoolkit/utils/base64.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include <immintrin.h>
+
+    #include "kwctoolkit/system/cpu.h"
+#endif
 
 namespace kwc {
 namespace utils {
 namespace {
-const std::string kBase64Chars =
+constexpr char kStandardChars[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
     "abcdefghijklmnopqrstuvwxyz"
     "0123456789+/";
+constexpr char kUrlChars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz"
+    "0123456789-_";
+
+// Sextet of every character, -1 for characters outside of the alphabet
+struct DecodeTable {
+    explicit constexpr DecodeTable(const char* chars) : values() {
+        for (int idx = 0; idx < 256; ++idx) {
+            values[idx] = -1;
+        }
+        for (int idx = 0; idx < 64; ++idx) {
+            values[static_cast<uint8>(chars[idx])] = static_cast<int8>(idx);
+        }
+    }
+
+    int8 values[256];
+};
+
+constexpr DecodeTable kStandardTable(kStandardChars);
+constexpr DecodeTable kUrlTable(kUrlChars);
 
-bool IsBase64(unsigned char c) {
-    return (std::isalnum(c) || (c == '+') || (c == '/'));
+const char* Chars(Base64Alphabet alphabet) {
+    return alphabet == Base64Alphabet::Url ? kUrlChars : kStandardChars;
+}
+
+const int8* Sextets(Base64Alphabet alphabet) {
+    return alphabet == Base64Alphabet::Url ? kUrlTable.values : kStandardTable.values;
+}
+
+using EncodeGroupsFunction = std::size_t (*)(const uint8*, std::size_t, char*, Base64Alphabet);
+using DecodeGroupsFunction = std::size_t (*)(const char*, std::size_t, uint8*, Base64Alphabet);
+
+// Encodes the last one or two bytes and returns the number of characters
+std::size_t EncodeTail(const uint8* source, std::size_t size, char* dest, const char* chars,
+                       Base64Padding padding) {
+    const uint32 value = (source[0] << 16) | (size > 1 ? source[1] << 8 : 0);
+    dest[0] = chars[value >> 18];
+    dest[1] = chars[(value >> 12) & 0x3f];
+    if (size > 1) {
+        dest[2] = chars[(value >> 6) & 0x3f];
+    }
+    if (padding == Base64Padding::Unpadded) {
+        return size + 1;
+    }
+    if (size == 1) {
+        dest[2] = '=';
+    }
+    dest[3] = '=';
+    return 4;
 }
-}  // namespace
 
-std::string Base64Encode(unsigned const char* bytes_to_encode, unsigned int in_len) {
-    std::string ret;
-    int i = 0;
-    int j = 0;
-    unsigned char char_array_3[3];
-    unsigned char char_array_4[4];
-
-    while (in_len--) {
-        char_array_3[i++] = *(bytes_to_encode++);
-        if (i == 3) {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
-
-            for (i = 0; (i < 4); i++)
-                ret += kBase64Chars[char_array_4[i]];
-            i = 0;
+// Decodes less than four characters up to the first one outside of the
+// alphabet and returns the number of bytes written
+std::size_t DecodeTail(const char* source, std::size_t size, uint8* dest, const int8* sextets) {
+    uint32 value = 0;
+    int count = 0;
+    for (; count < static_cast<int>(size); ++count) {
+        const int32 sextet = sextets[static_cast<uint8>(source[count])];
+        if (sextet < 0) {
+            break;
         }
+        value = (value << 6) | static_cast<uint32>(sextet);
     }
+    if (count < 2) {
+        return 0;
+    }
+    value <<= 6 * (4 - count);
+    dest[0] = static_cast<uint8>(value >> 16);
+    if (count == 3) {
+        dest[1] = static_cast<uint8>(value >> 8);
+    }
+    return static_cast<std::size_t>(count - 1);
+}
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+// Spreads the 24 bits of every group of three bytes into four sextets, one
+// per byte. Groups start at bytes 0, 3, 6 and 9 of every 128 bit lane. See
+// W. Mula and D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions", ACM Transactions on the Web 12(3), 2018
+KWC_TARGET_ATTRIBUTE("ssse3")
+inline __m128i SplitSextetsSsse3(__m128i input) {
+    // Bytes b0 b1 b2 of every group into b1 b0 b2 b1, such that the 16 bit
+    // multiplications move every sextet into its own byte
+    input = _mm_shuffle_epi8(input,
+                             _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i first = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)),
+                                          _mm_set1_epi32(0x04000040));
+    const __m128i second = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)),
+                                           _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(first, second);
+}
+
+// Characters of 16 sextets, by adding an offset looked up per range of the
+// alphabet. Alphabets only differ in the characters |char62| and |char63|
+KWC_TARGET_ATTRIBUTE("ssse3")
+inline __m128i SextetsToCharsSsse3(__m128i sextets, char char62, char char63) {
+    // 0..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12 and 0..25 -> 13
+    __m128i range = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    const __m128i offsets = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, static_cast<char>(char62 - 62), static_cast<char>(char63 - 63), 'A',
+        0, 0);
+    return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, range));
+}
+
+KWC_TARGET_ATTRIBUTE("avx2")
+inline __m256i SplitSextetsAvx2(__m256i input) {
+    input = _mm256_shuffle_epi8(
+        input, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4,
+                                3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m256i first = _mm256_mulhi_epu16(
+        _mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+    const __m256i second = _mm256_mullo_epi16(
+        _mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(first, second);
+}
+
+KWC_TARGET_ATTRIBUTE("avx2")
+inline __m256i SextetsToCharsAvx2(__m256i sextets, char char62, char char63) {
+    __m256i range = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+    const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+    range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+    const auto offset62 = static_cast<char>(char62 - 62);
+    const auto offset63 = static_cast<char>(char63 - 63);
+    const __m256i offsets = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, offset62, offset63, 'A', 0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, offset62, offset63,
+        'A', 0, 0);
+    return _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, range));
+}
+
+// All ones for characters in [first, last], which are ASCII characters
+KWC_TARGET_ATTRIBUTE("ssse3")
+inline __m128i InRangeSsse3(__m128i chars, char first, char last) {
+    return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(static_cast<char>(first - 1))),
+                         _mm_cmplt_epi8(chars, _mm_set1_epi8(static_cast<char>(last + 1))));
+}
+
+// Sextets of 16 characters. Every character is compared against the ranges
+// of the alphabet, which yields the offset to its sextet. |valid| is set to
+// all ones for characters within the alphabet
+KWC_TARGET_ATTRIBUTE("ssse3")
+inline __m128i CharsToSextetsSsse3(__m128i chars, char char62, char char63, __m128i* valid) {
+    const __m128i upper = InRangeSsse3(chars, 'A', 'Z');
+    const __m128i lower = InRangeSsse3(chars, 'a', 'z');
+    const __m128i digit = InRangeSsse3(chars, '0', '9');
+    const __m128i sextet62 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(char62));
+    const __m128i sextet63 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(char63));
+    *valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, sextet62)),
+                          sextet63);
+    __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset = _mm_or_si128(
+        offset, _mm_and_si128(sextet62, _mm_set1_epi8(static_cast<char>(62 - char62))));
+    offset = _mm_or_si128(
+        offset, _mm_and_si128(sextet63, _mm_set1_epi8(static_cast<char>(63 - char63))));
+    return _mm_add_epi8(chars, offset);
+}
+
+// Packs four sextets of every 32 bit lane into three bytes at the start of
+// every group of four bytes, in the order of the shuffle
+KWC_TARGET_ATTRIBUTE("ssse3")
+inline __m128i JoinSextetsSsse3(__m128i sextets) {
+    const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+    const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(groups,
+                            _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+KWC_TARGET_ATTRIBUTE("avx2")
+inline __m256i InRangeAvx2(__m256i chars, char first, char last) {
+    return _mm256_and_si256(
+        _mm256_cmpgt_epi8(chars, _mm256_set1_epi8(static_cast<char>(first - 1))),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(last + 1)), chars));
+}
 
-    if (i) {
-        for (j = i; j < 3; j++)
-            char_array_3[j] = '\0';
+KWC_TARGET_ATTRIBUTE("avx2")
+inline __m256i CharsToSextetsAvx2(__m256i chars, char char62, char char63, __m256i* valid) {
+    const __m256i upper = InRangeAvx2(chars, 'A', 'Z');
+    const __m256i lower = InRangeAvx2(chars, 'a', 'z');
+    const __m256i digit = InRangeAvx2(chars, '0', '9');
+    const __m256i sextet62 = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(char62));
+    const __m256i sextet63 = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(char63));
+    *valid = _mm256_or_si256(
+        _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, sextet62)),
+        sextet63);
+    __m256i offset = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    offset = _mm256_or_si256(
+        offset, _mm256_and_si256(sextet62, _mm256_set1_epi8(static_cast<char>(62 - char62))));
+    offset = _mm256_or_si256(
+        offset, _mm256_and_si256(sextet63, _mm256_set1_epi8(static_cast<char>(63 - char63))));
+    return _mm256_add_epi8(chars, offset);
+}
 
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-        char_array_4[3] = char_array_3[2] & 0x3f;
+KWC_TARGET_ATTRIBUTE("avx2")
+inline __m256i JoinSextetsAvx2(__m256i sextets) {
+    const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+    const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    const __m256i lanes = _mm256_shuffle_epi8(
+        groups, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0,
+                                 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    // The 12 bytes of both lanes next to each other
+    return _mm256_permutevar8x32_epi32(lanes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
 
-        for (j = 0; (j < i + 1); j++)
-            ret += kBase64Chars[char_array_4[j]];
+EncodeGroupsFunction SelectEncodeGroups() {
+    const system::CPU& cpu = system::CPU::getInstance();
+    if (cpu.hasAvx2()) {
+        return internal::Base64EncodeGroupsAvx2;
+    }
+    if (cpu.hasSsse3()) {
+        return internal::Base64EncodeGroupsSsse3;
+    }
+    return internal::Base64EncodeGroupsScalar;
+}
 
-        while ((i++ < 3))
-            ret += '=';
+DecodeGroupsFunction SelectDecodeGroups() {
+    const system::CPU& cpu = system::CPU::getInstance();
+    if (cpu.hasAvx2()) {
+        return internal::Base64DecodeGroupsAvx2;
+    }
+    if (cpu.hasSsse3()) {
+        return internal::Base64DecodeGroupsSsse3;
     }
+    return internal::Base64DecodeGroupsScalar;
+}
+#else
+EncodeGroupsFunction SelectEncodeGroups() {
+    return internal::Base64EncodeGroupsScalar;
+}
 
-    return ret;
+DecodeGroupsFunction SelectDecodeGroups() {
+    return internal::Base64DecodeGroupsScalar;
 }
+#endif
+}  // namespace
 
-std::string Base64Decode(const std::string& encoded_string) {
-    int in_len = encoded_string.size();
-    int i = 0;
-    int j = 0;
-    int in = 0;
-    unsigned char char_array_4[4], char_array_3[3];
-    std::string ret;
+std::string Base64Encode(unsigned const char* bytes_to_encode, std::size_t in_len,
+                         Base64Alphabet alphabet, Base64Padding padding) {
+    std::string encoded(Base64EncodedSize(in_len, padding), '\0');
+    Base64Encode(bytes_to_encode, in_len, &encoded[0], alphabet, padding);
+    return encoded;
+}
 
-    while (in_len-- && (encoded_string[in] != '=') && IsBase64(encoded_string[in])) {
-        char_array_4[i++] = encoded_string[in];
-        in++;
-        if (i == 4) {
-            for (i = 0; i < 4; i++)
-                char_array_4[i] = kBase64Chars.find(char_array_4[i]);
+void Base64Encode(const uint8* source, std::size_t size, char* dest, Base64Alphabet alphabet,
+                  Base64Padding padding) {
+    static const EncodeGroupsFunction encode_groups = SelectEncodeGroups();
+    std::size_t consumed = encode_groups(source, size, dest, alphabet);
+    // The vector versions leave a few groups to the scalar version
+    consumed += internal::Base64EncodeGroupsScalar(source + consumed, size - consumed,
+                                                   dest + consumed / 3 * 4, alphabet);
+    if (consumed < size) {
+        EncodeTail(source + consumed, size - consumed, dest + consumed / 3 * 4, Chars(alphabet),
+                   padding);
+    }
+}
 
-            char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-            char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-            char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+std::string Base64Decode(const std::string& encoded_string, Base64Alphabet alphabet) {
+    const char* source = encoded_string.data();
+    const std::size_t size = encoded_string.size();
+    // Exact for input without padding and characters outside the alphabet,
+    // otherwise shrunk to the decoded size afterwards
+    std::string decoded(Base64DecodedMaxSize(size), '\0');
+    auto* dest = reinterpret_cast<uint8*>(&decoded[0]);
+    const std::size_t consumed = Base64DecodeGroups(source, size, dest, alphabet);
+    const std::size_t num_bytes =
+        consumed / 4 * 3 + DecodeTail(source + consumed, std::min<std::size_t>(size - consumed, 3),
+                                      dest + consumed / 4 * 3, Sextets(alphabet));
+    decoded.resize(num_bytes);
+    return decoded;
+}
 
-            for (i = 0; (i < 3); i++)
-                ret += char_array_3[i];
-            i = 0;
+Base64DecodeResult Base64Decode(const char* source, std::size_t size, uint8* dest,
+                                Base64Alphabet alphabet, Base64Padding padding) {
+    const std::size_t consumed = Base64DecodeGroups(source, size, dest, alphabet);
+    const std::size_t num_bytes = consumed / 4 * 3;
+    if (consumed == size) {
+        return {num_bytes, kBase64NoError};
+    }
+
+    // The group which stopped Base64DecodeGroups(), which needs to be the
+    // last one. Its characters of the alphabet may only be followed by
+    // padding, if it is complete
+    const int8* sextets = Sextets(alphabet);
+    const char* group = source + consumed;
+    const std::size_t group_size = std::min<std::size_t>(size - consumed, 4);
+    std::size_t num_chars = 0;
+    while (num_chars < group_size && sextets[static_cast<uint8>(group[num_chars])] >= 0) {
+        ++num_chars;
+    }
+    std::size_t position = consumed + num_chars;
+    if (num_chars < group_size) {
+        if (padding == Base64Padding::Unpadded || num_chars < 2 || consumed + 4 != size) {
+            return {num_bytes, position};
         }
+        for (; position < size; ++position) {
+            if (source[position] != '=') {
+                return {num_bytes, position};
+            }
+        }
+    } else if (padding == Base64Padding::Padded || num_chars < 2) {
+        return {num_bytes, size};
     }
+    return {num_bytes + DecodeTail(group, num_chars, dest + num_bytes, sextets), kBase64NoError};
+}
 
-    if (i) {
-        for (j = i; j < 4; j++)
-            char_array_4[j] = 0;
+std::size_t Base64DecodeGroups(const char* source, std::size_t size, uint8* dest,
+                               Base64Alphabet alphabet) {
+    static const DecodeGroupsFunction decode_groups = SelectDecodeGroups();
+    const std::size_t consumed = decode_groups(source, size, dest, alphabet);
+    return consumed + internal::Base64DecodeGroupsScalar(source + consumed, size - consumed,
+                                                         dest + consumed / 4 * 3, alphabet);
+}
+
+namespace internal {
+
+std::size_t Base64EncodeGroupsScalar(const uint8* source, std::size_t size, char* dest,
+                                     Base64Alphabet alphabet) {
+    const char* chars = Chars(alphabet);
+    const std::size_t num_groups = size / 3;
+    for (std::size_t group = 0; group < num_groups; ++group, source += 3, dest += 4) {
+        const uint32 value = (source[0] << 16) | (source[1] << 8) | source[2];
+        dest[0] = chars[value >> 18];
+        dest[1] = chars[(value >> 12) & 0x3f];
+        dest[2] = chars[(value >> 6) & 0x3f];
+        dest[3] = chars[value & 0x3f];
+    }
+    return num_groups * 3;
+}
+
+std::size_t Base64DecodeGroupsScalar(const char* source, std::size_t size, uint8* dest,
+                                     Base64Alphabet alphabet) {
+    const int8* sextets = Sextets(alphabet);
+    const auto* input = reinterpret_cast<const uint8*>(source);
+    std::size_t consumed = 0;
+    for (; consumed + 4 <= size; consumed += 4, dest += 3) {
+        const int32 a = sextets[input[consumed]];
+        const int32 b = sextets[input[consumed + 1]];
+        const int32 c = sextets[input[consumed + 2]];
+        const int32 d = sextets[input[consumed + 3]];
+        // Characters outside of the alphabet are the only negative values
+        if ((a | b | c | d) < 0) {
+            break;
+        }
+        const uint32 value = (a << 18) | (b << 12) | (c << 6) | d;
+        dest[0] = static_cast<uint8>(value >> 16);
+        dest[1] = static_cast<uint8>(value >> 8);
+        dest[2] = static_cast<uint8>(value);
+    }
+    return consumed;
+}
 
-        for (j = 0; j < 4; j++)
-            char_array_4[j] = kBase64Chars.find(char_array_4[j]);
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+KWC_TARGET_ATTRIBUTE("ssse3")
+std::size_t Base64EncodeGroupsSsse3(const uint8* source, std::size_t size, char* dest,
+                                    Base64Alphabet alphabet) {
+    const char char62 = Chars(alphabet)[62];
+    const char char63 = Chars(alphabet)[63];
+    std::size_t consumed = 0;
+    for (; consumed + 16 <= size; consumed += 12, dest += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + consumed));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest),
+                         SextetsToCharsSsse3(SplitSextetsSsse3(input), char62, char63));
+    }
+    return consumed;
+}
 
-        char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-        char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-        char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+KWC_TARGET_ATTRIBUTE("avx2")
+std::size_t Base64EncodeGroupsAvx2(const uint8* source, std::size_t size, char* dest,
+                                   Base64Alphabet alphabet) {
+    const char char62 = Chars(alphabet)[62];
+    const char char63 = Chars(alphabet)[63];
+    std::size_t consumed = 0;
+    for (; consumed + 28 <= size; consumed += 24, dest += 32) {
+        const auto* input = reinterpret_cast<const __m128i*>(source + consumed);
+        const __m256i lanes = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(input)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + consumed + 12)), 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest),
+                            SextetsToCharsAvx2(SplitSextetsAvx2(lanes), char62, char63));
+    }
+    return consumed;
+}
 
-        for (j = 0; (j < i - 1); j++)
-            ret += char_array_3[j];
+KWC_TARGET_ATTRIBUTE("ssse3")
+std::size_t Base64DecodeGroupsSsse3(const char* source, std::size_t size, uint8* dest,
+                                    Base64Alphabet alphabet) {
+    const char char62 = Chars(alphabet)[62];
+    const char char63 = Chars(alphabet)[63];
+    std::size_t consumed = 0;
+    for (; consumed + 16 <= size; consumed += 16, dest += 12) {
+        __m128i valid;
+        const __m128i sextets = CharsToSextetsSsse3(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + consumed)), char62, char63,
+            &valid);
+        if (_mm_movemask_epi8(valid) != 0xffff) {
+            break;
+        }
+        const __m128i bytes = JoinSextetsSsse3(sextets);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest), bytes);
+        const int32 last = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+        std::memcpy(dest + 8, &last, sizeof(last));
     }
+    return consumed;
+}
 
-    return ret;
+KWC_TARGET_ATTRIBUTE("avx2")
+std::size_t Base64DecodeGroupsAvx2(const char* source, std::size_t size, uint8* dest,
+                                   Base64Alphabet alphabet) {
+    const char char62 = Chars(alphabet)[62];
+    const char char63 = Chars(alphabet)[63];
+    std::size_t consumed = 0;
+    for (; consumed + 32 <= size; consumed += 32, dest += 24) {
+        __m256i valid;
+        const __m256i sextets = CharsToSextetsAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + consumed)), char62,
+            char63, &valid);
+        if (_mm256_movemask_epi8(valid) != -1) {
+            break;
+        }
+        const __m256i bytes = JoinSextetsAvx2(sextets);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm256_castsi256_si128(bytes));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + 16), _mm256_extracti128_si256(bytes, 1));
+    }
+    return consumed;
 }
+#endif
+
+}  // namespace internal
 
 }  // namespace utils
-}  // namespace kwc
\ No newline at end of file
+}  // namespace kwc
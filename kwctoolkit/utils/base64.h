@@ -5,13 +5,120 @@
 #ifndef KWCTOOLKIT_UTILS_BASE64_H_
 #define KWCTOOLKIT_UTILS_BASE64_H_
 
+#include <cstddef>
 #include <string>
 
+#include "kwctoolkit/base/compiler.h"
+#include "kwctoolkit/base/integral_types.h"
+
 namespace kwc {
 namespace utils {
 
-std::string Base64Encode(unsigned const char* bytes_to_encode, unsigned int in_len);
-std::string Base64Decode(const std::string& encoded_string);
+// Alphabets of RFC 4648, which differ in the characters of the sextets 62
+// and 63: '+' and '/' for Standard, '-' and '_' for Url, which is safe for
+// URLs and file names
+enum class Base64Alphabet { Standard, Url };
+
+// Padded encodings consist of whole groups of four characters, by completing
+// the last group with '='. Unpadded encodings end with an incomplete group
+// of two or three characters for one or two remaining bytes
+enum class Base64Padding { Padded, Unpadded };
+
+// Number of characters encoding |size| bytes
+constexpr std::size_t Base64EncodedSize(std::size_t size,
+                                        Base64Padding padding = Base64Padding::Padded) {
+    return padding == Base64Padding::Padded ? (size + 2) / 3 * 4
+                                            : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+}
+
+// Upper bound of the bytes decoded from |size| characters, which is exact
+// for valid input without padding
+constexpr std::size_t Base64DecodedMaxSize(std::size_t size) {
+    return size / 4 * 3 + (size % 4 == 0 ? 0 : size % 4 - 1);
+}
+
+// Encodes |in_len| bytes, with the standard alphabet and padding by default
+std::string Base64Encode(unsigned const char* bytes_to_encode, std::size_t in_len,
+                         Base64Alphabet alphabet = Base64Alphabet::Standard,
+                         Base64Padding padding = Base64Padding::Padded);
+
+// Encodes |size| bytes of |source| to Base64EncodedSize(size, padding)
+// characters at |dest|. Sizes which are a multiple of three yield no padding,
+// such that a stream can be encoded in chunks of whole groups
+void Base64Encode(const uint8* source, std::size_t size, char* dest,
+                  Base64Alphabet alphabet = Base64Alphabet::Standard,
+                  Base64Padding padding = Base64Padding::Padded);
+
+// Decodes |encoded_string| up to its first character outside of |alphabet|,
+// e.g. padding or whitespace. Up to three trailing characters without
+// padding yield as many bytes as they cover completely
+std::string Base64Decode(const std::string& encoded_string,
+                         Base64Alphabet alphabet = Base64Alphabet::Standard);
+
+// Value of Base64DecodeResult::error_position for valid input
+constexpr std::size_t kBase64NoError = ~std::size_t{0};
+
+struct Base64DecodeResult {
+    // Number of bytes written
+    std::size_t size;
+    // Position of the first character which makes the input invalid, which
+    // is the size of the input if it ends prematurely
+    std::size_t error_position;
+
+    bool ok() const { return error_position == kBase64NoError; }
+};
+
+// Decodes |size| characters of |source| to |dest| without allocating, which
+// needs room for Base64DecodedMaxSize(size) bytes. Unlike the lenient
+// Base64Decode() above, the whole input needs to be valid: characters of
+// |alphabet| only, followed by padding as given by |padding|. On errors
+// only the groups before the invalid character are written.
+//
+// Example:
+//
+//     uint8 token[64];
+//     if (Base64DecodedMaxSize(size) > sizeof(token)) {
+//         return false;
+//     }
+//     const auto result = Base64Decode(data, size, token, Base64Alphabet::Url,
+//                                      Base64Padding::Unpadded);
+//     if (!result.ok()) {
+//         LOGGING(base::WARNING) << "Invalid token at " << result.error_position;
+//     }
+Base64DecodeResult Base64Decode(const char* source, std::size_t size, uint8* dest,
+                                Base64Alphabet alphabet = Base64Alphabet::Standard,
+                                Base64Padding padding = Base64Padding::Padded);
+
+// Decodes whole groups of four characters of |source| to three bytes each at
+// |dest|, up to the first group containing a character outside of
+// |alphabet|. Returns the number of characters consumed
+std::size_t Base64DecodeGroups(const char* source, std::size_t size, uint8* dest,
+                               Base64Alphabet alphabet = Base64Alphabet::Standard);
+
+namespace internal {
+// Inner loops of the codec. Encoders consume whole groups of three bytes,
+// decoders whole groups of four characters up to the first group containing
+// a character outside of the alphabet. Both return the number of bytes,
+// respectively characters consumed, leaving the rest to the scalar code
+std::size_t Base64EncodeGroupsScalar(const uint8* source, std::size_t size, char* dest,
+                                     Base64Alphabet alphabet);
+std::size_t Base64DecodeGroupsScalar(const char* source, std::size_t size, uint8* dest,
+                                     Base64Alphabet alphabet);
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+// Only to be called if system::CPU reports support for the extension. The
+// vector versions stop earlier than the scalar ones, as they process 12 or
+// 24 bytes at once and encoders read 4 bytes beyond each block of input
+std::size_t Base64EncodeGroupsSsse3(const uint8* source, std::size_t size, char* dest,
+                                    Base64Alphabet alphabet);
+std::size_t Base64EncodeGroupsAvx2(const uint8* source, std::size_t size, char* dest,
+                                   Base64Alphabet alphabet);
+std::size_t Base64DecodeGroupsSsse3(const char* source, std::size_t size, uint8* dest,
+                                    Base64Alphabet alphabet);
+std::size_t Base64DecodeGroupsAvx2(const char* source, std::size_t size, uint8* dest,
+                                   Base64Alphabet alphabet);
+#endif
+}  // namespace internal
 
 }  // namespace utils
 }  // namespace kwc
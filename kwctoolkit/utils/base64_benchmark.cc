@@ -0,0 +1,150 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <cctype>
+#include <string>
+
+#include "kwctoolkit/utils/base64.h"
+#include "kwctoolkit/utils/benchmark.h"
+#include "tests/random_data.h"
+
+namespace {
+std::string MakeBinaryData(kwc::int64 size) {
+    return kwc::test::RandomBytes(static_cast<std::size_t>(size), 0x12345678);
+}
+
+std::string Encode(const std::string& data) {
+    return kwc::utils::Base64Encode(reinterpret_cast<const unsigned char*>(data.data()),
+                                    data.size());
+}
+
+// The former implementation, which appends every character to the result
+// and looks up every character to decode in the alphabet
+const std::string kLegacyChars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string LegacyEncode(const std::string& data) {
+    std::string encoded;
+    std::size_t idx = 0;
+    for (; idx + 3 <= data.size(); idx += 3) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&data[idx]);
+        encoded += kLegacyChars[bytes[0] >> 2];
+        encoded += kLegacyChars[((bytes[0] & 0x03) << 4) + (bytes[1] >> 4)];
+        encoded += kLegacyChars[((bytes[1] & 0x0f) << 2) + (bytes[2] >> 6)];
+        encoded += kLegacyChars[bytes[2] & 0x3f];
+    }
+    return encoded;
+}
+
+std::string LegacyDecode(const std::string& encoded) {
+    std::string decoded;
+    unsigned char sextets[4];
+    int count = 0;
+    for (const char ch : encoded) {
+        const auto byte = static_cast<unsigned char>(ch);
+        if (ch == '=' || !(std::isalnum(byte) || ch == '+' || ch == '/')) {
+            break;
+        }
+        sextets[count++] = static_cast<unsigned char>(kLegacyChars.find(ch));
+        if (count == 4) {
+            decoded += static_cast<char>((sextets[0] << 2) + ((sextets[1] & 0x30) >> 4));
+            decoded += static_cast<char>(((sextets[1] & 0xf) << 4) + ((sextets[2] & 0x3c) >> 2));
+            decoded += static_cast<char>(((sextets[2] & 0x3) << 6) + sextets[3]);
+            count = 0;
+        }
+    }
+    return decoded;
+}
+}  // namespace
+
+BENCHMARK(Base64Encode) {
+    const std::string data = MakeBinaryData(context.arg());
+    while (context.running()) {
+        auto encoded = Encode(data);
+        kwc::utils::DoNotOptimize(encoded);
+    }
+    context.setBytesProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(Base64Encode)->range(64, 1 << 20);
+
+// Throughput is given in decoded bytes, such that it is comparable with
+// Base64Encode
+BENCHMARK(Base64Decode) {
+    const std::string data = MakeBinaryData(context.arg());
+    const std::string encoded = Encode(data);
+    while (context.running()) {
+        auto decoded = kwc::utils::Base64Decode(encoded);
+        kwc::utils::DoNotOptimize(decoded);
+    }
+    context.setBytesProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(Base64Decode)->range(64, 1 << 20);
+
+// Reference for Base64Encode with whole groups of input
+BENCHMARK(Base64EncodeLegacy) {
+    const std::string data = MakeBinaryData(context.arg() / 3 * 3);
+    while (context.running()) {
+        auto encoded = LegacyEncode(data);
+        kwc::utils::DoNotOptimize(encoded);
+    }
+    context.setBytesProcessed(context.iterations() * static_cast<kwc::int64>(data.size()));
+}
+BENCHMARK_CONFIGURE(Base64EncodeLegacy)->range(64, 1 << 20);
+
+BENCHMARK(Base64DecodeLegacy) {
+    const std::string encoded = Encode(MakeBinaryData(context.arg() / 3 * 3));
+    while (context.running()) {
+        auto decoded = LegacyDecode(encoded);
+        kwc::utils::DoNotOptimize(decoded);
+    }
+    context.setBytesProcessed(context.iterations() * (context.arg() / 3 * 3));
+}
+BENCHMARK_CONFIGURE(Base64DecodeLegacy)->range(64, 1 << 20);
+
+// The table driven inner loops without vector instructions
+BENCHMARK(Base64EncodeScalar) {
+    const std::string data = MakeBinaryData(context.arg());
+    std::string encoded(data.size() / 3 * 4, '\0');
+    while (context.running()) {
+        kwc::utils::internal::Base64EncodeGroupsScalar(
+            reinterpret_cast<const kwc::uint8*>(data.data()), data.size(), &encoded[0],
+            kwc::utils::Base64Alphabet::Standard);
+        kwc::utils::DoNotOptimize(encoded);
+    }
+    context.setBytesProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(Base64EncodeScalar)->range(64, 1 << 20);
+
+BENCHMARK(Base64DecodeScalar) {
+    const std::string encoded = Encode(MakeBinaryData(context.arg()));
+    std::string decoded(encoded.size() / 4 * 3, '\0');
+    while (context.running()) {
+        kwc::utils::internal::Base64DecodeGroupsScalar(
+            encoded.data(), encoded.size(), reinterpret_cast<kwc::uint8*>(&decoded[0]),
+            kwc::utils::Base64Alphabet::Standard);
+        kwc::utils::DoNotOptimize(decoded);
+    }
+    context.setBytesProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(Base64DecodeScalar)->range(64, 1 << 20);
+
+// Validating unpadded URL-safe tokens of |context.arg()| bytes into a buffer
+// on the stack, the way request handlers check them
+BENCHMARK(Base64DecodeToken) {
+    const std::string data = MakeBinaryData(context.arg());
+    const std::string token = kwc::utils::Base64Encode(
+        reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+        kwc::utils::Base64Alphabet::Url, kwc::utils::Base64Padding::Unpadded);
+    kwc::uint8 decoded[256];
+    while (context.running()) {
+        const auto result =
+            kwc::utils::Base64Decode(token.data(), token.size(), decoded,
+                                     kwc::utils::Base64Alphabet::Url,
+                                     kwc::utils::Base64Padding::Unpadded);
+        kwc::utils::DoNotOptimize(result);
+        kwc::utils::DoNotOptimize(decoded);
+    }
+    context.setBytesProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(Base64DecodeToken)->arg(16)->arg(32)->arg(64)->arg(256);
@@ -6,10 +6,16 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <string>
 #include <vector>
 
 #include "kwctoolkit/base/integral_types.h"
 #include "kwctoolkit/strings/string_utils.h"
+#include "tests/random_data.h"
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include "kwctoolkit/system/cpu.h"
+#endif
 
 enum Encoding {
     // Official means the result is the expected encoding of the input
@@ -83,3 +89,200 @@ TEST_P(Base64Test, Decode) {
         EXPECT_EQ(param.decoded, result);
     }
 }
+
+namespace {
+std::vector<uint8> MakeBytes(std::size_t size) {
+    return test::RandomBytes<std::vector<uint8>>(size, 0x2545f491);
+}
+
+struct Kernels {
+    const char* name;
+    std::size_t (*encode)(const uint8*, std::size_t, char*, Base64Alphabet);
+    std::size_t (*decode)(const char*, std::size_t, uint8*, Base64Alphabet);
+};
+
+// Vector versions of the inner loops, which are supported by the CPU
+std::vector<Kernels> SupportedKernels() {
+    std::vector<Kernels> kernels;
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    const system::CPU& cpu = system::CPU::getInstance();
+    if (cpu.hasSsse3()) {
+        kernels.push_back(
+            {"SSSE3", internal::Base64EncodeGroupsSsse3, internal::Base64DecodeGroupsSsse3});
+    }
+    if (cpu.hasAvx2()) {
+        kernels.push_back(
+            {"AVX2", internal::Base64EncodeGroupsAvx2, internal::Base64DecodeGroupsAvx2});
+    }
+#endif
+    return kernels;
+}
+}  // namespace
+
+TEST(Base64CodecTest, DecodeRestoresEncodedBytes) {
+    for (std::size_t size = 0; size < 300; ++size) {
+        const auto bytes = MakeBytes(size);
+        const auto encoded = Base64Encode(bytes.data(), size);
+        ASSERT_EQ(encoded.size(), (size + 2) / 3 * 4);
+        const auto decoded = Base64Decode(encoded);
+        ASSERT_EQ(std::string(bytes.begin(), bytes.end()), decoded) << "size " << size;
+    }
+}
+
+TEST(Base64CodecTest, DecodeStopsAtFirstInvalidCharacter) {
+    const auto bytes = MakeBytes(90);
+    const auto encoded = Base64Encode(bytes.data(), bytes.size());
+    for (std::size_t pos = 0; pos < encoded.size(); ++pos) {
+        std::string corrupted = encoded;
+        corrupted[pos] = '*';
+        // Characters before |pos| cover pos * 6 bits, of which whole bytes
+        // are decoded
+        const auto expected = std::string(bytes.begin(), bytes.begin() + pos * 6 / 8);
+        ASSERT_EQ(expected, Base64Decode(corrupted)) << "at " << pos;
+    }
+}
+
+TEST(Base64CodecTest, VectorEncodeMatchesScalar) {
+    for (const auto& kernels : SupportedKernels()) {
+        for (const auto alphabet : {Base64Alphabet::Standard, Base64Alphabet::Url}) {
+            SCOPED_TRACE(kernels.name);
+            SCOPED_TRACE(static_cast<int>(alphabet));
+            for (std::size_t size = 0; size < 200; ++size) {
+                const auto bytes = MakeBytes(size);
+                std::string expected(size / 3 * 4, '\0');
+                std::string actual(size / 3 * 4, '\0');
+                internal::Base64EncodeGroupsScalar(bytes.data(), size, &expected[0], alphabet);
+                const auto consumed = kernels.encode(bytes.data(), size, &actual[0], alphabet);
+                ASSERT_EQ(consumed % 3, 0u);
+                ASSERT_LE(consumed, size);
+                // At most the last block is left to the scalar version
+                ASSERT_GE(consumed + 28, size);
+                EXPECT_EQ(expected.substr(0, consumed / 3 * 4), actual.substr(0, consumed / 3 * 4))
+                    << "size " << size;
+            }
+        }
+    }
+}
+
+TEST(Base64CodecTest, VectorDecodeMatchesScalar) {
+    const struct {
+        Base64Alphabet alphabet;
+        const char* chars;
+    } kAlphabets[] = {
+        {Base64Alphabet::Standard,
+         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"},
+        {     Base64Alphabet::Url,
+         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"},
+    };
+    for (const auto& kernels : SupportedKernels()) {
+        for (const auto& alphabet : kAlphabets) {
+            SCOPED_TRACE(kernels.name);
+            SCOPED_TRACE(alphabet.chars);
+            const auto bytes = MakeBytes(48);
+            const auto encoded = Base64Encode(bytes.data(), bytes.size(), alphabet.alphabet);
+            std::vector<uint8> decoded(bytes.size());
+            EXPECT_EQ(kernels.decode(encoded.data(), encoded.size(), decoded.data(),
+                                     alphabet.alphabet),
+                      encoded.size());
+            EXPECT_EQ(bytes, decoded);
+
+            // Every character outside of the alphabet at every position stops
+            // before the block containing it
+            for (int ch = 0; ch < 256; ++ch) {
+                if (std::strchr(alphabet.chars, ch) != nullptr && ch != 0) {
+                    continue;
+                }
+                for (std::size_t pos = 0; pos < encoded.size(); ++pos) {
+                    std::string corrupted = encoded;
+                    corrupted[pos] = static_cast<char>(ch);
+                    std::vector<uint8> actual(bytes.size());
+                    const auto consumed = kernels.decode(corrupted.data(), corrupted.size(),
+                                                         actual.data(), alphabet.alphabet);
+                    ASSERT_LE(consumed, pos / 4 * 4) << ch << " at " << pos;
+                    ASSERT_EQ(0, std::memcmp(bytes.data(), actual.data(), consumed / 4 * 3));
+                }
+            }
+        }
+    }
+}
+
+TEST(Base64CodecTest, UrlAlphabetAndPadding) {
+    const uint8 bytes[] = {0xfb, 0xff, 0xbf, 0xfe};
+    const struct {
+        Base64Alphabet alphabet;
+        Base64Padding padding;
+        const char* encoded;
+    } kCases[] = {
+        {Base64Alphabet::Standard,   Base64Padding::Padded, "+/+//g=="},
+        {Base64Alphabet::Standard, Base64Padding::Unpadded,   "+/+//g"},
+        {     Base64Alphabet::Url,   Base64Padding::Padded, "-_-__g=="},
+        {     Base64Alphabet::Url, Base64Padding::Unpadded,   "-_-__g"},
+    };
+    for (const auto& test_case : kCases) {
+        SCOPED_TRACE(test_case.encoded);
+        EXPECT_EQ(test_case.encoded,
+                  Base64Encode(bytes, sizeof(bytes), test_case.alphabet, test_case.padding));
+        EXPECT_EQ(std::string(bytes, bytes + sizeof(bytes)),
+                  Base64Decode(test_case.encoded, test_case.alphabet));
+
+        uint8 decoded[sizeof(bytes)];
+        const auto result = Base64Decode(test_case.encoded, std::strlen(test_case.encoded),
+                                         decoded, test_case.alphabet, test_case.padding);
+        EXPECT_TRUE(result.ok());
+        EXPECT_EQ(sizeof(bytes), result.size);
+        EXPECT_EQ(0, std::memcmp(bytes, decoded, sizeof(bytes)));
+    }
+    for (std::size_t size = 0; size <= sizeof(bytes); ++size) {
+        EXPECT_EQ(Base64Encode(bytes, size, Base64Alphabet::Url, Base64Padding::Unpadded).size(),
+                  Base64EncodedSize(size, Base64Padding::Unpadded));
+    }
+}
+
+TEST(Base64CodecTest, StrictDecodeRestoresEncodedBytes) {
+    for (const auto padding : {Base64Padding::Padded, Base64Padding::Unpadded}) {
+        for (std::size_t size = 0; size < 100; ++size) {
+            const auto bytes = MakeBytes(size);
+            const auto encoded =
+                Base64Encode(bytes.data(), size, Base64Alphabet::Url, padding);
+            std::vector<uint8> decoded(Base64DecodedMaxSize(encoded.size()));
+            const auto result = Base64Decode(encoded.data(), encoded.size(), decoded.data(),
+                                             Base64Alphabet::Url, padding);
+            ASSERT_TRUE(result.ok()) << "size " << size;
+            ASSERT_EQ(size, result.size);
+            decoded.resize(result.size);
+            ASSERT_EQ(bytes, decoded);
+        }
+    }
+}
+
+TEST(Base64CodecTest, StrictDecodeReportsErrorPosition) {
+    const struct {
+        const char* encoded;
+        Base64Padding padding;
+        std::size_t error_position;
+        std::size_t size;
+    } kCases[] = {
+        {                  "Zm9v",   Base64Padding::Padded, kBase64NoError, 3},
+        {                  "Zg==",   Base64Padding::Padded, kBase64NoError, 1},
+        {                  "Zm8=",   Base64Padding::Padded, kBase64NoError, 2},
+        {                    "Zg",   Base64Padding::Padded,              2, 0},
+        {                   "Zg=",   Base64Padding::Padded,              2, 0},
+        {                  "Zg==", Base64Padding::Unpadded,              2, 0},
+        {                    "Zg", Base64Padding::Unpadded, kBase64NoError, 1},
+        {                 "Zm9vY", Base64Padding::Unpadded,              5, 3},
+        {                  "Z===",   Base64Padding::Padded,              1, 0},
+        {                  "Zm9+",   Base64Padding::Padded,              3, 0},
+        {              "Zm9vYg==",   Base64Padding::Padded, kBase64NoError, 4},
+        {          "Zm9vYg==Zm9v",   Base64Padding::Padded,              6, 3},
+        {              "Zm9v Zm9",   Base64Padding::Padded,              4, 3},
+        {"Zm9vYmFyZm9vYmFyZm9vYm!",   Base64Padding::Padded,             22, 15},
+    };
+    for (const auto& test_case : kCases) {
+        SCOPED_TRACE(test_case.encoded);
+        uint8 decoded[32];
+        const auto result = Base64Decode(test_case.encoded, std::strlen(test_case.encoded),
+                                         decoded, Base64Alphabet::Url, test_case.padding);
+        EXPECT_EQ(test_case.error_position, result.error_position);
+        EXPECT_EQ(test_case.size, result.size);
+    }
+}
@@ -0,0 +1,659 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/utils/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include "kwctoolkit/base/assert.h"
+#include "kwctoolkit/base/compiler.h"
+#include "kwctoolkit/base/platform.h"
+#include "kwctoolkit/system/system_info.h"
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include "kwctoolkit/system/cpu.h"
+#endif
+
+namespace kwc {
+namespace utils {
+namespace {
+enum class OutputFormat { Console, Json, Csv };
+
+struct Options {
+    std::string filter = ".*";
+    int repetitions = 1;
+    OutputFormat format = OutputFormat::Console;
+};
+
+[[noreturn]] void ExitWithUsageError(const std::string& message) {
+    std::cerr << message << std::endl;
+    exit(1);
+}
+
+Options ParseOptions(int argc, const char* argv[]) {
+    const std::string kFilter = "--benchmark_filter=";
+    const std::string kRepetitions = "--benchmark_repetitions=";
+    const std::string kFormat = "--benchmark_format=";
+
+    Options options;
+    for (int i = 0; i < argc; i++) {
+        std::string argument{argv[i]};
+        if (argument.compare(0, kFilter.size(), kFilter) == 0) {
+            // replace all occurrences of * with .*
+            options.filter =
+                std::regex_replace(argument.substr(kFilter.size()), std::regex("\\*"), ".*");
+        } else if (argument.compare(0, kRepetitions.size(), kRepetitions) == 0) {
+            options.repetitions = std::atoi(argument.c_str() + kRepetitions.size());
+            if (options.repetitions < 1) {
+                ExitWithUsageError("Invalid repetitions: " + argument);
+            }
+        } else if (argument.compare(0, kFormat.size(), kFormat) == 0) {
+            const std::string format = argument.substr(kFormat.size());
+            if (format == "console") {
+                options.format = OutputFormat::Console;
+            } else if (format == "json") {
+                options.format = OutputFormat::Json;
+            } else if (format == "csv") {
+                options.format = OutputFormat::Csv;
+            } else {
+                ExitWithUsageError("Invalid format: " + format);
+            }
+        }
+    }
+    return options;
+}
+
+// Description of the machine the benchmarks run on, used for comparing
+// results across machines
+struct MachineInfo {
+    std::string cpu_brand;
+    int num_cpus;
+    std::string os_name;
+    std::string os_version;
+    std::string os_arch;
+};
+
+MachineInfo QueryMachineInfo() {
+    MachineInfo info;
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    info.cpu_brand = system::CPU::getInstance().cpuBrand();
+#endif
+    info.num_cpus = system::SystemInfo::getNumberOfCPUs();
+    info.os_name = system::SystemInfo::getOSName();
+    info.os_version = system::SystemInfo::getOSVersion();
+    info.os_arch = system::SystemInfo::getOSArch();
+    return info;
+}
+
+std::string CurrentDate() {
+    char buffer[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buffer;
+}
+
+std::string JsonString(const std::string& value) {
+    std::ostringstream ost;
+    ost << '"';
+    for (const char ch : value) {
+        switch (ch) {
+            case '"':
+                ost << "\\\"";
+                break;
+            case '\\':
+                ost << "\\\\";
+                break;
+            case '\n':
+                ost << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    ost << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(ch) << std::dec << std::setfill(' ');
+                } else {
+                    ost << ch;
+                }
+        }
+    }
+    ost << '"';
+    return ost.str();
+}
+
+std::string CsvString(const std::string& value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) {
+        return value;
+    }
+    std::string quoted = "\"";
+    for (const char ch : value) {
+        quoted += ch;
+        if (ch == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+// One-shot barrier releasing all waiting threads once |count| threads arrived
+class StartBarrier {
+  public:
+    explicit StartBarrier(int count) : count_(count) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (--count_ == 0) {
+            cv_.notify_all();
+            return;
+        }
+        cv_.wait(lock, [this] { return count_ == 0; });
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int count_;
+};
+
+// A single row of the result table: A benchmark with its argument and
+// thread count
+struct Run {
+    Benchmark* benchmark;
+    int threads;
+    int64 arg;
+    std::string name;
+};
+
+// Aggregated outcome of all repetitions of a Run
+struct Report {
+    std::string name;
+    int threads;
+    bool threaded;
+    int repetitions;
+    int64 iterations;
+    BenchmarkStatistics ns_per_iteration;
+    double iterations_per_second;
+    double bytes_per_second;
+    double items_per_second;
+    // Hardware counters summed up over all repetitions and threads
+    PerfCounterValues counters;
+
+    bool hasCounter(PerfCounter counter) const { return counters.has(counter) && iterations > 0; }
+
+    double counterPerIteration(PerfCounter counter) const {
+        return counters.get(counter) / iterations;
+    }
+};
+
+constexpr PerfCounter kAllPerfCounters[] = {PerfCounter::Cycles, PerfCounter::Instructions,
+                                            PerfCounter::CacheMisses, PerfCounter::BranchMisses};
+
+std::string FormatRate(double per_second) {
+    std::ostringstream ost;
+    ost << std::fixed << std::setprecision(2);
+    if (per_second >= 1e9) {
+        ost << per_second / 1e9 << "G";
+    } else if (per_second >= 1e6) {
+        ost << per_second / 1e6 << "M";
+    } else if (per_second >= 1e3) {
+        ost << per_second / 1e3 << "k";
+    } else {
+        ost << per_second;
+    }
+    return ost.str();
+}
+
+// Binary prefixes for data rates, e.g. 1.50 GiB/s
+std::string FormatByteRate(double bytes_per_second) {
+    const char* const kUnits[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    std::size_t unit = 0;
+    while (bytes_per_second >= 1024.0 && unit + 1 < sizeof(kUnits) / sizeof(kUnits[0])) {
+        bytes_per_second /= 1024.0;
+        ++unit;
+    }
+    std::ostringstream ost;
+    ost << std::fixed << std::setprecision(2) << bytes_per_second << " " << kUnits[unit] << "/s";
+    return ost.str();
+}
+
+class ConsoleReporter {
+  public:
+    ConsoleReporter(const std::vector<Run>& runs, int repetitions, bool counters)
+        : repetitions_(repetitions),
+          counters_(counters),
+          name_length_(std::string("Name").length()) {
+        for (const auto& run : runs) {
+            name_length_ = std::max(name_length_, run.name.length());
+        }
+    }
+
+    void printHeader() const {
+        std::ostringstream header;
+        header << std::left << std::setw(name_length_) << "Name" << "  " << std::right
+               << std::setw(kTimeWidth + 3) << "Time" << "  " << std::setw(kIterationsWidth)
+               << "iterations";
+        if (repetitions_ > 1) {
+            header << "  " << std::setw(kStatWidth) << "min" << "  " << std::setw(kStatWidth)
+                   << "median" << "  " << std::setw(kStatWidth) << "p99" << "  "
+                   << std::setw(kStatWidth) << "stddev";
+        }
+        if (counters_) {
+            for (const char* column :
+                 {"cycles/it", "instrs/it", "IPC", "cmiss/it", "bmiss/it"}) {
+                header << "  " << std::setw(kStatWidth) << column;
+            }
+        }
+        std::cout << header.str() << std::endl;
+        std::cout << std::string(header.str().length(), '-') << std::endl;
+    }
+
+    void print(const Report& report) const {
+        std::cout << ConsoleModifier(Color::Green);
+        std::cout << std::left << std::setw(name_length_) << report.name << "  ";
+
+        std::cout << ConsoleModifier(Color::Yellow);
+        std::cout << std::right << std::setw(kTimeWidth);
+        std::cout << std::llround(report.ns_per_iteration.mean) << " ns";
+
+        std::cout << "  ";
+        std::cout << ConsoleModifier(Color::Cyan);
+        std::cout << std::right << std::setw(kIterationsWidth) << report.iterations;
+
+        if (repetitions_ > 1) {
+            std::cout << ConsoleModifier(Color::Yellow) << std::fixed << std::setprecision(1);
+            for (double value : {report.ns_per_iteration.min, report.ns_per_iteration.median,
+                                 report.ns_per_iteration.p99, report.ns_per_iteration.stddev}) {
+                std::cout << "  " << std::setw(kStatWidth) << value;
+            }
+            std::cout.unsetf(std::ios::floatfield);
+        }
+        if (counters_) {
+            printCounters(report);
+        }
+        if (report.threaded) {
+            std::cout << ConsoleModifier(Color::White);
+            std::cout << "  " << FormatRate(report.iterations_per_second) << " ops/s";
+        }
+        if (report.bytes_per_second > 0.0) {
+            std::cout << ConsoleModifier(Color::White);
+            std::cout << "  " << FormatByteRate(report.bytes_per_second);
+        }
+        if (report.items_per_second > 0.0) {
+            std::cout << ConsoleModifier(Color::White);
+            std::cout << "  " << FormatRate(report.items_per_second) << " items/s";
+        }
+        std::cout << std::endl;
+        std::cout << "\033[0m";
+    }
+
+  private:
+    static constexpr int kTimeWidth = 14;
+    static constexpr int kIterationsWidth = 10;
+    static constexpr int kStatWidth = 10;
+
+    void printCounters(const Report& report) const {
+        std::cout << ConsoleModifier(Color::White) << std::fixed;
+        const auto print_value = [](bool available, double value, int precision) {
+            std::cout << "  " << std::setw(kStatWidth);
+            if (available) {
+                std::cout << std::setprecision(precision) << value;
+            } else {
+                std::cout << "-";
+            }
+        };
+        print_value(report.hasCounter(PerfCounter::Cycles),
+                    report.counterPerIteration(PerfCounter::Cycles), 1);
+        print_value(report.hasCounter(PerfCounter::Instructions),
+                    report.counterPerIteration(PerfCounter::Instructions), 1);
+        const bool has_ipc = report.hasCounter(PerfCounter::Cycles) &&
+                             report.hasCounter(PerfCounter::Instructions) &&
+                             report.counters.get(PerfCounter::Cycles) > 0.0;
+        print_value(has_ipc,
+                    has_ipc ? report.counters.get(PerfCounter::Instructions) /
+                                  report.counters.get(PerfCounter::Cycles)
+                            : 0.0,
+                    2);
+        print_value(report.hasCounter(PerfCounter::CacheMisses),
+                    report.counterPerIteration(PerfCounter::CacheMisses), 2);
+        print_value(report.hasCounter(PerfCounter::BranchMisses),
+                    report.counterPerIteration(PerfCounter::BranchMisses), 2);
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    int repetitions_;
+    bool counters_;
+    std::size_t name_length_;
+};
+
+void WriteJson(std::ostream& out, const MachineInfo& machine, const std::vector<Report>& reports) {
+    out << std::fixed << std::setprecision(2);
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"date\": " << JsonString(CurrentDate()) << ",\n";
+    out << "    \"cpu_brand\": " << JsonString(machine.cpu_brand) << ",\n";
+    out << "    \"num_cpus\": " << machine.num_cpus << ",\n";
+    out << "    \"os_name\": " << JsonString(machine.os_name) << ",\n";
+    out << "    \"os_version\": " << JsonString(machine.os_version) << ",\n";
+    out << "    \"os_arch\": " << JsonString(machine.os_arch) << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [";
+    for (std::size_t idx = 0; idx < reports.size(); ++idx) {
+        const Report& report = reports[idx];
+        out << (idx == 0 ? "\n" : ",\n");
+        out << "    {\n";
+        out << "      \"name\": " << JsonString(report.name) << ",\n";
+        out << "      \"threads\": " << report.threads << ",\n";
+        out << "      \"repetitions\": " << report.repetitions << ",\n";
+        out << "      \"iterations\": " << report.iterations << ",\n";
+        out << "      \"mean_ns\": " << report.ns_per_iteration.mean << ",\n";
+        out << "      \"min_ns\": " << report.ns_per_iteration.min << ",\n";
+        out << "      \"median_ns\": " << report.ns_per_iteration.median << ",\n";
+        out << "      \"p99_ns\": " << report.ns_per_iteration.p99 << ",\n";
+        out << "      \"stddev_ns\": " << report.ns_per_iteration.stddev << ",\n";
+        out << "      \"iterations_per_second\": " << report.iterations_per_second << ",\n";
+        out << "      \"bytes_per_second\": " << report.bytes_per_second << ",\n";
+        out << "      \"items_per_second\": " << report.items_per_second;
+        // Hardware counters per iteration, null if not available
+        for (PerfCounter counter : kAllPerfCounters) {
+            out << ",\n      \"" << PerfCounterName(counter) << "_per_iteration\": ";
+            if (report.hasCounter(counter)) {
+                out << report.counterPerIteration(counter);
+            } else {
+                out << "null";
+            }
+        }
+        out << "\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}" << std::endl;
+}
+
+// Every row carries the machine description, such that files from several
+// machines can simply be concatenated
+void WriteCsv(std::ostream& out, const MachineInfo& machine, const std::vector<Report>& reports) {
+    out << "name,threads,repetitions,iterations,mean_ns,min_ns,median_ns,p99_ns,stddev_ns,"
+           "iterations_per_second,bytes_per_second,items_per_second,";
+    // Hardware counters per iteration, empty if not available
+    for (PerfCounter counter : kAllPerfCounters) {
+        out << PerfCounterName(counter) << "_per_iteration,";
+    }
+    out << "cpu_brand,os_name,os_version,os_arch\n";
+    out << std::fixed << std::setprecision(2);
+    for (const auto& report : reports) {
+        out << CsvString(report.name) << ',' << report.threads << ',' << report.repetitions << ','
+            << report.iterations << ',' << report.ns_per_iteration.mean << ','
+            << report.ns_per_iteration.min << ',' << report.ns_per_iteration.median << ','
+            << report.ns_per_iteration.p99 << ',' << report.ns_per_iteration.stddev << ','
+            << report.iterations_per_second << ',' << report.bytes_per_second << ','
+            << report.items_per_second << ',';
+        for (PerfCounter counter : kAllPerfCounters) {
+            if (report.hasCounter(counter)) {
+                out << report.counterPerIteration(counter);
+            }
+            out << ',';
+        }
+        out << CsvString(machine.cpu_brand) << ',' << CsvString(machine.os_name) << ','
+            << CsvString(machine.os_version) << ',' << CsvString(machine.os_arch) << '\n';
+    }
+    out << std::flush;
+}
+}  // namespace
+
+BenchmarkStatistics ComputeStatistics(std::vector<double> samples) {
+    BenchmarkStatistics stats;
+    if (samples.empty()) {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const std::size_t count = samples.size();
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    stats.mean = sum / count;
+    stats.min = samples.front();
+    stats.median = count % 2 == 1 ? samples[count / 2]
+                                  : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    // Nearest-rank percentile
+    const auto rank = static_cast<std::size_t>(std::ceil(0.99 * count));
+    stats.p99 = samples[std::max<std::size_t>(rank, 1) - 1];
+    if (count > 1) {
+        double squares = 0.0;
+        for (double sample : samples) {
+            squares += (sample - stats.mean) * (sample - stats.mean);
+        }
+        stats.stddev = std::sqrt(squares / (count - 1));
+    }
+    return stats;
+}
+
+void Benchmark::emptyBenchMark(Context& context) {
+    while (context.running())
+        ;
+}
+
+std::vector<int> Benchmark::threadCounts(int max_threads) {
+    std::vector<int> counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(std::max(1, max_threads));
+    return counts;
+}
+
+void Benchmark::setMaxThreads(int max_threads) {
+    max_threads_ = max_threads > 0 ? max_threads : -1;
+}
+
+int Benchmark::maxThreads() const {
+    if (max_threads_ < 0) {
+        return std::max(1, system::SystemInfo::getNumberOfCPUs());
+    }
+    return std::max(1, max_threads_);
+}
+
+Benchmark* Benchmark::arg(int64 value) {
+    args_.push_back(value);
+    return this;
+}
+
+Benchmark* Benchmark::range(int64 lo, int64 hi) {
+    for (int64 value : rangeValues(lo, hi, range_multiplier_)) {
+        args_.push_back(value);
+    }
+    return this;
+}
+
+Benchmark* Benchmark::rangeMultiplier(int multiplier) {
+    KWC_ASSERT(multiplier > 1);
+    range_multiplier_ = multiplier;
+    return this;
+}
+
+std::vector<int64> Benchmark::rangeValues(int64 lo, int64 hi, int multiplier) {
+    KWC_ASSERT(lo >= 0 && lo <= hi && multiplier > 1);
+    std::vector<int64> values{lo};
+    // Powers of |multiplier| strictly between |lo| and |hi|
+    for (int64 value = 1; value < hi; value *= multiplier) {
+        if (value > lo) {
+            values.push_back(value);
+        }
+        if (value > hi / multiplier) {
+            break;
+        }
+    }
+    if (hi != lo) {
+        values.push_back(hi);
+    }
+    return values;
+}
+
+BenchmarkResult Benchmark::run(int num_threads,
+                               std::chrono::nanoseconds duration,
+                               double overhead,
+                               int64 arg) {
+    std::vector<Context> contexts;
+    contexts.reserve(num_threads);
+    for (int idx = 0; idx < num_threads; ++idx) {
+        contexts.emplace_back(duration, idx, num_threads, arg);
+    }
+
+    // Counters are opened by the thread running the body, as they only
+    // count events of the calling thread
+    std::vector<PerfCounterValues> counter_values(num_threads);
+    const auto run_with_counters = [this, &counter_values](Context& context,
+                                                           StartBarrier* barrier) {
+        PerfCounters counters;
+        context.setPerfCounters(&counters);
+        if (barrier != nullptr) {
+            barrier->wait();
+        }
+        runBenchmark(context);
+        counters.stop();
+        context.setPerfCounters(nullptr);
+        counter_values[context.threadIndex()] = counters.read();
+    };
+
+    if (num_threads == 1) {
+        run_with_counters(contexts.front(), nullptr);
+    } else {
+        // Every thread starts its clock on the first call to running(), which
+        // happens only after all threads passed the barrier
+        StartBarrier barrier(num_threads);
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (auto& context : contexts) {
+            threads.emplace_back([&barrier, &context, &run_with_counters] {
+                run_with_counters(context, &barrier);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    BenchmarkResult result;
+    result.name = name_;
+    result.threads = num_threads;
+    result.arg = arg;
+    double total_ns_per_iteration = 0.0;
+    for (const auto& context : contexts) {
+        const double ns_per_iteration = std::max(context.nsPerIteration(overhead), 0.0);
+        total_ns_per_iteration += ns_per_iteration;
+        result.iterations += context.iterations();
+        if (context.run_time_.count() > 0) {
+            const double seconds = context.run_time_.count() / 1e9;
+            result.iterations_per_second += context.iterations() / seconds;
+            result.bytes_per_second += context.bytesProcessed() / seconds;
+            result.items_per_second += context.itemsProcessed() / seconds;
+        }
+    }
+    result.ns_per_iteration = total_ns_per_iteration / num_threads;
+    for (const auto& values : counter_values) {
+        result.counters += values;
+    }
+    return result;
+}
+
+void Benchmark::runAllBenchmarks(int argc, const char* argv[]) {
+    const Options options = ParseOptions(argc, argv);
+
+    std::regex filter_regex;
+    try {
+        filter_regex = std::regex(options.filter);
+    } catch (const std::regex_error&) {
+        ExitWithUsageError("Invalid filter: " + options.filter);
+    }
+
+    std::vector<Run> runs;
+    for (auto benchmark : list()) {
+        std::smatch base_match;
+        if (!std::regex_match(benchmark->name(), base_match, filter_regex)) {
+            continue;
+        }
+        // A benchmark without arguments is run once with 0 as argument,
+        // which is then omitted from the name
+        std::vector<int64> args = benchmark->args();
+        const bool has_args = !args.empty();
+        if (!has_args) {
+            args.push_back(0);
+        }
+        for (int64 arg : args) {
+            std::string name = benchmark->name();
+            if (has_args) {
+                name += "/" + std::to_string(arg);
+            }
+            if (!benchmark->isThreaded()) {
+                runs.push_back({benchmark, 1, arg, name});
+                continue;
+            }
+            for (int threads : threadCounts(benchmark->maxThreads())) {
+                runs.push_back(
+                    {benchmark, threads, arg, name + "/threads:" + std::to_string(threads)});
+            }
+        }
+    }
+
+    Context overhead_context(std::chrono::seconds(1));
+    emptyBenchMark(overhead_context);
+    const double overhead = overhead_context.nsPerIteration();
+
+    const bool counters_supported = PerfCounters::isSupported();
+#if defined(KWC_OS_LINUX)
+    if (!counters_supported) {
+        std::cerr << "Hardware performance counters are not available, see "
+                     "/proc/sys/kernel/perf_event_paranoid. Reporting wall-clock time only"
+                  << std::endl;
+    }
+#endif
+
+    ConsoleReporter console(runs, options.repetitions, counters_supported);
+    if (options.format == OutputFormat::Console) {
+        console.printHeader();
+    }
+
+    std::vector<Report> reports;
+    for (const auto& run : runs) {
+        Report report{run.name, run.threads, run.benchmark->isThreaded(), options.repetitions,
+                      0,        {},          0.0,                         0.0,
+                      0.0,      {}};
+        std::vector<double> samples;
+        for (int repetition = 0; repetition < options.repetitions; ++repetition) {
+            run.benchmark->setUp();
+            auto result =
+                run.benchmark->run(run.threads, std::chrono::seconds(1), overhead, run.arg);
+            run.benchmark->tearDown();
+            samples.push_back(result.ns_per_iteration);
+            report.iterations += result.iterations;
+            report.iterations_per_second += result.iterations_per_second / options.repetitions;
+            report.bytes_per_second += result.bytes_per_second / options.repetitions;
+            report.items_per_second += result.items_per_second / options.repetitions;
+            report.counters += result.counters;
+        }
+        report.ns_per_iteration = ComputeStatistics(samples);
+
+        if (options.format == OutputFormat::Console) {
+            console.print(report);
+        } else {
+            reports.push_back(report);
+        }
+    }
+
+    if (options.format == OutputFormat::Json) {
+        WriteJson(std::cout, QueryMachineInfo(), reports);
+    } else if (options.format == OutputFormat::Csv) {
+        WriteCsv(std::cout, QueryMachineInfo(), reports);
+    }
+}
+
+}  // namespace utils
+}  // namespace kwc
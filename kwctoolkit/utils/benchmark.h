@@ -5,15 +5,18 @@
 #ifndef KWCTOOLKIT_UTILS_BENCHMARK_H_
 #define KWCTOOLKIT_UTILS_BENCHMARK_H_
 
-#include <algorithm>
 #include <chrono>
-#include <iomanip>
 #include <iostream>
-#include <regex>
-#include <sstream>
+#include <string>
 #include <vector>
 
+#include "kwctoolkit/base/compiler.h"
 #include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/utils/perf_counters.h"
+
+#if defined(KWC_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
 
 namespace kwc {
 namespace utils {
@@ -23,11 +26,33 @@ using BenchmarkList = std::vector<class Benchmark*>;
 
 enum class ContextState { Idle, Running, AreaBench };
 
+// Keeps the compiler from discarding |value| as well as the computation
+// producing it inside a benchmark loop
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(KWC_COMPILER_MSVC)
+    const volatile void* volatile sink = &value;
+    static_cast<void>(sink);
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
 template <typename Clock>
 class BasicContext {
   public:
-    BasicContext(std::chrono::nanoseconds duration)
-        : state_(ContextState::Idle), duration_(duration) {}
+    BasicContext(std::chrono::nanoseconds duration,
+                 int thread_index = 0,
+                 int num_threads = 1,
+                 int64 arg = 0)
+        : state_(ContextState::Idle),
+          iterations_(0),
+          duration_(duration),
+          run_time_(std::chrono::nanoseconds::zero()),
+          thread_index_(thread_index),
+          num_threads_(num_threads),
+          arg_(arg) {}
 
     // Keeps the benchmark running for the duration_ given in the constructor.
     // Return true as long as there is time left.
@@ -42,12 +67,14 @@ class BasicContext {
         if (state_ == ContextState::Idle) {
             state_ = ContextState::Running;
             iterations_ = 1;
+            startCounters();
             start_ = Clock::now();
             return true;
         }
         auto now = Clock::now();
         run_time_ = now - start_;
         if (run_time_ >= duration_) {
+            stopCounters();
             return false;
         }
 
@@ -55,6 +82,28 @@ class BasicContext {
         return true;
     }
 
+    // Index of the thread running this context within [0, numThreads())
+    int threadIndex() const { return thread_index_; }
+
+    // Number of threads concurrently running the benchmark body
+    int numThreads() const { return num_threads_; }
+
+    // Argument of the current run as given by Benchmark::arg() or
+    // Benchmark::range(), 0 if the benchmark has no arguments
+    int64 arg() const { return arg_; }
+
+    int64 iterations() const { return iterations_; }
+
+    // Amount of data processed by this thread in total. If set, the derived
+    // throughput (e.g. MiB/s or items/s) is reported as well:
+    //
+    //     context.setBytesProcessed(context.iterations() * buffer.size());
+    void setBytesProcessed(int64 bytes) { bytes_processed_ = bytes; }
+    void setItemsProcessed(int64 items) { items_processed_ = items; }
+
+    int64 bytesProcessed() const { return bytes_processed_; }
+    int64 itemsProcessed() const { return items_processed_; }
+
   protected:
     int64 timePerIteration(int64 overhead = 0) const {
         auto per_it = run_time_.count() / iterations_;
@@ -66,7 +115,16 @@ class BasicContext {
         return per_it;
     }
 
-    int64 iterations() const { return iterations_; }
+    // Same as timePerIteration(), but without truncating to whole ns
+    double nsPerIteration(double overhead = 0.0) const {
+        auto per_it = static_cast<double>(run_time_.count()) / iterations_;
+
+        if (state_ != ContextState::AreaBench) {
+            per_it -= overhead;
+        }
+
+        return per_it;
+    }
 
     void beginArea() {
         if (state_ != ContextState::AreaBench) {
@@ -74,13 +132,34 @@ class BasicContext {
             iterations_ = 1;
             run_time_ = std::chrono::nanoseconds::zero();
             state_ = ContextState::AreaBench;
+            if (counters_ != nullptr) {
+                counters_->reset();
+            }
         }
+        startCounters();
         start_ = Clock::now();
     }
 
     void endArea() {
         auto now = Clock::now();
         run_time_ += (now - start_);
+        stopCounters();
+    }
+
+    // Hardware counters are only enabled while the clock is running, i.e.
+    // within the running() loop or a BenchmarkArea
+    void setPerfCounters(PerfCounters* counters) { counters_ = counters; }
+
+    void startCounters() {
+        if (counters_ != nullptr) {
+            counters_->start();
+        }
+    }
+
+    void stopCounters() {
+        if (counters_ != nullptr) {
+            counters_->stop();
+        }
     }
 
   private:
@@ -89,6 +168,12 @@ class BasicContext {
     typename Clock::time_point start_;
     std::chrono::nanoseconds duration_;
     std::chrono::nanoseconds run_time_;
+    int thread_index_;
+    int num_threads_;
+    int64 arg_;
+    int64 bytes_processed_ = 0;
+    int64 items_processed_ = 0;
+    PerfCounters* counters_ = nullptr;
 
     friend class BenchmarkArea;
     friend class Benchmark;
@@ -119,31 +204,42 @@ class ConsoleModifier {
     Color code_;
 };
 
-class Benchmark {
-  private:
-    static std::string filterArgument(int argc, const char* argv[]) {
-        // iterate over all arguments and find --benchmark_filter=
-        std::regex filter_regex{"--benchmark_filter=(.*)"};
-        std::smatch base_match;
-
-        for (int i = 0; i < argc; i++) {
-            std::string argument{argv[i]};
-            if (std::regex_match(argument, base_match, filter_regex)) {
-                if (base_match.size() == 2) {
-                    std::ssub_match sub_match = base_match[1];
-                    std::string filter = sub_match.str();
-                    // replace all occurrences of * with .*
-                    filter = std::regex_replace(filter, std::regex("\\*"), ".*");
-
-                    return filter;
-                }
-            }
-        }
+// Outcome of running a single benchmark with a given number of threads
+struct BenchmarkResult {
+    std::string name;
+    int threads = 1;
+    int64 arg = 0;
+    int64 iterations = 0;
+    // Time per iteration as seen by each thread, averaged over all threads
+    double ns_per_iteration = 0.0;
+    // Iterations per second summed up over all threads
+    double iterations_per_second = 0.0;
+    // Throughput derived from Context::setBytesProcessed() and
+    // Context::setItemsProcessed(), summed up over all threads. Zero if the
+    // benchmark didn't report any
+    double bytes_per_second = 0.0;
+    double items_per_second = 0.0;
+    // Hardware counters summed up over all threads, see PerfCounters. Unlike
+    // the time, they include the overhead of Context::running()
+    PerfCounterValues counters;
+};
 
-        return std::string(".*");
-    }
+// Summary of the time per iteration over several repetitions of a benchmark
+struct BenchmarkStatistics {
+    double mean = 0.0;
+    double min = 0.0;
+    double median = 0.0;
+    double p99 = 0.0;
+    // Sample standard deviation, zero for a single repetition
+    double stddev = 0.0;
+};
+
+BenchmarkStatistics ComputeStatistics(std::vector<double> samples);
 
+class Benchmark {
   public:
+    virtual ~Benchmark() = default;
+
     static BenchmarkList& list() {
         // Currently elements in list are never destroyed, but as
         // the lifetime of list is the lifetime of the process, we
@@ -153,89 +249,71 @@ class Benchmark {
     }
 
     // empty benchmark to measure the overhead of context_.running()
-    static void emptyBenchMark(Context& context) {
-        while (context.running())
-            ;
-    }
+    static void emptyBenchMark(Context& context);
+
+    // Runs all benchmarks and prints the results. Supported arguments:
+    //
+    //     --benchmark_filter=<regex>      only run matching benchmarks
+    //     --benchmark_repetitions=<n>     run every benchmark n times and
+    //                                     report min, median, p99 and stddev
+    //     --benchmark_format=<format>     one of console (default), json or
+    //                                     csv. The machine-readable formats
+    //                                     include the CPU model and the OS
+    static void runAllBenchmarks(int argc = 0, const char* argv[] = nullptr);
+
+    // Thread counts a multi-threaded benchmark is run with: All powers of two
+    // below |max_threads| followed by |max_threads| itself
+    static std::vector<int> threadCounts(int max_threads);
+
+    // Runs the benchmark body on |num_threads| threads for |duration| each.
+    // All threads are released at once from a shared start barrier.
+    // |overhead| is the per-iteration cost of Context::running() in ns and
+    // |arg| is handed to the body through Context::arg()
+    BenchmarkResult run(int num_threads,
+                        std::chrono::nanoseconds duration,
+                        double overhead = 0.0,
+                        int64 arg = 0);
+
+    const std::string& name() const { return name_; }
 
-    static void runAllBenchmarks(int argc = 0, const char* argv[] = nullptr) {
-        auto max_length = maxNameLength();
-        auto nano_length = std::string("Time").length() + 10;
-        auto it_length = std::string("iterations").length();
+    std::string& name() { return name_; }
 
-        auto filter = filterArgument(argc, argv);
+    // Turns this into a multi-threaded benchmark, which is run once for every
+    // thread count in threadCounts(). A value <= 0 sweeps up to the number of
+    // CPUs reported by SystemInfo
+    void setMaxThreads(int max_threads);
 
-        std::regex filter_regex;
-        try {
-            filter_regex = std::regex(filter);
-        } catch (std::regex_error) {
-            std::cout << "Invalid filter: " << filter << std::endl;
-            exit(1);
-        }
+    bool isThreaded() const { return max_threads_ != 0; }
 
-        Context overhead_context(std::chrono::seconds(1));
-        emptyBenchMark(overhead_context);
-
-        std::cout << std::left << std::setw(max_length) << "Name"
-                  << "               "
-                  << "Time  iterations" << std::endl;
-        std::string dashes;
-        dashes.insert(0, max_length + 3 + nano_length + 4 + it_length, '-');
-        std::cout << dashes << std::endl;
-
-        for (auto benchmark : list()) {
-            std::smatch base_match;
-            if (!std::regex_match(benchmark->name(), base_match, filter_regex))
-                continue;
-
-            Context context(std::chrono::seconds(1));
-            benchmark->setUp();
-            benchmark->runBenchmark(context);
-            benchmark->tearDown();
-            std::ostringstream ost;
-            int64 time_per_iter = context.timePerIteration(overhead_context.timePerIteration());
-            time_per_iter = std::max<int64>(time_per_iter, 0ll);
-            ost << time_per_iter;
-            auto nano_str = ost.str();
-
-            std::cout << ConsoleModifier(Color::Green);
-            std::cout << std::left << std::setw(max_length);
-            std::cout << benchmark->name();
-            std::cout << "  ";
-
-            std::cout << ConsoleModifier(Color::Yellow);
-            std::cout << std::right << std::setw(nano_length) << nano_str << " ns";
-
-            std::ostringstream itstrstr;
-            itstrstr << context.iterations();
-            auto it_str = itstrstr.str();
-
-            std::cout << "  ";
-            std::cout << ConsoleModifier(Color::Cyan);
-            std::cout << std::right << std::setw(it_length) << it_str << std::endl;
-            std::cout << "\033[0m";
-        }
-    }
+    int maxThreads() const;
 
-    static size_t maxNameLength() {
-        size_t length = 0;
-        for (const auto& benchmark : list()) {
-            length = benchmark->name().length() > length ? benchmark->name().length() : length;
-        }
-        return length;
-    }
+    // Runs the benchmark once more with |value| as Context::arg()
+    Benchmark* arg(int64 value);
 
-    const std::string& name() const { return name_; }
+    // Runs the benchmark for |lo|, every power of rangeMultiplier() in
+    // between and |hi|, e.g. range(8, 1 << 10) yields 8, 64, 512 and 1024
+    Benchmark* range(int64 lo, int64 hi);
 
-    std::string& name() { return name_; }
+    // Step between the arguments generated by range(), 8 by default. Must be
+    // set before calling range()
+    Benchmark* rangeMultiplier(int multiplier);
+
+    const std::vector<int64>& args() const { return args_; }
+
+    static std::vector<int64> rangeValues(int64 lo, int64 hi, int multiplier);
 
   protected:
-    virtual void runBenchmark(Context& context){};
+    virtual void runBenchmark(Context& /*context*/) {}
     virtual void setUp() {}
     virtual void tearDown() {}
 
   protected:
     std::string name_;
+    // 0 for single-threaded benchmarks, -1 for "number of CPUs"
+    int max_threads_ = 0;
+    // Empty if the benchmark is run only once without an argument
+    std::vector<int64> args_;
+    int range_multiplier_ = 8;
 };
 
 #define _BM_CONCATX(A, B) A##B
@@ -243,48 +321,85 @@ class Benchmark {
 #define _BM_STRX(X) #X
 #define _BM_STR(X) _BM_STRX(X)
 
-#define BENCHMARK(NAME)                                    \
-    class NAME : public kwc::Benchmark {                   \
-      public:                                              \
-        static class _init {                               \
-          public:                                          \
-            _init() {                                      \
-                kwc::Benchmark* bench = new NAME();        \
-                bench->Name() = #NAME;                     \
-                NAME::List().push_back(bench);             \
-            }                                              \
-        } _initializer;                                    \
-                                                           \
-      protected:                                           \
-        void RunBenchmark(kwc::Context& context) override; \
-    };                                                     \
-    NAME::_init NAME::_initializer;                        \
-                                                           \
-    void NAME::RunBenchmark(kwc::Context& context)
-
-#define BENCHMARK_F(FIXTURE, NAME)                                            \
-    class _BM_CONCAT(FIXTURE, NAME) : public FIXTURE {                        \
-      public:                                                                 \
-        static class _init {                                                  \
-          public:                                                             \
-            _init() {                                                         \
-                kwc::Benchmark* bench = new _BM_CONCAT(FIXTURE, NAME)();      \
-                bench->Name() = _BM_STR(FIXTURE) "." _BM_STR(NAME);           \
-                _BM_CONCAT(FIXTURE, NAME)::List().push_back(bench);           \
-            }                                                                 \
-        } _initializer;                                                       \
-                                                                              \
-      protected:                                                              \
-        void RunBenchmark(kwc::Context& context) override;                    \
-    };                                                                        \
-    _BM_CONCAT(FIXTURE, NAME)::_init _BM_CONCAT(FIXTURE, NAME)::_initializer; \
-                                                                              \
-    void _BM_CONCAT(FIXTURE, NAME)::RunBenchmark(kwc::Context& context)
+#define _BM_DEFINE(NAME, THREADED, MAX_THREADS)                   \
+    class NAME : public kwc::utils::Benchmark {                   \
+      public:                                                     \
+        static class _init {                                      \
+          public:                                                 \
+            _init() : bench(new NAME()) {                         \
+                bench->name() = #NAME;                            \
+                if (THREADED) {                                   \
+                    bench->setMaxThreads(MAX_THREADS);            \
+                }                                                 \
+                NAME::list().push_back(bench);                    \
+            }                                                     \
+            kwc::utils::Benchmark* const bench;                   \
+        } _initializer;                                           \
+                                                                  \
+      protected:                                                  \
+        void runBenchmark(kwc::utils::Context& context) override; \
+    };                                                            \
+    NAME::_init NAME::_initializer;                               \
+                                                                  \
+    void NAME::runBenchmark(kwc::utils::Context& context)
+
+#define BENCHMARK(NAME) _BM_DEFINE(NAME, false, 1)
+
+// Multi-threaded benchmark. The body is run concurrently on 1, 2, 4, ... up
+// to |MAX_THREADS| threads, each with its own |context|. Passing 0 sweeps up
+// to the number of CPUs. Use context.threadIndex() to tell threads apart:
+//
+//     BENCHMARK_THREADS(RefCountContention, 0) {
+//         while (context.running()) {
+//             shared->reference();
+//             shared->release();
+//         }
+//     }
+//
+// Results are reported per thread count, with the time per iteration as seen
+// by a single thread and the aggregate throughput of all threads.
+#define BENCHMARK_THREADS(NAME, MAX_THREADS) _BM_DEFINE(NAME, true, MAX_THREADS)
+
+#define BENCHMARK_F(FIXTURE, NAME)                                              \
+    class _BM_CONCAT(FIXTURE, NAME) : public FIXTURE {                          \
+      public:                                                                   \
+        static class _init {                                                    \
+          public:                                                               \
+            _init() : bench(new _BM_CONCAT(FIXTURE, NAME)()) {                  \
+                bench->name() = _BM_STR(FIXTURE) "." _BM_STR(NAME);             \
+                _BM_CONCAT(FIXTURE, NAME)::list().push_back(bench);             \
+            }                                                                   \
+            kwc::utils::Benchmark* const bench;                                 \
+        } _initializer;                                                         \
+                                                                                \
+      protected:                                                                \
+        void runBenchmark(kwc::utils::Context& context) override;               \
+    };                                                                          \
+    _BM_CONCAT(FIXTURE, NAME)::_init _BM_CONCAT(FIXTURE, NAME)::_initializer;   \
+                                                                                \
+    void _BM_CONCAT(FIXTURE, NAME)::runBenchmark(kwc::utils::Context& context)
+
+// Configures a benchmark defined above, e.g. to run it with arguments:
+//
+//     BENCHMARK(Base64Encode) {
+//         const std::string input(context.arg(), 'x');
+//         while (context.running()) {
+//             DoNotOptimize(Base64Encode(input));
+//         }
+//         context.setBytesProcessed(context.iterations() * context.arg());
+//     }
+//     BENCHMARK_CONFIGURE(Base64Encode)->range(64, 1 << 20);
+//
+// For BENCHMARK_F use the concatenated name, e.g. FixtureName
+#define BENCHMARK_CONFIGURE(NAME) \
+    static kwc::utils::Benchmark* const _BM_CONCAT(NAME, _configured) = NAME::_initializer.bench
 
 }  // namespace utils
 }  // namespace kwc
 
-#define BENCHMARK_MAIN() \
-    int main(int argc, const char* argv[]) { kwc::Benchmark::RunAllBenchmarks(argc, argv); }
+#define BENCHMARK_MAIN()                                     \
+    int main(int argc, const char* argv[]) {                 \
+        kwc::utils::Benchmark::runAllBenchmarks(argc, argv); \
+    }
 
 #endif  // KWCTOOLKIT_UTILS_BENCHMARK_H_
@@ -0,0 +1,122 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/utils/benchmark.h"
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+using namespace kwc::utils;
+
+namespace {
+// Records which threads ran the benchmark body
+class RecordingBenchmark : public Benchmark {
+  public:
+    std::mutex mutex;
+    std::set<int> thread_indices;
+
+  protected:
+    void runBenchmark(Context& context) override {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            thread_indices.insert(context.threadIndex());
+            EXPECT_GT(context.numThreads(), context.threadIndex());
+        }
+        while (context.running())
+            ;
+    }
+};
+
+// Processes |context.arg()| bytes and one item per iteration
+class ThroughputBenchmark : public Benchmark {
+  public:
+    kwc::int64 last_arg = -1;
+
+  protected:
+    void runBenchmark(Context& context) override {
+        last_arg = context.arg();
+        while (context.running())
+            ;
+        context.setBytesProcessed(context.iterations() * context.arg());
+        context.setItemsProcessed(context.iterations());
+    }
+};
+}  // namespace
+
+TEST(BenchmarkTest, ThreadCountsArePowersOfTwoUpToTheMaximum) {
+    EXPECT_EQ(Benchmark::threadCounts(1), std::vector<int>({1}));
+    EXPECT_EQ(Benchmark::threadCounts(4), std::vector<int>({1, 2, 4}));
+    EXPECT_EQ(Benchmark::threadCounts(6), std::vector<int>({1, 2, 4, 6}));
+}
+
+TEST(BenchmarkTest, SweepsUpToNumberOfCPUsByDefault) {
+    RecordingBenchmark benchmark;
+    EXPECT_FALSE(benchmark.isThreaded());
+    benchmark.setMaxThreads(0);
+    EXPECT_TRUE(benchmark.isThreaded());
+    EXPECT_GE(benchmark.maxThreads(), 1);
+    benchmark.setMaxThreads(3);
+    EXPECT_EQ(benchmark.maxThreads(), 3);
+}
+
+TEST(BenchmarkTest, RunsBodyOnEveryThread) {
+    RecordingBenchmark benchmark;
+    benchmark.name() = "Recording";
+    auto result = benchmark.run(4, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(benchmark.thread_indices, std::set<int>({0, 1, 2, 3}));
+    EXPECT_EQ(result.name, "Recording");
+    EXPECT_EQ(result.threads, 4);
+    EXPECT_GT(result.iterations, 0);
+    EXPECT_GT(result.iterations_per_second, 0.0);
+}
+
+TEST(BenchmarkTest, ComputesStatisticsOverRepetitions) {
+    auto stats = ComputeStatistics({5.0, 1.0, 3.0, 2.0, 4.0});
+    EXPECT_DOUBLE_EQ(stats.mean, 3.0);
+    EXPECT_DOUBLE_EQ(stats.min, 1.0);
+    EXPECT_DOUBLE_EQ(stats.median, 3.0);
+    EXPECT_DOUBLE_EQ(stats.p99, 5.0);
+    EXPECT_NEAR(stats.stddev, 1.5811, 1e-4);
+
+    stats = ComputeStatistics({4.0, 2.0});
+    EXPECT_DOUBLE_EQ(stats.median, 3.0);
+
+    stats = ComputeStatistics({7.0});
+    EXPECT_DOUBLE_EQ(stats.p99, 7.0);
+    EXPECT_DOUBLE_EQ(stats.stddev, 0.0);
+}
+
+TEST(BenchmarkTest, RangeYieldsPowersOfMultiplierBetweenBounds) {
+    using Args = std::vector<kwc::int64>;
+    EXPECT_EQ(Benchmark::rangeValues(8, 1024, 8), Args({8, 64, 512, 1024}));
+    EXPECT_EQ(Benchmark::rangeValues(1, 16, 2), Args({1, 2, 4, 8, 16}));
+    EXPECT_EQ(Benchmark::rangeValues(3, 100, 10), Args({3, 10, 100}));
+    EXPECT_EQ(Benchmark::rangeValues(5, 5, 8), Args({5}));
+
+    ThroughputBenchmark benchmark;
+    EXPECT_TRUE(benchmark.args().empty());
+    benchmark.arg(3)->rangeMultiplier(4)->range(16, 100);
+    EXPECT_EQ(benchmark.args(), Args({3, 16, 64, 100}));
+}
+
+TEST(BenchmarkTest, DerivesThroughputFromProcessedBytesAndItems) {
+    ThroughputBenchmark benchmark;
+    auto result = benchmark.run(1, std::chrono::milliseconds(20), 0.0, 256);
+
+    EXPECT_EQ(benchmark.last_arg, 256);
+    EXPECT_EQ(result.arg, 256);
+    EXPECT_GT(result.items_per_second, 0.0);
+    EXPECT_DOUBLE_EQ(result.items_per_second, result.iterations_per_second);
+    EXPECT_NEAR(result.bytes_per_second, 256 * result.items_per_second,
+                1e-6 * result.bytes_per_second);
+
+    RecordingBenchmark silent;
+    result = silent.run(1, std::chrono::milliseconds(5));
+    EXPECT_EQ(result.bytes_per_second, 0.0);
+    EXPECT_EQ(result.items_per_second, 0.0);
+}
@@ -0,0 +1,252 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/utils/fuzzy_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "kwctoolkit/base/check.h"
+#include "kwctoolkit/utils/levenshtein.h"
+
+namespace kwc {
+namespace utils {
+namespace {
+const unsigned int kUnbounded = std::numeric_limits<unsigned int>::max() - 1;
+
+// Bigrams of |str| as a byte and its predecessor, where 256 marks the start
+// and the end. Repeated bigrams are listed as often as they occur, in
+// ascending order
+std::vector<uint32> Bigrams(const std::string& str) {
+    std::vector<uint32> bigrams;
+    bigrams.reserve(str.size() + 1);
+    uint32 prev = 256;
+    for (const char ch : str) {
+        const uint32 byte = static_cast<unsigned char>(ch);
+        bigrams.push_back(prev << 9 | byte);
+        prev = byte;
+    }
+    bigrams.push_back(prev << 9 | 256);
+    std::sort(bigrams.begin(), bigrams.end());
+    return bigrams;
+}
+
+// Smallest possible distance of a query and an entry of the given lengths
+// that share at most |shared| bigrams
+unsigned int LowerBound(std::size_t query_length, std::size_t entry_length, uint32 shared) {
+    const std::size_t num_bigrams = std::max(query_length, entry_length) + 1;
+    const std::size_t by_bigrams = num_bigrams > shared ? (num_bigrams - shared + 1) / 2 : 0;
+    const std::size_t by_lengths = query_length > entry_length ? query_length - entry_length
+                                                               : entry_length - query_length;
+    return static_cast<unsigned int>(std::min<std::size_t>(std::max(by_bigrams, by_lengths),
+                                                           kUnbounded));
+}
+
+// Counters of the bigrams each entry shares with the current query. They
+// are kept per thread and reused across queries, so that a query neither
+// allocates nor zero-fills one counter per entry. Only the counters of the
+// touched entries are set, which are reset once the query is done
+class SharedBigrams {
+  public:
+    explicit SharedBigrams(std::size_t num_entries)
+        : shared_(tls_shared), touched_(tls_touched) {
+        if (shared_.size() < num_entries) {
+            shared_.resize(num_entries);
+        }
+    }
+    ~SharedBigrams() {
+        for (const uint32 index : touched_) {
+            shared_[index] = 0;
+        }
+        touched_.clear();
+    }
+
+    SharedBigrams(const SharedBigrams&) = delete;
+    SharedBigrams& operator=(const SharedBigrams&) = delete;
+
+    std::vector<uint32>* shared() { return &shared_; }
+    std::vector<uint32>* touched() { return &touched_; }
+
+  private:
+    static thread_local std::vector<uint32> tls_shared;
+    static thread_local std::vector<uint32> tls_touched;
+
+    std::vector<uint32>& shared_;
+    std::vector<uint32>& touched_;
+};
+
+thread_local std::vector<uint32> SharedBigrams::tls_shared;
+thread_local std::vector<uint32> SharedBigrams::tls_touched;
+
+bool IsCloser(const FuzzyMatch& lhs, const FuzzyMatch& rhs) {
+    return lhs.distance != rhs.distance ? lhs.distance < rhs.distance : lhs.index < rhs.index;
+}
+}  // namespace
+
+FuzzyIndex::FuzzyIndex(std::vector<std::string> entries) {
+    KWC_CHECK(entries.size() < std::numeric_limits<uint32>::max());
+    entries_.reserve(entries.size());
+    for (auto& entry : entries) {
+        entries_.push_back(std::move(entry));
+        indexLastEntry();
+    }
+}
+
+void FuzzyIndex::add(std::string entry) {
+    KWC_CHECK(entries_.size() + 1 < std::numeric_limits<uint32>::max());
+    entries_.push_back(std::move(entry));
+    indexLastEntry();
+}
+
+void FuzzyIndex::indexLastEntry() {
+    const auto index = static_cast<uint32>(entries_.size() - 1);
+    const std::string& entry = entries_.back();
+    std::vector<uint32> bigrams = Bigrams(entry);
+    bigrams.erase(std::unique(bigrams.begin(), bigrams.end()), bigrams.end());
+    for (const uint32 bigram : bigrams) {
+        postings_[bigram].push_back(index);
+    }
+    if (by_length_.size() <= entry.size()) {
+        by_length_.resize(entry.size() + 1);
+    }
+    by_length_[entry.size()].push_back(index);
+}
+
+void FuzzyIndex::countSharedBigrams(const std::string& query, std::vector<uint32>* shared,
+                                    std::vector<uint32>* touched) const {
+    const std::vector<uint32> bigrams = Bigrams(query);
+    for (auto it = bigrams.begin(); it != bigrams.end();) {
+        const auto next = std::upper_bound(it, bigrams.end(), *it);
+        const auto postings = postings_.find(*it);
+        if (postings != postings_.end()) {
+            // Entries with a repeated bigram of the query count it as often,
+            // which only weakens the bound
+            const auto occurrences = static_cast<uint32>(next - it);
+            for (const uint32 index : postings->second) {
+                if ((*shared)[index] == 0) {
+                    touched->push_back(index);
+                }
+                (*shared)[index] += occurrences;
+            }
+        }
+        it = next;
+    }
+}
+
+std::vector<FuzzyMatch> FuzzyIndex::findWithin(const std::string& query,
+                                               unsigned int max_distance) const {
+    std::vector<FuzzyMatch> matches;
+    if (entries_.empty()) {
+        return matches;
+    }
+    max_distance = std::min(max_distance, kUnbounded);
+    SharedBigrams counters(entries_.size());
+    const std::vector<uint32>& shared = *counters.shared();
+    const std::vector<uint32>& touched = *counters.touched();
+    countSharedBigrams(query, counters.shared(), counters.touched());
+    for (const uint32 index : touched) {
+        if (LowerBound(query.size(), entries_[index].size(), shared[index]) <= max_distance) {
+            const unsigned int distance =
+                LevenshteinDistanceBounded(query, entries_[index], max_distance);
+            if (distance <= max_distance) {
+                matches.push_back({index, distance});
+            }
+        }
+    }
+    // Entries sharing no bigram qualify only if they are short enough
+    const std::size_t min_length = query.size() - std::min<std::size_t>(query.size(), max_distance);
+    const std::size_t max_length = std::min(
+        {by_length_.size() - 1, query.size() + max_distance, 2 * std::size_t{max_distance}});
+    for (std::size_t length = min_length; length <= max_length; ++length) {
+        if (LowerBound(query.size(), length, 0) > max_distance) {
+            continue;
+        }
+        for (const uint32 index : by_length_[length]) {
+            if (shared[index] != 0) {
+                continue;
+            }
+            const unsigned int distance =
+                LevenshteinDistanceBounded(query, entries_[index], max_distance);
+            if (distance <= max_distance) {
+                matches.push_back({index, distance});
+            }
+        }
+    }
+    std::sort(matches.begin(), matches.end(), IsCloser);
+    return matches;
+}
+
+std::vector<FuzzyMatch> FuzzyIndex::findClosest(const std::string& query,
+                                                std::size_t count) const {
+    // Max-heap of the closest entries so far, the farthest one on top
+    std::vector<FuzzyMatch> closest;
+    if (entries_.empty() || count == 0) {
+        return closest;
+    }
+    SharedBigrams counters(entries_.size());
+    const std::vector<uint32>& shared = *counters.shared();
+    const std::vector<uint32>& touched = *counters.touched();
+    countSharedBigrams(query, counters.shared(), counters.touched());
+
+    // Candidates by their lower bounds, the entries sharing any bigram one
+    // by one and the others by their lengths
+    std::vector<std::pair<unsigned int, uint32>> candidates;
+    candidates.reserve(touched.size());
+    for (const uint32 index : touched) {
+        candidates.emplace_back(LowerBound(query.size(), entries_[index].size(), shared[index]),
+                                index);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    std::vector<std::pair<unsigned int, std::size_t>> lengths;
+    for (std::size_t length = 0; length < by_length_.size(); ++length) {
+        if (!by_length_[length].empty()) {
+            lengths.emplace_back(LowerBound(query.size(), length, 0), length);
+        }
+    }
+    std::sort(lengths.begin(), lengths.end());
+
+    const auto verify = [&](uint32 index) {
+        const unsigned int radius = closest.size() < count ? kUnbounded : closest.front().distance;
+        const FuzzyMatch match{index, LevenshteinDistanceBounded(query, entries_[index], radius)};
+        if (closest.size() < count) {
+            closest.push_back(match);
+            std::push_heap(closest.begin(), closest.end(), IsCloser);
+        } else if (IsCloser(match, closest.front())) {
+            std::pop_heap(closest.begin(), closest.end(), IsCloser);
+            closest.back() = match;
+            std::push_heap(closest.begin(), closest.end(), IsCloser);
+        }
+    };
+    // Visits the candidates in ascending order of their lower bounds until
+    // the bound exceeds the farthest of the closest entries
+    auto candidate = candidates.begin();
+    auto length = lengths.begin();
+    while (candidate != candidates.end() || length != lengths.end()) {
+        const unsigned int radius = closest.size() < count ? kUnbounded : closest.front().distance;
+        const bool next_is_length =
+            candidate == candidates.end() ||
+            (length != lengths.end() && length->first < candidate->first);
+        const unsigned int lower_bound = next_is_length ? length->first : candidate->first;
+        if (lower_bound > radius) {
+            break;
+        }
+        if (next_is_length) {
+            for (const uint32 index : by_length_[length->second]) {
+                if (shared[index] == 0) {
+                    verify(index);
+                }
+            }
+            ++length;
+        } else {
+            verify(candidate->second);
+            ++candidate;
+        }
+    }
+    std::sort_heap(closest.begin(), closest.end(), IsCloser);
+    return closest;
+}
+
+}  // namespace utils
+}  // namespace kwc
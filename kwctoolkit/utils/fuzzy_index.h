@@ -0,0 +1,85 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_UTILS_FUZZY_INDEX_H_
+#define KWCTOOLKIT_UTILS_FUZZY_INDEX_H_
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "kwctoolkit/base/integral_types.h"
+
+namespace kwc {
+namespace utils {
+
+struct FuzzyMatch {
+    // Position of the entry in the index, see FuzzyIndex::entry()
+    std::size_t index;
+    unsigned int distance;
+};
+
+// Index of strings for lookups by Levenshtein distance, such as suggesting
+// a command for a mistyped one. Entries are indexed by their bigrams, the
+// pairs of adjacent bytes with the start and end of the entry marked as
+// well. As an edit changes at most two bigrams, strings within distance k of
+// each other share at least max(length) + 1 - 2k of them (E. Ukkonen,
+// "Approximate string-matching with q-grams and maximal matches", TCS 92(1),
+// 1992). Counting the shared bigrams over the entries containing those of
+// the query bounds the distance of every entry from below, so that only few
+// entries are compared by LevenshteinDistanceBounded(). Usage:
+//
+//     FuzzyIndex index({"build", "clean", "install", "test"});
+//     for (const FuzzyMatch& match : index.findWithin("instal", 2)) {
+//         // index.entry(match.index) == "install", match.distance == 1
+//     }
+//
+// The queries only read the index and may run concurrently from any number
+// of threads. add() must not overlap with any other call. Every thread that
+// queries keeps one counter per entry of the largest index it has queried.
+class FuzzyIndex {
+  public:
+    FuzzyIndex() = default;
+    // Builds the index of |entries| at once, keeping their order as indices
+    explicit FuzzyIndex(std::vector<std::string> entries);
+
+    // Adds |entry| with the next index, duplicates included
+    void add(std::string entry);
+
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    const std::string& entry(std::size_t index) const { return entries_[index]; }
+
+    // All entries within |max_distance| of |query|, ordered by distance and
+    // then by index
+    std::vector<FuzzyMatch> findWithin(const std::string& query,
+                                       unsigned int max_distance) const;
+
+    // The |count| entries closest to |query|, or all if there are fewer,
+    // ordered by distance and then by index. Ties at the largest distance are
+    // resolved in favor of the lower indices
+    std::vector<FuzzyMatch> findClosest(const std::string& query, std::size_t count) const;
+
+  private:
+    // Adds the bigrams of the last entry to |postings_|
+    void indexLastEntry();
+
+    // Counts in |shared| the bigrams each entry shares with |query|, or more
+    // for repeated bigrams, and lists the entries sharing any in |touched|.
+    // |shared| holds at least one zeroed counter per entry
+    void countSharedBigrams(const std::string& query, std::vector<uint32>* shared,
+                            std::vector<uint32>* touched) const;
+
+    std::vector<std::string> entries_;
+    // Indices of the entries containing each bigram, in ascending order
+    std::unordered_map<uint32, std::vector<uint32>> postings_;
+    // Indices of the entries of each length
+    std::vector<std::vector<uint32>> by_length_;
+};
+
+}  // namespace utils
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_UTILS_FUZZY_INDEX_H_
@@ -0,0 +1,82 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <string>
+#include <vector>
+
+#include "kwctoolkit/utils/benchmark.h"
+#include "kwctoolkit/utils/fuzzy_index.h"
+#include "kwctoolkit/utils/levenshtein.h"
+#include "tests/random_data.h"
+
+namespace {
+// Dictionary of |count| lower case words of 4 to 15 letters
+std::vector<std::string> MakeWords(kwc::int64 count, kwc::uint32 seed) {
+    return kwc::test::RandomWords(static_cast<std::size_t>(count), 4, 15, 26, seed);
+}
+
+// Mistyped words of |words|, with one letter replaced
+std::vector<std::string> MakeQueries(const std::vector<std::string>& words) {
+    std::vector<std::string> queries;
+    for (std::size_t idx = 0; idx < 64; ++idx) {
+        std::string query = words[idx * words.size() / 64];
+        query[idx % query.size()] = '_';
+        queries.push_back(query);
+    }
+    return queries;
+}
+}  // namespace
+
+// Items are mistyped words looked up in a dictionary of |context.arg()| words
+BENCHMARK(FuzzyIndexFindWithin) {
+    const std::vector<std::string> words = MakeWords(context.arg(), 1);
+    const kwc::utils::FuzzyIndex index(words);
+    const std::vector<std::string> queries = MakeQueries(words);
+    std::size_t idx = 0;
+    while (context.running()) {
+        kwc::utils::DoNotOptimize(index.findWithin(queries[idx++ % queries.size()], 2));
+    }
+    context.setItemsProcessed(context.iterations());
+}
+BENCHMARK_CONFIGURE(FuzzyIndexFindWithin)->arg(1000)->arg(100000);
+
+BENCHMARK(FuzzyIndexFindClosest) {
+    const std::vector<std::string> words = MakeWords(context.arg(), 1);
+    const kwc::utils::FuzzyIndex index(words);
+    const std::vector<std::string> queries = MakeQueries(words);
+    std::size_t idx = 0;
+    while (context.running()) {
+        kwc::utils::DoNotOptimize(index.findClosest(queries[idx++ % queries.size()], 5));
+    }
+    context.setItemsProcessed(context.iterations());
+}
+BENCHMARK_CONFIGURE(FuzzyIndexFindClosest)->arg(1000)->arg(100000);
+
+// Comparing the query against every word, for reference
+BENCHMARK(FuzzyIndexLinearScan) {
+    const std::vector<std::string> words = MakeWords(context.arg(), 1);
+    const std::vector<std::string> queries = MakeQueries(words);
+    std::size_t idx = 0;
+    while (context.running()) {
+        const std::string& query = queries[idx++ % queries.size()];
+        std::vector<std::size_t> matches;
+        for (std::size_t word = 0; word < words.size(); ++word) {
+            if (kwc::utils::LevenshteinDistanceBounded(query, words[word], 2) <= 2) {
+                matches.push_back(word);
+            }
+        }
+        kwc::utils::DoNotOptimize(matches);
+    }
+    context.setItemsProcessed(context.iterations());
+}
+BENCHMARK_CONFIGURE(FuzzyIndexLinearScan)->arg(1000)->arg(100000);
+
+BENCHMARK(FuzzyIndexBuild) {
+    const std::vector<std::string> words = MakeWords(context.arg(), 1);
+    while (context.running()) {
+        kwc::utils::DoNotOptimize(kwc::utils::FuzzyIndex(words).size());
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(FuzzyIndexBuild)->arg(10000);
@@ -0,0 +1,134 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/utils/fuzzy_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/utils/levenshtein.h"
+#include "tests/random_data.h"
+
+using namespace kwc;
+using namespace kwc::utils;
+
+namespace {
+// Words of 3 to 12 letters over a small alphabet, so that many of them
+// share bigrams
+std::vector<std::string> MakeWords(std::size_t count, uint32 seed) {
+    return test::RandomWords(count, 3, 12, 6, seed);
+}
+
+// All matches by comparing |query| against every entry
+std::vector<FuzzyMatch> FindAll(const std::vector<std::string>& words,
+                                const std::string& query) {
+    std::vector<FuzzyMatch> matches;
+    for (std::size_t idx = 0; idx < words.size(); ++idx) {
+        matches.push_back({idx, LevenshteinDistance(query, words[idx])});
+    }
+    std::sort(matches.begin(), matches.end(), [](const FuzzyMatch& lhs, const FuzzyMatch& rhs) {
+        return lhs.distance != rhs.distance ? lhs.distance < rhs.distance : lhs.index < rhs.index;
+    });
+    return matches;
+}
+
+void ExpectEqual(const std::vector<FuzzyMatch>& expected, const std::vector<FuzzyMatch>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t idx = 0; idx < expected.size(); ++idx) {
+        EXPECT_EQ(expected[idx].index, actual[idx].index);
+        EXPECT_EQ(expected[idx].distance, actual[idx].distance);
+    }
+}
+}  // namespace
+
+TEST(FuzzyIndexTest, FindsMistypedCommands) {
+    const FuzzyIndex index({"build", "clean", "install", "test", "uninstall"});
+    const auto matches = index.findWithin("instal", 2);
+    ASSERT_EQ(1u, matches.size());
+    EXPECT_EQ("install", index.entry(matches[0].index));
+    EXPECT_EQ(1u, matches[0].distance);
+
+    const auto closest = index.findClosest("tset", 1);
+    ASSERT_EQ(1u, closest.size());
+    EXPECT_EQ("test", index.entry(closest[0].index));
+    EXPECT_TRUE(index.findWithin("configure", 2).empty());
+}
+
+TEST(FuzzyIndexTest, EmptyIndexFindsNothing) {
+    FuzzyIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_TRUE(index.findWithin("foo", 10).empty());
+    EXPECT_TRUE(index.findClosest("foo", 3).empty());
+    index.add("foo");
+    EXPECT_EQ(1u, index.findWithin("foo", 0).size());
+    EXPECT_TRUE(index.findClosest("foo", 0).empty());
+}
+
+TEST(FuzzyIndexTest, MatchesComparingAllEntries) {
+    const std::vector<std::string> words = MakeWords(2000, 1);
+    FuzzyIndex index(words);
+    FuzzyIndex added;
+    for (const auto& word : words) {
+        added.add(word);
+    }
+    ASSERT_EQ(words.size(), index.size());
+    for (const std::string& query : MakeWords(20, 2)) {
+        SCOPED_TRACE(query);
+        const std::vector<FuzzyMatch> all = FindAll(words, query);
+        for (const unsigned int max_distance : {0u, 1u, 2u, 4u, 100u}) {
+            std::vector<FuzzyMatch> within;
+            std::copy_if(all.begin(), all.end(), std::back_inserter(within),
+                         [&](const FuzzyMatch& match) { return match.distance <= max_distance; });
+            ExpectEqual(within, index.findWithin(query, max_distance));
+            ExpectEqual(within, added.findWithin(query, max_distance));
+        }
+        for (const std::size_t count : {1, 5, 50, 5000}) {
+            const auto end = all.begin() + static_cast<std::ptrdiff_t>(std::min(count, all.size()));
+            const std::vector<FuzzyMatch> closest(all.begin(), end);
+            ExpectEqual(closest, index.findClosest(query, count));
+        }
+    }
+}
+
+TEST(FuzzyIndexTest, QueriesAlternateBetweenIndices) {
+    std::vector<std::string> words = MakeWords(2000, 5);
+    const FuzzyIndex large(words);
+    words.resize(50);
+    FuzzyIndex small(words);
+    for (const std::string& query : MakeWords(20, 6)) {
+        SCOPED_TRACE(query);
+        ExpectEqual(FindAll(words, query), small.findClosest(query, words.size()));
+        EXPECT_EQ(5u, large.findClosest(query, 5).size());
+        words.push_back(query);
+        small.add(query);
+        ExpectEqual(FindAll(words, query), small.findWithin(query, 100));
+    }
+}
+
+TEST(FuzzyIndexTest, QueriesRunConcurrently) {
+    const std::vector<std::string> words = MakeWords(1000, 3);
+    const FuzzyIndex index(words);
+    const std::vector<std::string> queries = MakeWords(40, 4);
+    std::vector<std::vector<FuzzyMatch>> results(queries.size());
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (std::size_t idx = thread; idx < queries.size(); idx += 4) {
+                results[idx] = index.findClosest(queries[idx], 3);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (std::size_t idx = 0; idx < queries.size(); ++idx) {
+        ExpectEqual(index.findClosest(queries[idx], 3), results[idx]);
+    }
+}
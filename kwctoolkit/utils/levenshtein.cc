@@ -0,0 +1,333 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/utils/levenshtein.h"
+
+#include <memory>
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include <immintrin.h>
+
+    #include "kwctoolkit/system/cpu.h"
+#endif
+
+namespace kwc {
+namespace utils {
+namespace internal {
+namespace {
+// Bit vectors of the pattern per byte value. Only the entries of bytes in
+// the pattern or the text are initialized, which are the only ones read
+void InitMatchVectors(const uint8* pattern, std::size_t m, const uint8* text, std::size_t n,
+                      std::size_t num_words, uint64* match_vectors) {
+    for (std::size_t idx = 0; idx < n; ++idx) {
+        std::fill_n(match_vectors + text[idx] * num_words, num_words, 0);
+    }
+    for (std::size_t idx = 0; idx < m; ++idx) {
+        std::fill_n(match_vectors + pattern[idx] * num_words, num_words, 0);
+    }
+    for (std::size_t idx = 0; idx < m; ++idx) {
+        match_vectors[pattern[idx] * num_words + idx / 64] |= uint64{1} << (idx % 64);
+    }
+}
+
+// Bit i of the vertical vectors |plus| and |minus| is set if the entry of
+// row i + 1 is one more, respectively one less than the one of row i in the
+// current column. The horizontal vectors likewise compare the entries of
+// the current and the next column. Starting from the first column, which
+// increases by one per row, every byte of the text yields the next column
+// with a few word operations. The distance is tracked in the last row.
+// |max| is at least the difference of the lengths m <= n
+unsigned int MyersDistance(const uint8* pattern, std::size_t m, const uint8* text,
+                           std::size_t n, std::size_t max) {
+    uint64 match_vectors[256];
+    InitMatchVectors(pattern, m, text, n, 1, match_vectors);
+    const uint64 last = uint64{1} << (m - 1);
+    uint64 plus = ~uint64{0};
+    uint64 minus = 0;
+    std::size_t distance = m;
+    for (std::size_t idx = 0; idx < n; ++idx) {
+        const uint64 match = match_vectors[text[idx]];
+        const uint64 vertical = match | minus;
+        const uint64 diagonal = (((match & plus) + plus) ^ plus) | match;
+        uint64 horizontal_plus = minus | ~(diagonal | plus);
+        uint64 horizontal_minus = plus & diagonal;
+        if ((horizontal_plus & last) != 0) {
+            ++distance;
+        } else if ((horizontal_minus & last) != 0) {
+            --distance;
+        }
+        // The distance decreases by at most one per remaining byte
+        if (distance > max + (n - idx - 1)) {
+            return static_cast<unsigned int>(max + 1);
+        }
+        // The first row increases by one per column
+        horizontal_plus = (horizontal_plus << 1) | 1;
+        horizontal_minus <<= 1;
+        plus = horizontal_minus | ~(vertical | horizontal_plus);
+        minus = horizontal_plus & vertical;
+    }
+    return static_cast<unsigned int>(std::min(distance, max + 1));
+}
+
+// Myers' algorithm for patterns longer than 64 bytes, with the columns split
+// into blocks of 64 rows. Each block passes the horizontal difference of its
+// last row on to the next block, in place of the first row
+unsigned int MyersBlockDistance(const uint8* pattern, std::size_t m, const uint8* text,
+                                std::size_t n, std::size_t max) {
+    const std::size_t num_words = (m + 63) / 64;
+    std::unique_ptr<uint64[]> match_vectors(new uint64[256 * num_words]);
+    InitMatchVectors(pattern, m, text, n, num_words, match_vectors.get());
+    std::vector<uint64> plus(num_words, ~uint64{0});
+    std::vector<uint64> minus(num_words, 0);
+    const uint64 last = uint64{1} << ((m - 1) % 64);
+    std::size_t distance = m;
+    for (std::size_t idx = 0; idx < n; ++idx) {
+        const uint64* matches = &match_vectors[text[idx] * num_words];
+        int carry = 1;
+        for (std::size_t word = 0; word < num_words; ++word) {
+            uint64 match = matches[word];
+            const uint64 vertical = match | minus[word];
+            if (carry < 0) {
+                match |= 1;
+            }
+            const uint64 diagonal = (((match & plus[word]) + plus[word]) ^ plus[word]) | match;
+            uint64 horizontal_plus = minus[word] | ~(diagonal | plus[word]);
+            uint64 horizontal_minus = plus[word] & diagonal;
+            const uint64 high = word + 1 == num_words ? last : uint64{1} << 63;
+            const int next_carry = (horizontal_plus & high) != 0    ? 1
+                                   : (horizontal_minus & high) != 0 ? -1
+                                                                    : 0;
+            horizontal_plus = (horizontal_plus << 1) | (carry > 0 ? 1 : 0);
+            horizontal_minus = (horizontal_minus << 1) | (carry < 0 ? 1 : 0);
+            plus[word] = horizontal_minus | ~(vertical | horizontal_plus);
+            minus[word] = horizontal_plus & vertical;
+            carry = next_carry;
+        }
+        distance += carry;
+        if (distance > max + (n - idx - 1)) {
+            return static_cast<unsigned int>(max + 1);
+        }
+    }
+    return static_cast<unsigned int>(std::min(distance, max + 1));
+}
+
+// Match vectors of all byte values for a pattern of up to 64 bytes
+void InitAllMatchVectors(const uint8* pattern, std::size_t m, uint64* match_vectors) {
+    std::fill_n(match_vectors, 256, 0);
+    for (std::size_t idx = 0; idx < m; ++idx) {
+        match_vectors[pattern[idx]] |= uint64{1} << idx;
+    }
+}
+
+// Continues MyersDistance() from the column given by |plus|, |minus| and
+// |distance| over the |n| remaining bytes of |text|, without bound
+unsigned int MyersContinue(const uint64* match_vectors, uint64 last, const uint8* text,
+                           std::size_t n, uint64 plus, uint64 minus, std::size_t distance) {
+    for (std::size_t idx = 0; idx < n; ++idx) {
+        const uint64 match = match_vectors[text[idx]];
+        const uint64 vertical = match | minus;
+        const uint64 diagonal = (((match & plus) + plus) ^ plus) | match;
+        uint64 horizontal_plus = minus | ~(diagonal | plus);
+        uint64 horizontal_minus = plus & diagonal;
+        distance += (horizontal_plus & last) != 0 ? 1 : 0;
+        distance -= (horizontal_minus & last) != 0 ? 1 : 0;
+        horizontal_plus = (horizontal_plus << 1) | 1;
+        horizontal_minus <<= 1;
+        plus = horizontal_minus | ~(vertical | horizontal_plus);
+        minus = horizontal_plus & vertical;
+    }
+    return static_cast<unsigned int>(distance);
+}
+
+const uint8* Bytes(const std::string& str) {
+    return reinterpret_cast<const uint8*>(str.data());
+}
+
+using BatchFunction = void (*)(const uint8*, std::size_t, const std::string*, std::size_t,
+                               unsigned int*);
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+BatchFunction SelectBatch() {
+    const system::CPU& cpu = system::CPU::getInstance();
+    if (cpu.hasAvx2()) {
+        return LevenshteinBatchAvx2;
+    }
+    return LevenshteinBatchScalar;
+}
+#else
+BatchFunction SelectBatch() {
+    return LevenshteinBatchScalar;
+}
+#endif
+}  // namespace
+
+void LevenshteinBatchScalar(const uint8* query, std::size_t query_size,
+                            const std::string* candidates, std::size_t count,
+                            unsigned int* distances) {
+    uint64 match_vectors[256];
+    InitAllMatchVectors(query, query_size, match_vectors);
+    const uint64 last = uint64{1} << (query_size - 1);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        distances[idx] = MyersContinue(match_vectors, last, Bytes(candidates[idx]),
+                                       candidates[idx].size(), ~uint64{0}, 0, query_size);
+    }
+}
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+KWC_TARGET_ATTRIBUTE("avx2")
+void LevenshteinBatchAvx2(const uint8* query, std::size_t query_size,
+                          const std::string* candidates, std::size_t count,
+                          unsigned int* distances) {
+    uint64 match_vectors[256];
+    InitAllMatchVectors(query, query_size, match_vectors);
+
+    // Candidates by length, such that the lanes mostly run candidates of the
+    // same length. Lengths above 255 only share a bucket
+    std::size_t offsets[257] = {};
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        ++offsets[std::min<std::size_t>(candidates[idx].size(), 255) + 1];
+    }
+    std::partial_sum(offsets, offsets + 257, offsets);
+    std::vector<std::size_t> order(count);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        order[offsets[std::min<std::size_t>(candidates[idx].size(), 255)]++] = idx;
+    }
+
+    const __m256i last_bits = _mm256_set1_epi64x(static_cast<int64>(uint64{1} << (query_size - 1)));
+    const __m256i all_bits = _mm256_set1_epi64x(-1);
+    const __m256i low_bit = _mm256_set1_epi64x(1);
+    // Bytes of eight candidates interleaved and padded with zeros, which run
+    // as two independent groups of four lanes to hide the latency of a step
+    std::vector<uint8> text;
+    for (std::size_t group = 0; group < count; group += 8) {
+        const std::size_t num_lanes = std::min<std::size_t>(count - group, 8);
+        alignas(32) int64 lengths[8] = {};
+        for (std::size_t lane = 0; lane < num_lanes; ++lane) {
+            lengths[lane] = static_cast<int64>(candidates[order[group + lane]].size());
+        }
+        const auto steps = static_cast<std::size_t>(*std::max_element(lengths, lengths + 8));
+        text.assign(8 * steps, 0);
+        for (std::size_t lane = 0; lane < num_lanes; ++lane) {
+            const std::string& candidate = candidates[order[group + lane]];
+            for (std::size_t idx = 0; idx < candidate.size(); ++idx) {
+                text[8 * idx + lane] = static_cast<uint8>(candidate[idx]);
+            }
+        }
+
+        __m256i lengths_vec[2];
+        __m256i plus[2];
+        __m256i minus[2];
+        __m256i distance[2];
+        for (int half = 0; half < 2; ++half) {
+            lengths_vec[half] =
+                _mm256_load_si256(reinterpret_cast<const __m256i*>(lengths + 4 * half));
+            plus[half] = all_bits;
+            minus[half] = _mm256_setzero_si256();
+            distance[half] = _mm256_set1_epi64x(static_cast<int64>(query_size));
+        }
+        __m256i position = _mm256_setzero_si256();
+        for (std::size_t idx = 0; idx < steps; ++idx) {
+            const uint8* bytes = &text[8 * idx];
+            for (int half = 0; half < 2; ++half) {
+                const uint8* half_bytes = bytes + 4 * half;
+                const __m256i match =
+                    _mm256_setr_epi64x(static_cast<int64>(match_vectors[half_bytes[0]]),
+                                       static_cast<int64>(match_vectors[half_bytes[1]]),
+                                       static_cast<int64>(match_vectors[half_bytes[2]]),
+                                       static_cast<int64>(match_vectors[half_bytes[3]]));
+                // Lanes whose candidate is done keep their distance
+                const __m256i active = _mm256_cmpgt_epi64(lengths_vec[half], position);
+                const __m256i vertical = _mm256_or_si256(match, minus[half]);
+                const __m256i diagonal = _mm256_or_si256(
+                    _mm256_xor_si256(
+                        _mm256_add_epi64(_mm256_and_si256(match, plus[half]), plus[half]),
+                        plus[half]),
+                    match);
+                __m256i horizontal_plus = _mm256_or_si256(
+                    minus[half], _mm256_xor_si256(_mm256_or_si256(diagonal, plus[half]), all_bits));
+                __m256i horizontal_minus = _mm256_and_si256(plus[half], diagonal);
+                // Comparisons give -1 in the lanes with the last bit set
+                const __m256i increment =
+                    _mm256_cmpeq_epi64(_mm256_and_si256(horizontal_plus, last_bits), last_bits);
+                const __m256i decrement =
+                    _mm256_cmpeq_epi64(_mm256_and_si256(horizontal_minus, last_bits), last_bits);
+                distance[half] =
+                    _mm256_sub_epi64(distance[half], _mm256_and_si256(increment, active));
+                distance[half] =
+                    _mm256_add_epi64(distance[half], _mm256_and_si256(decrement, active));
+                horizontal_plus = _mm256_or_si256(_mm256_slli_epi64(horizontal_plus, 1), low_bit);
+                horizontal_minus = _mm256_slli_epi64(horizontal_minus, 1);
+                plus[half] = _mm256_or_si256(
+                    horizontal_minus,
+                    _mm256_xor_si256(_mm256_or_si256(vertical, horizontal_plus), all_bits));
+                minus[half] = _mm256_and_si256(horizontal_plus, vertical);
+            }
+            position = _mm256_add_epi64(position, low_bit);
+        }
+        alignas(32) int64 distance_lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(distance_lanes), distance[0]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(distance_lanes + 4), distance[1]);
+        for (std::size_t lane = 0; lane < num_lanes; ++lane) {
+            distances[order[group + lane]] = static_cast<unsigned int>(distance_lanes[lane]);
+        }
+    }
+}
+#endif
+
+unsigned int LevenshteinDistanceBytes(const uint8* s1, std::size_t len1, const uint8* s2,
+                                      std::size_t len2, unsigned int max) {
+    // A common prefix and suffix doesn't change the distance
+    const std::size_t prefix = std::mismatch(s1, s1 + std::min(len1, len2), s2).first - s1;
+    s1 += prefix;
+    s2 += prefix;
+    len1 -= prefix;
+    len2 -= prefix;
+    std::size_t suffix = 0;
+    while (suffix < len1 && suffix < len2 && s1[len1 - suffix - 1] == s2[len2 - suffix - 1]) {
+        ++suffix;
+    }
+    len1 -= suffix;
+    len2 -= suffix;
+
+    if (len1 > len2) {
+        std::swap(s1, s2);
+        std::swap(len1, len2);
+    }
+    // At least the difference of the lengths is inserted
+    if (len2 - len1 > max) {
+        return max + 1;
+    }
+    if (len1 == 0) {
+        return static_cast<unsigned int>(len2);
+    }
+    if (len1 <= 64) {
+        return MyersDistance(s1, len1, s2, len2, max);
+    }
+    return MyersBlockDistance(s1, len1, s2, len2, max);
+}
+
+}  // namespace internal
+
+std::vector<unsigned int> LevenshteinBatch(const std::string& query,
+                                           const std::vector<std::string>& candidates) {
+    std::vector<unsigned int> distances(candidates.size());
+    if (query.empty()) {
+        std::transform(candidates.begin(), candidates.end(), distances.begin(),
+                       [](const std::string& candidate) {
+                           return static_cast<unsigned int>(candidate.size());
+                       });
+    } else if (query.size() <= 64) {
+        static const internal::BatchFunction batch = internal::SelectBatch();
+        batch(internal::Bytes(query), query.size(), candidates.data(), candidates.size(),
+              distances.data());
+    } else {
+        std::transform(
+            candidates.begin(), candidates.end(), distances.begin(),
+            [&](const std::string& candidate) { return LevenshteinDistance(query, candidate); });
+    }
+    return distances;
+}
+
+}  // namespace utils
+}  // namespace kwc
@@ -6,15 +6,34 @@
 #define KWCTOOLKIT_UTILS_LEVENSHTEIN_H_
 
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
 #include <numeric>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "kwctoolkit/base/compiler.h"
+#include "kwctoolkit/base/integral_types.h"
+
 namespace kwc {
 namespace utils {
+namespace internal {
+// Distance of two byte strings by the bit-vector algorithm of G. Myers, "A
+// Fast Bit-Vector Algorithm for Approximate String Matching Based on Dynamic
+// Programming", J. ACM 46(3), 1999. The shorter string is the pattern, which
+// is processed in one machine word for up to 64 bytes and in blocks of 64
+// bytes otherwise. Returns |max| + 1 as soon as the distance exceeds |max|
+unsigned int LevenshteinDistanceBytes(const uint8* s1, std::size_t len1, const uint8* s2,
+                                      std::size_t len2, unsigned int max);
 
+// Two column dynamic programming for sequences of any comparable elements.
+// Returns |max| + 1 as soon as all entries of a column exceed |max|, as every
+// sequence of edits passes through each column
 template <typename T>
-unsigned int LevenshteinDistance(const T s1, const T s2) {
+unsigned int LevenshteinDistanceDP(const T& s1, const T& s2, unsigned int max) {
     const auto len1 = s1.size();
     const auto len2 = s2.size();
     std::vector<unsigned int> col(len2 + 1);
@@ -24,22 +43,98 @@ unsigned int LevenshteinDistance(const T s1, const T s2) {
 
     for (unsigned i = 0; i < len1; i++) {
         col[0] = i + 1;
+        unsigned int col_min = col[0];
         for (unsigned j = 0; j < len2; j++) {
             col[j + 1] =
                 std::min({prev_col[1 + j] + 1, col[j] + 1, prev_col[j] + (s1[i] == s2[j] ? 0 : 1)});
+            col_min = std::min(col_min, col[j + 1]);
+        }
+        if (col_min > max) {
+            return max + 1;
         }
         col.swap(prev_col);
     }
-    return prev_col[len2];
+    return std::min(prev_col[len2], max + 1);
+}
+
+// Sequences of contiguous single byte elements such as std::string and
+// std::vector<char>, which are compared by LevenshteinDistanceBytes()
+template <typename T, typename = void>
+struct IsByteSequence : std::false_type {};
+
+template <typename T>
+struct IsByteSequence<T, decltype(void(std::declval<const T&>().data()))>
+    : std::integral_constant<bool, std::is_integral<typename T::value_type>::value &&
+                                       sizeof(typename T::value_type) == 1> {};
+
+template <typename T>
+unsigned int LevenshteinDistance(const T& s1, const T& s2, unsigned int max, std::true_type) {
+    return LevenshteinDistanceBytes(reinterpret_cast<const uint8*>(s1.data()), s1.size(),
+                                    reinterpret_cast<const uint8*>(s2.data()), s2.size(), max);
+}
+
+template <typename T>
+unsigned int LevenshteinDistance(const T& s1, const T& s2, unsigned int max, std::false_type) {
+    return LevenshteinDistanceDP(s1, s2, max);
 }
 
-template <>
-unsigned int LevenshteinDistance<const char*>(const char* s1, const char* s2) {
-    std::string string1{s1};
-    std::string string2{s2};
-    return LevenshteinDistance(string1, string2);
+// Inner loops of LevenshteinBatch() for queries of 1 to 64 bytes, which
+// store the distance of |query| to each of the |count| candidates in
+// |distances|. The match vectors of the query are set up once for all
+// candidates
+void LevenshteinBatchScalar(const uint8* query, std::size_t query_size,
+                            const std::string* candidates, std::size_t count,
+                            unsigned int* distances);
+
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+// Only to be called if system::CPU reports support for AVX2. Runs eight
+// candidates of similar lengths at once, one per 64 bit lane of two registers
+void LevenshteinBatchAvx2(const uint8* query, std::size_t query_size,
+                          const std::string* candidates, std::size_t count,
+                          unsigned int* distances);
+#endif
+}  // namespace internal
+
+// Minimum number of insertions, deletions and substitutions of single
+// elements turning |s1| into |s2|. Byte sequences such as std::string take
+// O(ceil(m / 64) * n) steps for the lengths m <= n, any other sequences
+// O(m * n)
+template <typename T>
+unsigned int LevenshteinDistance(const T& s1, const T& s2) {
+    return internal::LevenshteinDistance(s1, s2, std::numeric_limits<unsigned int>::max() - 1,
+                                         internal::IsByteSequence<T>());
 }
 
+inline unsigned int LevenshteinDistance(const char* s1, const char* s2) {
+    return internal::LevenshteinDistanceBytes(
+        reinterpret_cast<const uint8*>(s1), std::strlen(s1), reinterpret_cast<const uint8*>(s2),
+        std::strlen(s2), std::numeric_limits<unsigned int>::max() - 1);
+}
+
+// Like LevenshteinDistance(), but returns |max| + 1 as soon as the distance
+// is known to exceed |max|. Most candidates of a fuzzy search are rejected
+// early that way, some by their lengths alone
+template <typename T>
+unsigned int LevenshteinDistanceBounded(const T& s1, const T& s2, unsigned int max) {
+    return internal::LevenshteinDistance(
+        s1, s2, std::min(max, std::numeric_limits<unsigned int>::max() - 1),
+        internal::IsByteSequence<T>());
+}
+
+inline unsigned int LevenshteinDistanceBounded(const char* s1, const char* s2,
+                                               unsigned int max) {
+    return internal::LevenshteinDistanceBytes(
+        reinterpret_cast<const uint8*>(s1), std::strlen(s1), reinterpret_cast<const uint8*>(s2),
+        std::strlen(s2), std::min(max, std::numeric_limits<unsigned int>::max() - 1));
+}
+
+// Distances of |query| to each of |candidates|, in the same order, such as
+// for suggesting the closest of a list of commands. Equal to calling
+// LevenshteinDistance() for each candidate, but faster for queries of up to
+// 64 bytes
+std::vector<unsigned int> LevenshteinBatch(const std::string& query,
+                                           const std::vector<std::string>& candidates);
+
 }  // namespace utils
 }  // namespace kwc
 
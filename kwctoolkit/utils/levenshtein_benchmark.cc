@@ -0,0 +1,105 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "kwctoolkit/utils/benchmark.h"
+#include "kwctoolkit/utils/levenshtein.h"
+#include "tests/random_data.h"
+
+namespace {
+// Pseudo-random lower case word, such that two words of the same length
+// differ in most positions
+std::string MakeWord(kwc::int64 length, kwc::uint32 seed) {
+    kwc::test::RandomGenerator random(seed);
+    return kwc::test::RandomWord(static_cast<std::size_t>(length), 26, &random);
+}
+}  // namespace
+
+// Items are the cells of the dynamic programming matrix
+BENCHMARK(LevenshteinDistance) {
+    const std::string s1 = MakeWord(context.arg(), 1);
+    const std::string s2 = MakeWord(context.arg(), 2);
+    while (context.running()) {
+        kwc::utils::DoNotOptimize(kwc::utils::LevenshteinDistance(s1, s2));
+    }
+    context.setItemsProcessed(context.iterations() * context.arg() * context.arg());
+}
+BENCHMARK_CONFIGURE(LevenshteinDistance)->rangeMultiplier(4)->range(4, 1024);
+
+BENCHMARK(LevenshteinDistanceDP) {
+    const std::string s1 = MakeWord(context.arg(), 1);
+    const std::string s2 = MakeWord(context.arg(), 2);
+    while (context.running()) {
+        kwc::utils::DoNotOptimize(kwc::utils::internal::LevenshteinDistanceDP(
+            s1, s2, std::numeric_limits<unsigned int>::max() - 1));
+    }
+    context.setItemsProcessed(context.iterations() * context.arg() * context.arg());
+}
+BENCHMARK_CONFIGURE(LevenshteinDistanceDP)->rangeMultiplier(4)->range(4, 1024);
+
+// Rejecting a candidate for a fuzzy match within two edits
+BENCHMARK(LevenshteinDistanceBounded) {
+    const std::string s1 = MakeWord(context.arg(), 1);
+    const std::string s2 = MakeWord(context.arg(), 2);
+    while (context.running()) {
+        kwc::utils::DoNotOptimize(kwc::utils::LevenshteinDistanceBounded(s1, s2, 2));
+    }
+    context.setItemsProcessed(context.iterations() * context.arg() * context.arg());
+}
+BENCHMARK_CONFIGURE(LevenshteinDistanceBounded)->rangeMultiplier(4)->range(4, 1024);
+
+namespace {
+// Candidates of 4 to 19 letters, as command or flag names
+std::vector<std::string> MakeCandidates(kwc::int64 count) {
+    std::vector<std::string> candidates;
+    for (kwc::int64 idx = 0; idx < count; ++idx) {
+        candidates.push_back(MakeWord(4 + idx % 16, static_cast<kwc::uint32>(idx)));
+    }
+    return candidates;
+}
+}  // namespace
+
+// Items are the candidates compared against the query
+BENCHMARK(LevenshteinBatch) {
+    const std::vector<std::string> candidates = MakeCandidates(context.arg());
+    const std::string query = MakeWord(12, 0);
+    while (context.running()) {
+        kwc::utils::DoNotOptimize(kwc::utils::LevenshteinBatch(query, candidates));
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(LevenshteinBatch)->arg(16)->arg(1000);
+
+BENCHMARK(LevenshteinBatchScalar) {
+    const std::vector<std::string> candidates = MakeCandidates(context.arg());
+    const std::string query = MakeWord(12, 0);
+    std::vector<unsigned int> distances(candidates.size());
+    while (context.running()) {
+        kwc::utils::internal::LevenshteinBatchScalar(
+            reinterpret_cast<const kwc::uint8*>(query.data()), query.size(), candidates.data(),
+            candidates.size(), distances.data());
+        kwc::utils::DoNotOptimize(distances);
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(LevenshteinBatchScalar)->arg(16)->arg(1000);
+
+// One call of the dynamic programming template per candidate, for reference
+BENCHMARK(LevenshteinBatchDP) {
+    const std::vector<std::string> candidates = MakeCandidates(context.arg());
+    const std::string query = MakeWord(12, 0);
+    std::vector<unsigned int> distances(candidates.size());
+    while (context.running()) {
+        for (std::size_t idx = 0; idx < candidates.size(); ++idx) {
+            distances[idx] = kwc::utils::internal::LevenshteinDistanceDP(
+                query, candidates[idx], std::numeric_limits<unsigned int>::max() - 1);
+        }
+        kwc::utils::DoNotOptimize(distances);
+    }
+    context.setItemsProcessed(context.iterations() * context.arg());
+}
+BENCHMARK_CONFIGURE(LevenshteinBatchDP)->arg(16)->arg(1000);
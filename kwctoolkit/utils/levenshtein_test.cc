@@ -6,11 +6,61 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
+#include "kwctoolkit/base/integral_types.h"
+#include "tests/random_data.h"
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    #include "kwctoolkit/system/cpu.h"
+#endif
+
 using namespace kwc::utils;
 
+namespace {
+const unsigned int kUnbounded = std::numeric_limits<unsigned int>::max() - 1;
+
+// |s| with |count| random substitutions, insertions and deletions
+std::string Mutate(std::string s, int count, kwc::test::RandomGenerator* random) {
+    for (int idx = 0; idx < count; ++idx) {
+        const std::size_t pos =
+            s.empty() ? 0 : random->uniform(static_cast<kwc::uint32>(s.size()));
+        switch (random->uniform(3)) {
+            case 0:
+                if (!s.empty()) {
+                    s[pos] = 'z';
+                }
+                break;
+            case 1:
+                s.insert(pos, 1, 'y');
+                break;
+            default:
+                if (!s.empty()) {
+                    s.erase(pos, 1);
+                }
+                break;
+        }
+    }
+    return s;
+}
+
+using BatchFunction = void (*)(const kwc::uint8*, std::size_t, const std::string*, std::size_t,
+                               unsigned int*);
+
+// Inner loops of LevenshteinBatch(), which are supported by the CPU
+std::vector<BatchFunction> SupportedBatchFunctions() {
+    std::vector<BatchFunction> functions{internal::LevenshteinBatchScalar};
+#if defined(KWC_ARCH_CPU_X86_FAMILY)
+    if (kwc::system::CPU::getInstance().hasAvx2()) {
+        functions.push_back(internal::LevenshteinBatchAvx2);
+    }
+#endif
+    return functions;
+}
+}  // namespace
+
 TEST(LevenshteinTest, SameStringGivesZeroDistance) {
     const std::string lev1("FooBar");
     ASSERT_TRUE(LevenshteinDistance(lev1, lev1) == 0);
@@ -54,3 +104,83 @@ TEST(LevenshteinTest, SatisfiesAxiomsOfMetricSpace) {
     auto d_zy = LevenshteinDistance(lev3, lev2);
     EXPECT_LE(d_xy, d_xz + d_zy);
 }
+
+TEST(LevenshteinTest, BitVectorsMatchDynamicProgramming) {
+    kwc::test::RandomGenerator random(42);
+    for (const std::size_t length : {0, 1, 2, 63, 64, 65, 127, 128, 129, 200, 300}) {
+        for (const kwc::uint32 alphabet_size : {2u, 4u, 26u}) {
+            for (int round = 0; round < 4; ++round) {
+                const std::string s1 = kwc::test::RandomWord(length, alphabet_size, &random);
+                const std::string s2 =
+                    round % 2 == 0
+                        ? Mutate(s1, 1 + static_cast<int>(length / 8), &random)
+                        : kwc::test::RandomWord(length + round * 7, alphabet_size, &random);
+                SCOPED_TRACE(s1 + " " + s2);
+                const unsigned int expected = internal::LevenshteinDistanceDP(s1, s2, kUnbounded);
+                EXPECT_EQ(expected, LevenshteinDistance(s1, s2));
+                EXPECT_EQ(expected, LevenshteinDistance(s2, s1));
+            }
+        }
+    }
+}
+
+TEST(LevenshteinTest, BoundedStopsAboveMax) {
+    kwc::test::RandomGenerator random(7);
+    for (const std::size_t length : {5, 40, 64, 100, 250}) {
+        const std::string s1 = kwc::test::RandomWord(length, 4, &random);
+        const std::string s2 = Mutate(s1, static_cast<int>(length / 4), &random);
+        const unsigned int distance = LevenshteinDistance(s1, s2);
+        for (unsigned int max = 0; max <= distance + 2; ++max) {
+            EXPECT_EQ(std::min(distance, max + 1), LevenshteinDistanceBounded(s1, s2, max));
+            EXPECT_EQ(std::min(distance, max + 1), internal::LevenshteinDistanceDP(s1, s2, max));
+        }
+    }
+    EXPECT_EQ(3u, LevenshteinDistanceBounded("ab", "abcdefg", 2));
+    EXPECT_EQ(1u, LevenshteinDistanceBounded("command", "comand", 2));
+    EXPECT_EQ(0u, LevenshteinDistanceBounded(std::string(), std::string(), 0));
+}
+
+TEST(LevenshteinTest, SequencesOfOtherElementsUseDynamicProgramming) {
+    const std::vector<int> v1{1, 2, 3, 4, 1000};
+    const std::vector<int> v2{2, 3, 4, 5, 1000, 6};
+    EXPECT_EQ(3u, LevenshteinDistance(v1, v2));
+    EXPECT_EQ(2u, LevenshteinDistanceBounded(v1, v2, 1));
+}
+
+TEST(LevenshteinTest, BatchMatchesSingleDistances) {
+    kwc::test::RandomGenerator random(3);
+    std::vector<std::string> candidates;
+    for (std::size_t idx = 0; idx < 101; ++idx) {
+        candidates.push_back(kwc::test::RandomWord(idx % 7 == 0 ? 0 : (idx * 37) % 90, 4, &random));
+    }
+    for (const std::size_t length : {0, 1, 5, 63, 64, 65, 100}) {
+        const std::string query = kwc::test::RandomWord(length, 4, &random);
+        SCOPED_TRACE(query);
+        const std::vector<unsigned int> distances = LevenshteinBatch(query, candidates);
+        ASSERT_EQ(candidates.size(), distances.size());
+        for (std::size_t idx = 0; idx < candidates.size(); ++idx) {
+            EXPECT_EQ(LevenshteinDistance(query, candidates[idx]), distances[idx]);
+        }
+    }
+    EXPECT_TRUE(LevenshteinBatch("foo", {}).empty());
+}
+
+TEST(LevenshteinTest, BatchFunctionsMatchSingleDistances) {
+    kwc::test::RandomGenerator random(5);
+    const std::string query = kwc::test::RandomWord(12, 3, &random);
+    for (const std::size_t count : {1, 3, 4, 5, 17}) {
+        std::vector<std::string> candidates;
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            const std::size_t length = idx % 5 == 4 ? 0 : 1 + random.uniform(64);
+            candidates.push_back(kwc::test::RandomWord(length, 3, &random));
+        }
+        for (const BatchFunction batch : SupportedBatchFunctions()) {
+            std::vector<unsigned int> distances(count);
+            batch(reinterpret_cast<const kwc::uint8*>(query.data()), query.size(),
+                  candidates.data(), count, distances.data());
+            for (std::size_t idx = 0; idx < count; ++idx) {
+                EXPECT_EQ(LevenshteinDistance(query, candidates[idx]), distances[idx]);
+            }
+        }
+    }
+}
@@ -0,0 +1,173 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/utils/perf_counters.h"
+
+#include "kwctoolkit/base/integral_types.h"
+#include "kwctoolkit/base/platform.h"
+
+#if defined(KWC_OS_LINUX)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    #include <cstring>
+#endif
+
+namespace kwc {
+namespace utils {
+namespace {
+#if defined(KWC_OS_LINUX)
+// Hardware event ids in PerfCounter order
+constexpr uint64 kEventIds[kNumPerfCounters] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+int OpenCounter(uint64 event_id, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = event_id;
+    // Counting user space only is allowed up to perf_event_paranoid 2
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+}  // namespace
+
+const char* PerfCounterName(PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::Cycles:
+            return "cycles";
+        case PerfCounter::Instructions:
+            return "instructions";
+        case PerfCounter::CacheMisses:
+            return "cache_misses";
+        case PerfCounter::BranchMisses:
+            return "branch_misses";
+    }
+    return "";
+}
+
+bool PerfCounterValues::empty() const {
+    for (bool counter_available : available) {
+        if (counter_available) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PerfCounterValues& PerfCounterValues::operator+=(const PerfCounterValues& other) {
+    for (int idx = 0; idx < kNumPerfCounters; ++idx) {
+        available[idx] = available[idx] || other.available[idx];
+        counts[idx] += other.counts[idx];
+    }
+    return *this;
+}
+
+#if defined(KWC_OS_LINUX)
+PerfCounters::PerfCounters() {
+    for (int idx = 0; idx < kNumPerfCounters; ++idx) {
+        fds_[idx] = OpenCounter(kEventIds[idx], leader_fd_);
+        if (leader_fd_ < 0 && fds_[idx] >= 0) {
+            leader_fd_ = fds_[idx];
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounters::start() {
+    if (leader_fd_ >= 0) {
+        ioctl(leader_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+void PerfCounters::stop() {
+    if (leader_fd_ >= 0) {
+        ioctl(leader_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+void PerfCounters::reset() {
+    if (leader_fd_ >= 0) {
+        ioctl(leader_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+PerfCounterValues PerfCounters::read() const {
+    PerfCounterValues values;
+    if (leader_fd_ < 0) {
+        return values;
+    }
+
+    // Layout of PERF_FORMAT_GROUP: nr, time_enabled, time_running followed
+    // by one value per group member in the order they were opened
+    uint64 buffer[3 + kNumPerfCounters] = {};
+    if (::read(leader_fd_, buffer, sizeof(buffer)) < 0) {
+        return values;
+    }
+    const uint64 time_enabled = buffer[1];
+    const uint64 time_running = buffer[2];
+    const double scale =
+        time_running > 0 ? static_cast<double>(time_enabled) / time_running : 0.0;
+
+    uint64 member = 0;
+    for (int idx = 0; idx < kNumPerfCounters && member < buffer[0]; ++idx) {
+        if (fds_[idx] < 0) {
+            continue;
+        }
+        values.available[idx] = true;
+        values.counts[idx] = static_cast<double>(buffer[3 + member]) * scale;
+        ++member;
+    }
+    return values;
+}
+
+bool PerfCounters::isSupported() {
+    static const bool supported = PerfCounters().isValid();
+    return supported;
+}
+#else
+PerfCounters::PerfCounters() {
+    for (int& fd : fds_) {
+        fd = -1;
+    }
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+void PerfCounters::stop() {}
+
+void PerfCounters::reset() {}
+
+PerfCounterValues PerfCounters::read() const {
+    return PerfCounterValues();
+}
+
+bool PerfCounters::isSupported() {
+    return false;
+}
+#endif
+
+}  // namespace utils
+}  // namespace kwc
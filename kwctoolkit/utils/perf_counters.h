@@ -0,0 +1,88 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef KWCTOOLKIT_UTILS_PERF_COUNTERS_H_
+#define KWCTOOLKIT_UTILS_PERF_COUNTERS_H_
+
+#include "kwctoolkit/base/macros.h"
+
+namespace kwc {
+namespace utils {
+
+enum class PerfCounter { Cycles = 0, Instructions, CacheMisses, BranchMisses };
+
+constexpr int kNumPerfCounters = 4;
+
+// Short human-readable name, e.g. "cycles"
+const char* PerfCounterName(PerfCounter counter);
+
+// Snapshot of hardware counter values. Counters which could not be opened
+// are marked as not available and stay zero
+struct PerfCounterValues {
+    bool available[kNumPerfCounters] = {};
+    double counts[kNumPerfCounters] = {};
+
+    bool has(PerfCounter counter) const { return available[static_cast<int>(counter)]; }
+
+    double get(PerfCounter counter) const { return counts[static_cast<int>(counter)]; }
+
+    bool empty() const;
+
+    // Adds the counts of |other|. A counter is available in the sum if it is
+    // available in either operand
+    PerfCounterValues& operator+=(const PerfCounterValues& other);
+};
+
+// Hardware performance counters of the calling thread
+//
+// On Linux the counters are opened as a single perf_event_open() group
+// counting user space events only, so that they are enabled and disabled
+// together with one ioctl. Counts are scaled up in case the kernel had to
+// multiplex the group with other events.
+//
+// Access is commonly restricted, e.g. by kernel.perf_event_paranoid, inside
+// containers or virtual machines without a virtual PMU. Counters which can't
+// be opened are simply not available, and on other platforms none are.
+// start() and stop() are no-ops then, so callers don't need to check.
+//
+// Example:
+//
+//     PerfCounters counters;
+//     counters.start();
+//     ...
+//     counters.stop();
+//     if (counters.read().has(PerfCounter::Cycles)) ...
+//
+// Counters accumulate across start()/stop() pairs until reset().
+class PerfCounters {
+  public:
+    // Opens the counters for the calling thread. The counters only count
+    // events of the thread that created them
+    PerfCounters();
+    ~PerfCounters();
+
+    // Whether at least one counter could be opened
+    bool isValid() const { return leader_fd_ >= 0; }
+
+    void start();
+    void stop();
+    void reset();
+
+    PerfCounterValues read() const;
+
+    // Whether counting is permitted on this machine at all. The result of
+    // the first probe is cached
+    static bool isSupported();
+
+  private:
+    int leader_fd_ = -1;
+    int fds_[kNumPerfCounters];
+
+    DISALLOW_COPY_AND_ASSIGN(PerfCounters);
+};
+
+}  // namespace utils
+}  // namespace kwc
+
+#endif  // KWCTOOLKIT_UTILS_PERF_COUNTERS_H_
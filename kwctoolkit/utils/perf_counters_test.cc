@@ -0,0 +1,67 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#include "kwctoolkit/utils/perf_counters.h"
+
+#include <gtest/gtest.h>
+
+#include "kwctoolkit/utils/benchmark.h"
+
+using namespace kwc::utils;
+
+namespace {
+kwc::uint64 BusyLoop(int count) {
+    kwc::uint64 sum = 0;
+    for (int idx = 0; idx < count; ++idx) {
+        sum += static_cast<kwc::uint64>(idx) * idx;
+        DoNotOptimize(sum);
+    }
+    return sum;
+}
+}  // namespace
+
+TEST(PerfCountersTest, AddsUpAvailableCounters) {
+    PerfCounterValues values;
+    EXPECT_TRUE(values.empty());
+
+    PerfCounterValues cycles;
+    cycles.available[static_cast<int>(PerfCounter::Cycles)] = true;
+    cycles.counts[static_cast<int>(PerfCounter::Cycles)] = 100.0;
+    values += cycles;
+    values += cycles;
+
+    EXPECT_FALSE(values.empty());
+    EXPECT_TRUE(values.has(PerfCounter::Cycles));
+    EXPECT_FALSE(values.has(PerfCounter::Instructions));
+    EXPECT_DOUBLE_EQ(values.get(PerfCounter::Cycles), 200.0);
+}
+
+TEST(PerfCountersTest, CountsOnlyWhileStarted) {
+    PerfCounters counters;
+    EXPECT_EQ(counters.isValid(), PerfCounters::isSupported());
+
+    // Without permission this merely checks that nothing breaks
+    counters.start();
+    BusyLoop(100000);
+    counters.stop();
+    const PerfCounterValues first = counters.read();
+    EXPECT_EQ(first.empty(), !counters.isValid());
+
+    BusyLoop(100000);
+    const PerfCounterValues stopped = counters.read();
+    for (int idx = 0; idx < kNumPerfCounters; ++idx) {
+        EXPECT_EQ(stopped.available[idx], first.available[idx]);
+        EXPECT_DOUBLE_EQ(stopped.counts[idx], first.counts[idx]);
+    }
+
+    if (first.has(PerfCounter::Instructions)) {
+        EXPECT_GT(first.get(PerfCounter::Instructions), 100000.0);
+    }
+
+    counters.reset();
+    const PerfCounterValues reset = counters.read();
+    for (int idx = 0; idx < kNumPerfCounters; ++idx) {
+        EXPECT_DOUBLE_EQ(reset.counts[idx], 0.0);
+    }
+}
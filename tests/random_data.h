@@ -0,0 +1,77 @@
+// Copyright (c) 2021, Kai Wolf - SW Consulting. All rights reserved.
+// For the licensing terms see LICENSE file in the root directory. For the
+// list of contributors see the AUTHORS file in the same directory.
+
+#ifndef TESTS_RANDOM_DATA_H_
+#define TESTS_RANDOM_DATA_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "kwctoolkit/base/integral_types.h"
+
+namespace kwc {
+namespace test {
+
+// Pseudo-random numbers for test data and benchmark inputs. A linear
+// congruential generator is used instead of <random>, whose distributions
+// differ between standard libraries, so that a seed gives the same data on
+// every platform
+class RandomGenerator {
+  public:
+    explicit RandomGenerator(uint32 seed) : state_(seed) {}
+
+    uint32 next() {
+        state_ = state_ * 1664525 + 1013904223;
+        return state_;
+    }
+
+    // Number in [0, |bound|), taken from the upper bits as the lower ones
+    // repeat with short periods
+    uint32 uniform(uint32 bound) { return (next() >> 8) % bound; }
+
+  private:
+    uint32 state_;
+};
+
+// |size| pseudo-random bytes, as a std::string or a std::vector<uint8>
+template <typename Container = std::string>
+Container RandomBytes(std::size_t size, uint32 seed) {
+    RandomGenerator random(seed);
+    Container bytes(size, 0);
+    for (auto& byte : bytes) {
+        byte = static_cast<typename Container::value_type>(random.next() >> 24);
+    }
+    return bytes;
+}
+
+// Pseudo-random string of |length| of the first |alphabet_size| lower case
+// letters
+inline std::string RandomWord(std::size_t length, uint32 alphabet_size,
+                              RandomGenerator* random) {
+    std::string word(length, 'a');
+    for (auto& ch : word) {
+        ch = static_cast<char>('a' + random->uniform(alphabet_size));
+    }
+    return word;
+}
+
+// |count| words as by RandomWord() of |min_length| to |max_length| letters
+inline std::vector<std::string> RandomWords(std::size_t count, std::size_t min_length,
+                                            std::size_t max_length, uint32 alphabet_size,
+                                            uint32 seed) {
+    RandomGenerator random(seed);
+    std::vector<std::string> words(count);
+    for (auto& word : words) {
+        const auto length =
+            min_length + random.uniform(static_cast<uint32>(max_length - min_length + 1));
+        word = RandomWord(length, alphabet_size, &random);
+    }
+    return words;
+}
+
+}  // namespace test
+}  // namespace kwc
+
+#endif  // TESTS_RANDOM_DATA_H_